@@ -8,7 +8,9 @@
 #ifndef INCLUDED_DTL_FEC_H
 #define INCLUDED_DTL_FEC_H
 
+#include <cstring>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace gr {
@@ -18,21 +20,95 @@ class fec_enc {
 public:
     typedef std::shared_ptr<fec_enc> sptr;
     virtual void encode(const unsigned char* in_data, int len, unsigned char* out_data) = 0;
+    /*!
+     * encode() on packed bits: k data bits in, n codeword bits out, bit i in
+     * byte i / 8 at position i % 8. The default wraps encode().
+     */
+    virtual void encode_packed(const unsigned char* in_data, unsigned char* out_data)
+    {
+        int k = get_k();
+        int n = get_n();
+        std::vector<unsigned char> bits(k + n);
+        for (int i = 0; i < k; ++i) {
+            bits[i] = (in_data[i / 8] >> (i % 8)) & 1;
+        }
+        encode(&bits[0], k, &bits[k]);
+        memset(out_data, 0, (n + 7) / 8);
+        for (int i = 0; i < n; ++i) {
+            out_data[i / 8] |= bits[k + i] << (i % 8);
+        }
+    }
     virtual int get_k() = 0;
     virtual int get_n() = 0;
 };
 
+/*
+ * Input LLR of the shortened bits of a codeword, known zeros. Exact value, so
+ * decoders can tell them from the channel LLRs.
+ */
+const float SHORTENED_LLR = -15;
+
 class fec_dec {
 public:
     typedef std::shared_ptr<fec_dec> sptr;
     virtual int decode(const float* in_data, int *nit, unsigned char* out_data) = 0;
+    /*!
+     * Decode ncws consecutive codewords (ncws * n LLRs) to ncws * k bits.
+     * nit receives the number of iterations of each codeword.
+     */
+    virtual int decode_batch(const float* llrs, int ncws, int* nit, unsigned char* out_data)
+    {
+        int n = get_n();
+        int k = get_k();
+        for (int i = 0; i < ncws; ++i) {
+            decode(&llrs[i * n], &nit[i], &out_data[i * k]);
+        }
+        return ncws * k;
+    }
+    /*!
+     * decode_batch() with the k data bits of each codeword packed LSB first in
+     * (k + 7) / 8 bytes. The default packs the output of decode_batch().
+     */
+    virtual int
+    decode_batch_packed(const float* llrs, int ncws, int* nit, unsigned char* out_data)
+    {
+        int k = get_k();
+        int kbytes = (k + 7) / 8;
+        std::vector<unsigned char> bits(ncws * k);
+        decode_batch(llrs, ncws, nit, &bits[0]);
+        memset(out_data, 0, ncws * kbytes);
+        for (int i = 0; i < ncws; ++i) {
+            for (int j = 0; j < k; ++j) {
+                out_data[i * kbytes + j / 8] |= bits[i * k + j] << (j % 8);
+            }
+        }
+        return ncws * k;
+    }
+    /*!
+     * Independent copy that can decode concurrently with this instance,
+     * nullptr if not supported.
+     */
+    virtual sptr clone() { return nullptr; }
     virtual int get_k() = 0;
     virtual int get_n() = 0;
 };
 
+enum class ldpc_decoder_type_t {
+    BP = 0,       // gr::fec sum-product (awgn_bp)
+    MINSUM,       // layered normalized min-sum, float LLRs
+    MINSUM_INT16, // layered offset min-sum, 16 bit quantized LLRs
+    MINSUM_INT8,  // layered offset min-sum, 8 bit quantized LLRs
+};
+
+// Default bound of the transport blocks decoding at once in a worker pool
+const int DEFAULT_MAX_TB_IN_FLIGHT = 8;
+
 std::vector<fec_enc::sptr> make_ldpc_encoders(const std::vector<std::string>& alist_fnames);
 
-std::vector<fec_dec::sptr> make_ldpc_decoders(const std::vector<std::string>& alist_fnames);
+std::vector<fec_dec::sptr>
+make_ldpc_decoders(const std::vector<std::string>& alist_fnames,
+                   ldpc_decoder_type_t type = ldpc_decoder_type_t::BP,
+                   int max_it = 15);
 
 
 } // namespace dtl
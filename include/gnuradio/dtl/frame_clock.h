@@ -0,0 +1,96 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_FRAME_CLOCK_H
+#define INCLUDED_DTL_FRAME_CLOCK_H
+
+#include <gnuradio/dtl/api.h>
+#include <pmt/pmt.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * \brief Timing of the frames of a framer.
+ * \ingroup dtl
+ *
+ * In virtual time, the default, wait() never sleeps: the frames are produced as
+ * fast as the output buffers allow, their time only advances with
+ * frame_index(), and the rate is left to the sink hardware clock, a single
+ * throttle on the samples, or nothing in a simulation.
+ *
+ * In real time, frame n is due frame_duration() * n after start(), and wait()
+ * sleeps in the work call of the framer until the frame at frame_index() is
+ * due, then returns how many frames are due by then, so a framer late by
+ * several frames catches up in one work call. For a framer used on its own.
+ *
+ * With time tags enabled, the framers tag every frame with its index and with
+ * its tx_time, time_origin + frame_duration() * n, in the (full seconds,
+ * fractional seconds) format of the UHD sink.
+ *
+ * A clock is advanced by one framer, other threads may read it.
+ */
+class DTL_API frame_clock
+{
+public:
+    typedef std::shared_ptr<frame_clock> sptr;
+
+    static sptr make(double frame_rate, bool virtual_time = true);
+
+    frame_clock(double frame_rate, bool virtual_time);
+
+    // Frame 0 is due now
+    void start();
+
+    /*!
+     * Number of frames, up to max_frames, due from frame_index(), after sleeping
+     * until the first one is due in real time. max_frames in virtual time.
+     */
+    int wait(int max_frames);
+
+    // n frames were produced
+    void advance(int n) { d_frame_index.fetch_add(n, std::memory_order_relaxed); }
+
+    // Index of the next frame
+    uint64_t frame_index() const { return d_frame_index.load(std::memory_order_relaxed); }
+
+    double frame_duration() const { return d_frame_duration.count(); }
+
+    bool virtual_time() const { return d_virtual_time; }
+
+    /*!
+     * Tags the frames with frame_index_key() and tx_time_key(), the tx_time of
+     * frame 0 being time_origin [s]. Set before the flowgraph starts.
+     */
+    void set_time_tags(bool enable, double time_origin = 0);
+
+    bool time_tags() const { return d_time_tags; }
+
+    // Time of frame index since frame 0 [s]
+    double frame_time(uint64_t index) const { return index * d_frame_duration.count(); }
+
+    // tx_time tag value of frame index
+    pmt::pmt_t tx_time(uint64_t index) const;
+
+private:
+    std::chrono::duration<double> d_frame_duration;
+    bool d_virtual_time;
+    bool d_time_tags;
+    uint64_t d_origin_secs;
+    double d_origin_frac;
+    std::chrono::time_point<std::chrono::steady_clock> d_start_time;
+    std::atomic<uint64_t> d_frame_index;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_FRAME_CLOCK_H */
@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_MCS_CHANNEL_H
+#define INCLUDED_DTL_MCS_CHANNEL_H
+
+#include <gnuradio/dtl/api.h>
+#include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace gr {
+namespace dtl {
+
+struct mcs_t {
+    constellation_type_t constellation;
+    // Negative if the publisher has no FEC decision
+    int fec_idx;
+    float snr;
+    // steady_clock time of the publication [ns]
+    int64_t timestamp;
+};
+
+/*!
+ * \brief Latest MCS decision shared between blocks without message ports.
+ * \ingroup dtl
+ *
+ * A seqlock over {constellation, fec_idx, snr, timestamp}: a single writer
+ * publishes without waiting, readers poll from their work function and retry
+ * only if they raced with a publication. No PMT is built and the message queue
+ * is bypassed, so a decision is seen by the next work call of the readers.
+ */
+class DTL_API mcs_channel
+{
+public:
+    typedef std::shared_ptr<mcs_channel> sptr;
+
+    static sptr make();
+
+    mcs_channel();
+
+    // Only one thread may publish
+    void publish(constellation_type_t constellation, int fec_idx, float snr = 0);
+
+    /*!
+     * Reads the latest MCS if it was published after version seq, and updates
+     * seq. Returns false, leaving mcs unchanged, otherwise.
+     */
+    bool read(mcs_t& mcs, uint64_t& seq) const;
+
+    // Number of publications so far
+    uint64_t version() const;
+
+private:
+    // Odd while a publication is in progress
+    std::atomic<uint64_t> d_seq;
+    std::atomic<int> d_constellation;
+    std::atomic<int> d_fec_idx;
+    std::atomic<float> d_snr;
+    std::atomic<int64_t> d_timestamp;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_MCS_CHANNEL_H */
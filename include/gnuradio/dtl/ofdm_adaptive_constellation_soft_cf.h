@@ -16,16 +16,27 @@ namespace gr {
 namespace dtl {
 
 /*!
- * \brief <+description of block+>
+ * \brief Soft demapping of the serialized payload symbols to LLRs
  * \ingroup dtl
  *
+ * \details
+ * The LLRs are scaled by the noise variance of the noise_tag_key tag. If the
+ * carrier allocation of the serializer is given (fft_len, occupied_carriers and
+ * symbols_skipped as passed to ofdm_serializer_vcc), each symbol is scaled by
+ * the SNR of its carrier from the carrier_snr_tag_key tag of the equalizer
+ * instead.
  */
 class DTL_API ofdm_adaptive_constellation_soft_cf : virtual public gr::block
 {
 public:
     typedef std::shared_ptr<ofdm_adaptive_constellation_soft_cf> sptr;
 
-    static sptr make(const std::vector<constellation_type_t>& constellations, const std::string& len_key);
+    static sptr make(const std::vector<constellation_type_t>& constellations,
+                     const std::string& len_key,
+                     int fft_len = 0,
+                     const std::vector<std::vector<int>>& occupied_carriers =
+                         std::vector<std::vector<int>>(),
+                     int symbols_skipped = 0);
 };
 
 } // namespace dtl
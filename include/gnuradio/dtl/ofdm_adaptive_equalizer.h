@@ -11,16 +11,19 @@
 #define INCLUDED_DTL_OFDM_EQUALIZER_ADAPTIVE_H
 
 #include <gnuradio/digital/constellation.h>
-#include <gnuradio/digital/mpsk_snr_est.h>
 #include <gnuradio/digital/ofdm_equalizer_base.h>
 #include <gnuradio/dtl/api.h>
 #include <gnuradio/dtl/ofdm_adaptive_frame_snr.h>
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <map>
+#include <memory>
 
 
 namespace gr {
 namespace dtl {
 
+class ofdm_equalizer_kernel;
+
 /*!
  * \brief Enhance the equalizer interface for Adaptive OFDM transmission.
  *
@@ -48,8 +51,18 @@ public:
 
     double get_snr();
 
+    // Effective SNR [dB] of the last frame for a constellation
+    double get_effective_snr(constellation_type_t constellation);
+
     double get_noise();
 
+    /*!
+     * Effective SNR |H_k|^2 / sigma^2 of each carrier k for the current channel
+     * state, 0 for unused carriers. sigma^2 is recovered from the noise measured
+     * on the equalized pilots, which is the mean of sigma^2 / |H_k|^2.
+     */
+    void get_carrier_snr(std::vector<float>& snr);
+
     void equalize(gr_complex* frame,
                   int n_sym,
                   const std::vector<gr_complex>& initial_taps = std::vector<gr_complex>(),
@@ -71,8 +84,19 @@ protected:
 
 private:
     float d_alpha;
+    // Equalized pilots of a symbol for the SNR estimator
     std::vector<gr_complex> d_pilots;
     std::shared_ptr<ofdm_adaptive_frame_snr_base> d_snr_estimator;
+
+    // Data and pilot carriers of each pilot carrier set
+    std::vector<std::vector<int>> d_data_carriers;
+    std::vector<std::vector<int>> d_pilot_carrier_idx;
+    // Reciprocals of the pilot symbols
+    std::vector<std::vector<gr_complex>> d_pilot_inv;
+    std::map<gr::digital::constellation_sptr, std::shared_ptr<const ofdm_equalizer_kernel>>
+        d_kernels;
+    // Split real/imaginary buffers and gains of the data carriers of a symbol
+    std::vector<float> d_carrier_buf;
 };
 
 
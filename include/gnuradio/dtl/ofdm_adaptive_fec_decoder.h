@@ -10,6 +10,7 @@
 
 #include <gnuradio/dtl/api.h>
 #include <gnuradio/dtl/fec.h>
+#include <gnuradio/dtl/ofdm_adaptive_feedback_decision.h>
 #include <gnuradio/block.h>
 
 namespace gr {
@@ -19,12 +20,38 @@ namespace dtl {
  * \brief <+description of block+>
  * \ingroup dtl
  *
+ * Outputs the user bytes of every TB that passes its CRC, packed as they were
+ * given to ofdm_adaptive_fec_frame_bvb, with a len_key tag of their length in
+ * bytes.
+ *
+ * With nthreads > 0 transport blocks are decoded by a pool of nthreads worker
+ * threads, at most max_tb_in_flight TBs are decoding at any time. Decoded TBs
+ * are output in the order they were received.
+ *
+ * Otherwise the codewords of a TB are decoded together once its last frame is
+ * in, in batches across the SIMD lanes of the decoder. With incremental set
+ * they are decoded as soon as their LLRs are in instead, so a TB spanning
+ * several frames is not decoded in a burst at its last frame, at the cost of
+ * the batches.
+ *
+ * The CRC outcome of every TB is reported, with its MCS and the estimated SNR
+ * of its first frame, to the link adaptation if one is set.
  */
 class DTL_API ofdm_adaptive_fec_decoder : virtual public gr::block
 {
 public:
     typedef std::shared_ptr<ofdm_adaptive_fec_decoder> sptr;
-    static sptr make(const std::vector<fec_dec::sptr>& decoders, int frame_capacity, int max_bps, const std::string& len_key);
+    static sptr make(const std::vector<fec_dec::sptr>& decoders,
+                     int frame_capacity,
+                     int max_bps,
+                     const std::string& len_key,
+                     int nthreads = 0,
+                     int max_tb_in_flight = DEFAULT_MAX_TB_IN_FLIGHT,
+                     bool incremental = false);
+
+    // Set before the flowgraph starts
+    virtual void
+    set_link_adaptation(ofdm_adaptive_feedback_decision_base::sptr link_adaptation) = 0;
 };
 
 } // namespace dtl
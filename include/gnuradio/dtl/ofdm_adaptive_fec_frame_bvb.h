@@ -10,6 +10,8 @@
 
 #include <gnuradio/dtl/api.h>
 #include <gnuradio/dtl/fec.h>
+#include <gnuradio/dtl/frame_clock.h>
+#include <gnuradio/dtl/mcs_channel.h>
 #include <gnuradio/tagged_stream_block.h>
 #include <vector>
 
@@ -34,6 +36,27 @@ public:
                      const std::string& len_key);
 
     virtual void process_feedback(pmt::pmt_t feedback) = 0;
+
+    /*!
+     * Channels read at the start of every work call, as the feedback and header
+     * message ports. Set before the flowgraph starts.
+     */
+    virtual void set_feedback_channel(mcs_channel::sptr channel) = 0;
+    virtual void set_header_channel(mcs_channel::sptr channel) = 0;
+
+    /*!
+     * Timing of the frames, shared with the rest of the transmitter. By default
+     * the block has its own virtual time clock at frame_rate: the frames are
+     * paced by the sink. Set before the flowgraph starts.
+     */
+    virtual void set_frame_clock(frame_clock::sptr clock) = 0;
+
+    /*!
+     * Encodes up to nframes frames ahead of their slots, with the MCS of the
+     * time they are encoded, so a burst of input is ready when its slots start.
+     * 0, the default, encodes a frame when its slot starts.
+     */
+    virtual void set_burst_frames(int nframes) = 0;
 };
 
 } // namespace dtl
@@ -11,6 +11,10 @@
 
 #include <gnuradio/dtl/api.h>
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 
 namespace gr {
@@ -19,6 +23,8 @@ namespace dtl {
 
 typedef std::pair<constellation_type_t, unsigned char> ofdm_adaptive_feedback_t;
 typedef int mcs_id_t;
+// Effective SNR [dB] of the frame for a constellation
+typedef std::function<double(constellation_type_t)> effective_snr_t;
 
 class DTL_API ofdm_adaptive_feedback_decision_base
     : public std::enable_shared_from_this<ofdm_adaptive_feedback_decision_base>
@@ -28,6 +34,19 @@ public:
 
     virtual ofdm_adaptive_feedback_t get_feedback(double estimated_snr) = 0;
 
+    /*!
+     * Decision with the effective SNR of each constellation, evaluated for the
+     * MCSs considered. By default, the decision for the SNR of the UNKNOWN
+     * constellation, which is the plain frame SNR.
+     */
+    virtual ofdm_adaptive_feedback_t get_feedback(const effective_snr_t& effective_snr);
+
+    /*!
+     * CRC outcome of a transport block received with mcs at the estimated SNR
+     * snr. Called from the FEC decoder thread, ignored by default.
+     */
+    virtual void report_tb(ofdm_adaptive_feedback_t mcs, double snr, bool crc_ok);
+
     virtual ~ofdm_adaptive_feedback_decision_base();
 };
 
@@ -61,7 +80,11 @@ public:
 
     virtual ofdm_adaptive_feedback_t get_feedback(double estimated_snr) override;
 
+    ofdm_adaptive_feedback_t get_feedback(const effective_snr_t& effective_snr) override;
+
 private:
+    // Decision with the SNRs of the current and of the next better MCS
+    ofdm_adaptive_feedback_t decide(double current_snr, double better_snr);
     void update_decision(mcs_id_t mcs_id);
 
     std::vector<std::pair<double, ofdm_adaptive_feedback_t>> d_feedback_lut;
@@ -72,6 +95,80 @@ private:
     mcs_id_t d_new_decision;
 };
 
+
+/*!
+ * \brief Link adaptation from per MCS BLER curves
+ *
+ * \ingroup DTL
+ *
+ * \details
+ * Every MCS of lut has a BLER curve over an SNR grid. It starts as a
+ * logistic with BLER target_bler at the lut threshold and is updated from the
+ * CRC outcomes given to report_tb, keeping it non increasing in SNR. The MCS
+ * that maximizes efficiency * (1 - BLER) is precomputed for every SNR bin, so
+ * get_feedback is a table lookup and jumps to any MCS in one decision. A report
+ * only recomputes the bins whose BLER it changed. One decision in 50 probes the
+ * MCS above, so a curve raised during a fade learns when the channel recovers.
+ *
+ * The outer loop offset (OLLA) added to the estimated SNR steps down by
+ * olla_step on every failed TB and up by olla_step * target / (1 - target) on
+ * every good one, so that the BLER converges to target_bler.
+ *
+ * With effective SNRs, the goodput of each MCS is evaluated at the SNR of its
+ * constellation instead of the table lookup.
+ *
+ * efficiency is the information bits per symbol of each lut entry. If empty,
+ * the bits per symbol of the constellations are used.
+ */
+class DTL_API ofdm_adaptive_link_adaptation : public ofdm_adaptive_feedback_decision_base
+{
+public:
+    typedef std::shared_ptr<ofdm_adaptive_link_adaptation> sptr;
+
+    static sptr make(const std::vector<std::pair<double, ofdm_adaptive_feedback_t>>& lut,
+                     const std::vector<double>& efficiency = {},
+                     double target_bler = 0.1,
+                     double olla_step = 0.5,
+                     mcs_id_t initial_mcs = 0);
+
+    ofdm_adaptive_link_adaptation(
+        const std::vector<std::pair<double, ofdm_adaptive_feedback_t>>& lut,
+        const std::vector<double>& efficiency,
+        double target_bler,
+        double olla_step,
+        mcs_id_t initial_mcs);
+
+    ~ofdm_adaptive_link_adaptation() override;
+
+    ofdm_adaptive_feedback_t get_feedback(double estimated_snr) override;
+
+    ofdm_adaptive_feedback_t get_feedback(const effective_snr_t& effective_snr) override;
+
+    void report_tb(ofdm_adaptive_feedback_t mcs, double snr, bool crc_ok) override;
+
+    double get_bler(mcs_id_t mcs_id, double snr) const;
+
+    double get_olla_offset() const;
+
+private:
+    int snr_bin(double snr) const;
+    void update_decision_table(int begin, int end);
+    mcs_id_t explore(mcs_id_t mcs_id);
+
+    std::vector<std::pair<double, ofdm_adaptive_feedback_t>> d_feedback_lut;
+    std::vector<double> d_efficiency;
+    double d_olla_step_down;
+    double d_olla_step_up;
+    double d_olla_offset;
+    // BLER of MCS m in SNR bin b at d_bler[m * n_bins + b]
+    std::vector<float> d_bler;
+    // Best MCS of every SNR bin
+    std::vector<mcs_id_t> d_decision_table;
+    mcs_id_t d_last_decision;
+    int d_decisions;
+    mutable std::mutex d_mutex;
+};
+
 } /* namespace dtl */
 } /* namespace gr */
 
@@ -10,6 +10,8 @@
 
 #include <gnuradio/block.h>
 #include <gnuradio/dtl/api.h>
+#include <gnuradio/dtl/frame_clock.h>
+#include <gnuradio/dtl/mcs_channel.h>
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
 
 namespace gr {
@@ -34,6 +36,27 @@ public:
                      int max_empty_frames = -1);
 
     virtual void set_constellation(constellation_type_t constellation) = 0;
+
+    /*!
+     * Channels read at the start of every work call, as the feedback and header
+     * message ports. Set before the flowgraph starts.
+     */
+    virtual void set_feedback_channel(mcs_channel::sptr channel) = 0;
+    virtual void set_header_channel(mcs_channel::sptr channel) = 0;
+
+    /*!
+     * Timing of the frames, shared with the rest of the transmitter. By default
+     * the block has its own virtual time clock at frame_rate: the frames are
+     * paced by the sink. Set before the flowgraph starts.
+     */
+    virtual void set_frame_clock(frame_clock::sptr clock) = 0;
+
+    /*!
+     * Pads the frames from a fixed pseudo-random table instead of the random
+     * generator, from the start of the table at every flowgraph start, so the
+     * frames are reproducible. For testing.
+     */
+    virtual void set_padding_table(bool table) = 0;
 };
 
 } // namespace dtl
@@ -0,0 +1,73 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_BC_H
+#define INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_BC_H
+
+#include <gnuradio/block.h>
+#include <gnuradio/dtl/api.h>
+#include <gnuradio/dtl/frame_clock.h>
+#include <gnuradio/dtl/mcs_channel.h>
+#include <gnuradio/dtl/ofdm_adaptive_utils.h>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * \brief Frames the input PDUs and maps them to the constellation symbols.
+ * \ingroup dtl
+ *
+ * Fused ofdm_adaptive_frame_bb, ofdm_adaptive_frame_to_stream_vbb and
+ * ofdm_adaptive_chunks_to_symbols_bc for the path without FEC: the payload
+ * bytes of a frame, its CRC and the random padding are assembled in one buffer
+ * and mapped from it, packed, to the symbols of the frame constellation.
+ *
+ * Output 0 is the tagged stream of payload symbols, with the tags of
+ * ofdm_adaptive_frame_bb. The optional output 1 has the same length and tags
+ * with zero bytes, for the header generator.
+ */
+class DTL_API ofdm_adaptive_frame_bc : virtual public gr::block
+{
+public:
+    typedef std::shared_ptr<ofdm_adaptive_frame_bc> sptr;
+
+    static sptr make(const std::string& len_tag_key,
+                     const std::vector<constellation_type_t>& constellations,
+                     size_t frame_len,
+                     double frame_rate,
+                     size_t n_payload_carriers,
+                     std::string frames_fname = "",
+                     int max_empty_frames = -1);
+
+    virtual void set_constellation(constellation_type_t constellation) = 0;
+
+    /*!
+     * Channels read at the start of every work call, as the feedback and header
+     * message ports. Set before the flowgraph starts.
+     */
+    virtual void set_feedback_channel(mcs_channel::sptr channel) = 0;
+    virtual void set_header_channel(mcs_channel::sptr channel) = 0;
+
+    /*!
+     * Timing of the frames, shared with the rest of the transmitter. By default
+     * the block has its own virtual time clock at frame_rate: the frames are
+     * paced by the sink. Set before the flowgraph starts.
+     */
+    virtual void set_frame_clock(frame_clock::sptr clock) = 0;
+
+    /*!
+     * Pads the frames from a fixed pseudo-random table instead of the random
+     * generator, from the start of the table at every flowgraph start, so the
+     * frames are reproducible. For testing.
+     */
+    virtual void set_padding_table(bool table) = 0;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_BC_H */
@@ -11,6 +11,7 @@
 #include <gnuradio/dtl/api.h>
 #include <gnuradio/dtl/ofdm_adaptive_equalizer.h>
 #include <gnuradio/dtl/ofdm_adaptive_feedback_decision.h>
+#include <gnuradio/dtl/mcs_channel.h>
 #include <gnuradio/tagged_stream_block.h>
 
 namespace gr {
@@ -20,6 +21,10 @@ namespace dtl {
  * \brief Modifies gr::digital::ofdm_frame_equalizer to pass the tags to equalize
  * \ingroup dtl
  *
+ * The feedback decision of every frame is published to feedback_port as a
+ * dict, to feedback_pdu as a PDU of {constellation, fec} bytes for the
+ * feedback formatter, and to the feedback channel if one is set. Messages are
+ * only built if the port is connected.
  */
 class DTL_API ofdm_adaptive_frame_equalizer_vcvc
     : virtual public ::gr::tagged_stream_block
@@ -34,6 +39,9 @@ public:
                      const std::string& frame_no_key = "frame_no_key",
                      bool propagate_channel_state = false,
                      bool propagate_feedback_tags = false);
+
+    // Set before the flowgraph starts
+    virtual void set_feedback_channel(mcs_channel::sptr channel) = 0;
 };
 
 } // namespace dtl
@@ -8,7 +8,13 @@
 #ifndef INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_SNR_ESTIMATOR_H
 #define INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_SNR_ESTIMATOR_H
 
+#include <gnuradio/dtl/api.h>
+#include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <gnuradio/dtl/snr_est.h>
 #include <gnuradio/gr_complex.h>
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace gr {
 namespace dtl {
@@ -21,28 +27,113 @@ public:
     virtual void reset() = 0;
     virtual double snr() = 0;
     virtual double noise() = 0;
+
+    /*!
+     * Data carriers of an equalized symbol: channel gains |h|^2 before the
+     * decision directed update, equalized samples and their decisions, as split
+     * real and imaginary arrays. Ignored by the estimators working on the pilots.
+     */
+    virtual void update_carriers(int n,
+                                 const float* gain,
+                                 const float* eq_re,
+                                 const float* eq_im,
+                                 const float* est_re,
+                                 const float* est_im)
+    {
+    }
+
+    // Effective SNR [dB] of the frame for a constellation, snr() by default
+    virtual double effective_snr(constellation_type_t constellation) { return snr(); }
 };
 
 
+/*!
+ * Frame SNR from the pilots, with an estimator T of snr_est.h held by value:
+ * reset() clears it in place and update() takes the pilots of a symbol at once.
+ */
 template <class T>
-class ofdm_adaptive_frame_snr : public ofdm_adaptive_frame_snr_base
+class ofdm_adaptive_frame_snr final : public ofdm_adaptive_frame_snr_base
 {
 public:
-    ofdm_adaptive_frame_snr(double alpha) {
-        d_snr_estimator = std::make_shared<T>(alpha);
-    }
+    ofdm_adaptive_frame_snr(double alpha) : d_snr_estimator(alpha) {}
 
-    virtual void reset() override { d_snr_estimator = std::make_shared<T>(d_snr_estimator->alpha()); }
-    virtual int update(int noutput_items, const gr_complex* input) override
+    void reset() override { d_snr_estimator.reset(); }
+    int update(int noutput_items, const gr_complex* input) override
     {
-        return d_snr_estimator->update(noutput_items, input);
+        return d_snr_estimator.update(noutput_items, input);
     }
 
-    virtual double snr() override { return d_snr_estimator->snr(); }
-    virtual double noise() override { return d_snr_estimator->noise(); }
+    double snr() override { return d_snr_estimator.snr(); }
+    double noise() override { return d_snr_estimator.noise(); }
 
 protected:
-    std::shared_ptr<T> d_snr_estimator;
+    T d_snr_estimator;
+};
+
+typedef ofdm_adaptive_frame_snr<snr_est_simple> ofdm_adaptive_frame_snr_simple;
+typedef ofdm_adaptive_frame_snr<snr_est_m2m4> ofdm_adaptive_frame_snr_m2m4;
+typedef ofdm_adaptive_frame_snr<snr_est_svr> ofdm_adaptive_frame_snr_svr;
+
+
+/*!
+ * \brief Effective SNR of a frame by exponential effective SNR mapping (EESM)
+ *
+ * The SNR of every data resource element is |h|^2 / sigma^2, where sigma^2 is
+ * the decision directed error of the frame before equalization. For a
+ * constellation with calibration factor beta, the effective SNR is the AWGN SNR
+ * with the same decoding performance:
+ *
+ *   snr_eff = -beta * ln(mean(exp(-snr_i / beta)))
+ *
+ * exp(-snr / beta) is tabulated on a log SNR grid indexed by the float bits of
+ * the SNR, so a frame costs a table lookup per resource element and constellation.
+ * snr() is the mean SNR of the resource elements, noise() the decision directed
+ * error of the equalized samples. The pilots are not used.
+ *
+ * Constellations missing in beta get typical values: BPSK 1, QPSK 1.6, 8PSK
+ * 3.2, 16QAM 6.5.
+ */
+class DTL_API ofdm_adaptive_frame_snr_eesm : public ofdm_adaptive_frame_snr_base
+{
+public:
+    typedef std::shared_ptr<ofdm_adaptive_frame_snr_eesm> sptr;
+
+    static sptr make(const std::map<constellation_type_t, double>& beta = {});
+
+    explicit ofdm_adaptive_frame_snr_eesm(
+        const std::map<constellation_type_t, double>& beta = {});
+
+    int update(int noutput_items, const gr_complex* input) override;
+    void update_carriers(int n,
+                         const float* gain,
+                         const float* eq_re,
+                         const float* eq_im,
+                         const float* est_re,
+                         const float* est_im) override;
+    void reset() override;
+    double snr() override;
+    double noise() override;
+    double effective_snr(constellation_type_t constellation) override;
+
+private:
+    struct eesm_table_t {
+        double beta;
+        // exp(-snr / beta) on the SNR grid
+        std::vector<double> exp_snr;
+        double effective_snr;
+    };
+
+    void estimate();
+
+    std::map<constellation_type_t, eesm_table_t> d_tables;
+    // |h|^2 and SNR grid index of the resource elements of the frame
+    std::vector<float> d_gain;
+    std::vector<int> d_grid_idx;
+    // Sums of |h|^2 |eq - est|^2 and |eq - est|^2
+    double d_error;
+    double d_eq_error;
+    double d_snr;
+    bool d_estimated;
 };
 
 } // namespace dtl
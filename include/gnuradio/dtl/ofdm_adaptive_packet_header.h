@@ -10,8 +10,10 @@
 
 #include <gnuradio/digital/packet_header_ofdm.h>
 #include <gnuradio/dtl/api.h>
+#include <gnuradio/dtl/mcs_channel.h>
 #include <gnuradio/dtl/ofdm_adaptive_packet_header.h>
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <gnuradio/testbed/crc_engine.h>
 #include <vector>
 
 
@@ -56,6 +58,13 @@ public:
 
     bool header_parser(const unsigned char* in, std::vector<tag_t>& tags) override;
 
+    /*!
+     * Headers parsed with a valid CRC publish the feedback they carry to the
+     * channel, as the header_data message of the header parser. Set before the
+     * flowgraph starts.
+     */
+    void set_header_channel(mcs_channel::sptr channel);
+
 private:
     int
     add_header_field(unsigned char* buf, int offset, unsigned long long val, int n_bits);
@@ -66,14 +75,15 @@ private:
                          int first_pos,
                          std::vector<tag_t>& tags);
 
-    void pack_crc(const unsigned char* buf_bits, std::vector<unsigned char>& crc_buf);
+    unsigned header_crc(const unsigned char* header_bits) const;
 
     pmt::pmt_t d_constellation_tag_key;
     constellation_type_t d_constellation;
     int d_payload_syms;
     bool d_has_fec;
-    gr::digital::crc d_crc;
+    crc_engine d_crc;
     int d_crc_len;
+    mcs_channel::sptr d_header_channel;
 };
 
 } // namespace dtl
@@ -54,6 +54,8 @@ pmt::pmt_t estimated_snr_tag_key();
 
 pmt::pmt_t noise_tag_key();
 
+pmt::pmt_t carrier_snr_tag_key();
+
 pmt::pmt_t feedback_constellation_key();
 
 pmt::pmt_t payload_length_key();
@@ -72,6 +74,10 @@ pmt::pmt_t fec_tb_len_key();
 
 pmt::pmt_t fec_tb_index_key();
 
+pmt::pmt_t frame_index_key();
+
+pmt::pmt_t tx_time_key();
+
 
 } // namespace dtl
 } // namespace gr
@@ -0,0 +1,122 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_SNR_EST_H
+#define INCLUDED_DTL_SNR_EST_H
+
+#include <gnuradio/dtl/api.h>
+#include <gnuradio/gr_complex.h>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * \brief Exponential averages of the moments of M-PSK samples
+ * \ingroup dtl
+ *
+ * Base of the SNR estimators held by value in ofdm_adaptive_frame_snr<T>. As in
+ * gr::digital::mpsk_snr_est, every moment is averaged with
+ * y = alpha * x + (1 - alpha) * y, but a batch of n samples is added at once as
+ * beta^n * y + alpha * sum(beta^(n-1-i) * x_i), accumulated in independent
+ * lanes so the loops vectorize. reset() clears the averages in place.
+ */
+class DTL_API snr_est_base
+{
+public:
+    static const int LANES = 8;
+
+    snr_est_base(double alpha);
+
+    double alpha() const { return d_alpha; }
+
+protected:
+    // Adds the moments(i, x) of samples [0, n) to the averages y[0, M)
+    template <int M, class F>
+    void average(int n, double* y, F moments) const;
+
+    double d_alpha;
+    double d_beta;
+    // beta^LANES, and beta^(LANES-1-l) of lane l
+    float d_beta_lanes;
+    float d_lane_weight[LANES];
+};
+
+/*!
+ * \brief SNR from the mean amplitude and the mean power
+ * \ingroup dtl
+ *
+ * Same estimate as gr::digital::mpsk_snr_est_simple.
+ */
+class DTL_API snr_est_simple : public snr_est_base
+{
+public:
+    snr_est_simple(double alpha);
+
+    void reset();
+    int update(int n, const gr_complex* input);
+    // [dB]
+    double snr() const;
+    double noise() const;
+
+private:
+    // Mean amplitude and power
+    double d_y[2];
+};
+
+/*!
+ * \brief SNR from the second and fourth moments (M2M4)
+ * \ingroup dtl
+ *
+ * S = sqrt(2 * M2^2 - M4) and N = M2 - S, for a constant modulus signal in
+ * complex Gaussian noise.
+ */
+class DTL_API snr_est_m2m4 : public snr_est_base
+{
+public:
+    snr_est_m2m4(double alpha);
+
+    void reset();
+    int update(int n, const gr_complex* input);
+    // [dB]
+    double snr() const;
+    double noise() const;
+
+private:
+    // M2 and M4
+    double d_y[2];
+};
+
+/*!
+ * \brief SNR from the moments of consecutive symbols, signal to variation ratio
+ * \ingroup dtl
+ *
+ * With x = E[|r_i|^2 |r_i-1|^2] / (E[|r_i|^4] - E[|r_i|^2 |r_i-1|^2]), the SNR is
+ * x - 1 + sqrt(x * (x - 1)). The last sample of a batch is paired with the
+ * first one of the next batch, until reset().
+ */
+class DTL_API snr_est_svr : public snr_est_base
+{
+public:
+    snr_est_svr(double alpha);
+
+    void reset();
+    int update(int n, const gr_complex* input);
+    // [dB]
+    double snr() const;
+    double noise() const;
+
+private:
+    // M2, E[|r_i|^2 |r_i-1|^2] and M4
+    double d_y[3];
+    // Power of the last sample, negative after reset
+    float d_last_power;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_SNR_EST_H */
@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_CRC_ENGINE_H
+#define INCLUDED_DTL_CRC_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Table driven CRC of up to 32 bits, bit exact with gr::digital::crc for the same
+ * parameters.
+ *
+ * Bytes go through slicing-by-8 tables, 8 bytes per step. The reflected CRC-32
+ * (poly 0x04C11DB7, reflected input and result) folds 16 byte blocks with carry
+ * less multiplies instead, PCLMULQDQ on x86 when the CPU has it and PMULL on
+ * ARMv8 builds with the crypto extension.
+ *
+ * The *_bits() variants take one bit per byte (bit 0 of each byte), in the
+ * order the CRC consumes them: LSB first within a byte if the input is
+ * reflected, MSB first otherwise. They pack 8 bits per table lookup, so bit
+ * streams don't need to be repacked into bytes first.
+ *
+ * start(), update() and finish() compute a CRC over several buffers.
+ */
+class crc_engine
+{
+public:
+    crc_engine(unsigned num_bits,
+               uint32_t poly,
+               uint32_t initial_value,
+               uint32_t final_xor,
+               bool input_reflected,
+               bool result_reflected);
+
+    uint32_t compute(const unsigned char* data, std::size_t len) const
+    {
+        return finish(update(start(), data, len));
+    }
+
+    uint32_t compute_bits(const unsigned char* bits, std::size_t nbits) const
+    {
+        return finish(update_bits(start(), bits, nbits));
+    }
+
+    uint32_t start() const { return d_initial_value; }
+
+    uint32_t update(uint32_t rem, const unsigned char* data, std::size_t len) const;
+
+    uint32_t update_bits(uint32_t rem, const unsigned char* bits, std::size_t nbits) const;
+
+    uint32_t finish(uint32_t rem) const;
+
+    unsigned get_num_bits() const { return d_num_bits; }
+
+    typedef uint32_t (*fold_t)(const unsigned char* data, std::size_t len, uint32_t rem);
+
+private:
+    unsigned d_num_bits;
+    uint32_t d_mask;
+    // Reflected if the input is, otherwise aligned to the register MSB
+    uint32_t d_poly;
+    uint32_t d_initial_value;
+    uint32_t d_final_xor;
+    bool d_input_reflected;
+    bool d_result_reflected;
+    // Slicing-by-8: table k gives the remainder of a byte followed by k zero bytes
+    std::vector<uint32_t> d_tables;
+    // Carry-less multiply folding, nullptr if not available for the CRC
+    fold_t d_fold;
+
+    uint32_t update_reflected(uint32_t rem, const unsigned char* data, std::size_t len) const;
+    uint32_t update_normal(uint32_t rem, const unsigned char* data, std::size_t len) const;
+};
+
+} /* namespace dtl */
+} /* namespace gr */
+
+#endif /* INCLUDED_DTL_CRC_ENGINE_H */
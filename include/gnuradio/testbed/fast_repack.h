@@ -0,0 +1,85 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_FAST_REPACK_H
+#define INCLUDED_DTL_FAST_REPACK_H
+
+#include <cstddef>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Word parallel drop-in replacement of gr::dtl::repack.
+ *
+ * Same interface and results as repack, including the input bit index kept
+ * across calls, but the bits are moved through a 64 bit accumulator instead of
+ * one per iteration. The (bits_in, bits_out) pairs of the modem, 1 <-> 8,
+ * 8 -> 1..4, 1 -> 2..4 and 2..4 -> 8, get kernels specialized at compile time:
+ * unpacked bits are gathered 8 input bytes per multiply, bytes are spread to
+ * 8 bits with shifts, and 1 -> 8 packs 64 bits per step. Other pairs use the
+ * same kernel with runtime widths.
+ *
+ * repack stays the reference implementation for the property tests.
+ */
+class fast_repack
+{
+public:
+    fast_repack(unsigned char bits_in_byte, unsigned char bits_out_byte);
+
+    void set_bits_per_byte(unsigned char bits_in_byte, unsigned char bits_out_byte);
+
+    int repack_lsb_first(unsigned char const* in,
+                         size_t n_in,
+                         unsigned char* out,
+                         bool full_output_symbols = false);
+
+    int repack_msb_first(unsigned char const* in,
+                         size_t n_in,
+                         unsigned char* out,
+                         bool full_output_symbols = false);
+
+    void set_indexes(unsigned char in_index, unsigned char out_index);
+
+    /*!
+     * Repacks the n_bits bits starting at bit in_index of in[0], LSB first, to
+     * ceil(n_bits / bits_out_byte) output symbols, the last one zero padded.
+     * Neither uses nor updates the indexes of set_indexes(). Returns the number
+     * of written symbols.
+     */
+    int repack_range_lsb_first(unsigned char const* in,
+                               int in_index,
+                               size_t n_bits,
+                               unsigned char* out);
+
+    // Moves n_bits bits starting at bit in_index of in[0], returns written bytes
+    typedef size_t (*kernel_t)(unsigned char const* in,
+                               unsigned char* out,
+                               size_t n_bits,
+                               int in_index,
+                               int bits_in,
+                               int bits_out);
+
+private:
+    unsigned char d_out_index;
+    unsigned char d_in_index;
+    unsigned char d_bits_in_byte;
+    unsigned char d_bits_out_byte;
+    kernel_t d_lsb_kernel;
+    kernel_t d_msb_kernel;
+
+    int repack_bits(unsigned char const* in,
+                    size_t n_in,
+                    unsigned char* out,
+                    bool full_output_symbols,
+                    bool msb_first);
+};
+
+} /* namespace dtl */
+} /* namespace gr */
+
+#endif /* INCLUDED_DTL_FAST_REPACK_H */
@@ -38,7 +38,7 @@ unsigned long crc_util::append_crc(unsigned char* buffer, std::size_t len)
     return crc_val;
 }
 
-bool crc_util::verify_crc(unsigned char* buffer, std::size_t len)
+bool crc_util::verify_crc(const unsigned char* buffer, std::size_t len)
 {
     size_t payload_len = len - d_crc_len;
     unsigned long crc_val = d_crc.compute(buffer, payload_len);
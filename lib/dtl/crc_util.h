@@ -8,7 +8,7 @@
 #ifndef INCLUDED_DTL_CRC_UTL_H
 #define INCLUDED_DTL_CRC_UTL_H
 
-#include <gnuradio/digital/crc.h>
+#include <gnuradio/testbed/crc_engine.h>
 
 namespace gr {
 namespace dtl {
@@ -17,7 +17,7 @@ class crc_util
 {
 
 private:
-    gr::digital::crc d_crc;
+    crc_engine d_crc;
     std::size_t d_crc_len;
     unsigned long d_count;
     unsigned long d_failed;
@@ -28,7 +28,7 @@ public:
              unsigned long initial_value,
              unsigned long final_xor);
 
-    bool verify_crc(unsigned char* buffer, std::size_t len);
+    bool verify_crc(const unsigned char* buffer, std::size_t len);
 
     unsigned long append_crc(unsigned char* buffer, std::size_t len);
 
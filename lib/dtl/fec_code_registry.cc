@@ -0,0 +1,90 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "fec_code_registry.h"
+#include <gnuradio/testbed/logger.h>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+INIT_DTL_LOGGER("fec_code_registry");
+
+fec_code_registry& fec_code_registry::instance()
+{
+    static fec_code_registry registry;
+    return registry;
+}
+
+ldpc_code::sptr fec_code_registry::get_ldpc_code(const string& alist_fname)
+{
+    error_code ec;
+    string path = filesystem::weakly_canonical(alist_fname, ec).string();
+    if (ec) {
+        path = alist_fname;
+    }
+    error_code mtime_ec, size_ec;
+    auto mtime = filesystem::last_write_time(path, mtime_ec);
+    auto size = filesystem::file_size(path, size_ec);
+    bool stat_ok = !mtime_ec && !size_ec;
+
+    lock_guard<mutex> lock(d_mutex);
+
+    // Same file, unchanged since it was loaded
+    auto it = d_paths.find(path);
+    if (stat_ok && it != d_paths.end() && it->second.mtime == mtime &&
+        it->second.size == size) {
+        if (auto code = it->second.code.lock()) {
+            return code;
+        }
+    }
+
+    uint64_t hash = ldpc_code::alist_hash(path);
+    ldpc_code::sptr code = d_codes[hash].lock();
+    if (code) {
+        DTL_LOG_DEBUG("get_ldpc_code: alist={}, shared", path);
+    } else {
+        prune();
+        code = ldpc_code::load(path, hash);
+        d_codes[hash] = code;
+        DTL_LOG_DEBUG("get_ldpc_code: alist={}, loaded", path);
+    }
+    if (stat_ok) {
+        d_paths[path] = { mtime, size, code };
+    }
+    return code;
+}
+
+ldpc_layers::sptr fec_code_registry::get_ldpc_layers(const ldpc_code::sptr& code,
+                                                      int align)
+{
+    lock_guard<mutex> lock(d_mutex);
+    auto& entry = d_layers[make_pair(code->hash(), align)];
+    ldpc_layers::sptr layers = entry.lock();
+    if (!layers) {
+        layers = make_shared<const ldpc_layers>(code, align);
+        entry = layers;
+    }
+    return layers;
+}
+
+void fec_code_registry::prune()
+{
+    for (auto it = d_paths.begin(); it != d_paths.end();) {
+        it = it->second.code.expired() ? d_paths.erase(it) : next(it);
+    }
+    for (auto it = d_codes.begin(); it != d_codes.end();) {
+        it = it->second.expired() ? d_codes.erase(it) : next(it);
+    }
+    for (auto it = d_layers.begin(); it != d_layers.end();) {
+        it = it->second.expired() ? d_layers.erase(it) : next(it);
+    }
+}
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_FEC_CODE_REGISTRY_H
+#define INCLUDED_DTL_FEC_CODE_REGISTRY_H
+
+#include "ldpc_code.h"
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Process wide registry of the read-only FEC code structures.
+ *
+ * Encoders and decoders of every flowgraph (TX and RX of a full duplex modem,
+ * several modems per process) get their codes from here, so each code is
+ * held once however many coder instances use it. Codes are looked up by alist
+ * path first, then by content, so copies of an alist file share a code too.
+ * Coder instances only own their working buffers.
+ *
+ * Entries are weak: a code is released once no coder uses it.
+ */
+class fec_code_registry
+{
+public:
+    static fec_code_registry& instance();
+
+    ldpc_code::sptr get_ldpc_code(const std::string& alist_fname);
+
+    // Row layout for layered decoding with rows padded to align entries
+    ldpc_layers::sptr get_ldpc_layers(const ldpc_code::sptr& code, int align);
+
+private:
+    struct path_entry_t {
+        std::filesystem::file_time_type mtime;
+        std::uintmax_t size;
+        std::weak_ptr<const ldpc_code> code;
+    };
+
+    std::mutex d_mutex;
+    std::map<std::string, path_entry_t> d_paths;
+    std::map<uint64_t, std::weak_ptr<const ldpc_code>> d_codes;
+    std::map<std::pair<uint64_t, int>, std::weak_ptr<const ldpc_layers>> d_layers;
+
+    fec_code_registry() = default;
+
+    void prune();
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /*INCLUDED_DTL_FEC_CODE_REGISTRY_H*/
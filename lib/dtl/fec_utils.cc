@@ -8,6 +8,11 @@
 
 
 #include "fec_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
 
 
 namespace gr {
@@ -28,7 +33,11 @@ fec_info_t::fec_info_t(fec_enc::sptr enc,
       d_tb_frame_idx(tb_frame_idx),
       d_tb_number(tb_number),
       d_tb_payload_len(tb_payload_len),
-      d_ncheck(0)
+      d_ncheck(0),
+      d_bps(0),
+      d_fec_idx(-1),
+      d_constellation(constellation_type_t::UNKNOWN),
+      d_snr(NAN)
 {
     if (d_enc != nullptr && d_dec != nullptr) {
         assert(d_enc->get_k() == d_enc->get_k());
@@ -62,11 +71,15 @@ fec_info_t::sptr make_fec_info(const std::vector<tag_t>& tags,
                                const std::vector<fec_dec::sptr>& decoders)
 {
     fec_info_t::sptr fec_info = std::make_shared<fec_info_t>();
+    fec_info->d_bps = 0;
+    fec_info->d_constellation = constellation_type_t::UNKNOWN;
+    fec_info->d_snr = NAN;
     int tags_check = 0;
     for (auto& tag : tags) {
         if (tag.key == fec_key()) {
             tags_check |= 1;
             unsigned fec_idx = pmt::to_long(tag.value);
+            fec_info->d_fec_idx = fec_idx;
             if (encoders.size() > 0 && fec_idx < encoders.size()) {
                 fec_info->d_enc = encoders[fec_idx];
                 fec_info->d_ncheck =
@@ -120,6 +133,58 @@ int align_bits_to_bytes(int nbits)
     return nbytes;
 }
 
+void copy_bits(
+    const unsigned char* src, int src_bit, unsigned char* dst, int dst_bit, int nbits)
+{
+    src += src_bit / 8;
+    src_bit %= 8;
+    dst += dst_bit / 8;
+    dst_bit %= 8;
+
+    if (src_bit == 0 && dst_bit == 0) {
+        memcpy(dst, src, nbits / 8);
+        if (nbits % 8) {
+            dst[nbits / 8] = src[nbits / 8] & ((1u << (nbits % 8)) - 1);
+        }
+        return;
+    }
+
+    // One destination byte per step
+    while (nbits > 0) {
+        int n = std::min(nbits, 8 - dst_bit);
+        unsigned v = src[0] >> src_bit;
+        if (src_bit + n > 8) {
+            v |= src[1] << (8 - src_bit);
+        }
+        *dst = (*dst & ((1u << dst_bit) - 1)) | ((v & ((1u << n) - 1)) << dst_bit);
+
+        src_bit += n;
+        src += src_bit / 8;
+        src_bit %= 8;
+        dst_bit = 0;
+        ++dst;
+        nbits -= n;
+    }
+}
+
+std::vector<int> get_ldpc_permute(cldpc& code)
+{
+    std::vector<int> permute;
+    //HACK: Get internal permute
+    std::stringstream new_buf;
+    auto orig_buf = std::cout.rdbuf();
+    std::cout.rdbuf(new_buf.rdbuf());
+    code.print_permute();
+    for (int i; new_buf >> i;) {
+        permute.push_back(i);
+        if (new_buf.peek() == ',') {
+            new_buf.ignore();
+        }
+    }
+    std::cout.rdbuf(orig_buf);
+    return permute;
+}
+
 
 } // namespace dtl
 } // namespace gr
@@ -12,6 +12,7 @@
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
 #include <cassert>
 
+#include <gnuradio/fec/cldpc.h>
 #include <gnuradio/tags.h>
 
 namespace gr {
@@ -30,6 +31,11 @@ struct fec_info_t {
     int d_tb_number;
     int d_tb_payload_len;
     int d_ncheck;
+    int d_bps;
+    // MCS and estimated SNR of the frame, for link adaptation
+    int d_fec_idx;
+    constellation_type_t d_constellation;
+    double d_snr;
 
     fec_info_t() = default;
 
@@ -55,6 +61,17 @@ int compute_tb_len(int cw_len, int frame_len);
 
 int align_bits_to_bytes(int nbits);
 
+/*!
+ * Copies nbits bits of src starting at bit src_bit to dst starting at bit
+ * dst_bit, bits packed LSB first. The bits of dst before dst_bit are kept, the
+ * bits of the last written byte past the copied ones are cleared.
+ */
+void copy_bits(
+    const unsigned char* src, int src_bit, unsigned char* dst, int dst_bit, int nbits);
+
+// Column permutation applied by cldpc to get the systematic form of H
+std::vector<int> get_ldpc_permute(cldpc& code);
+
 
 } // namespace dtl
 } // namespace gr
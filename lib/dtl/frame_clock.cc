@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/dtl/frame_clock.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+frame_clock::sptr frame_clock::make(double frame_rate, bool virtual_time)
+{
+    return make_shared<frame_clock>(frame_rate, virtual_time);
+}
+
+frame_clock::frame_clock(double frame_rate, bool virtual_time)
+    : d_frame_duration(chrono::duration<double>(1.0 / frame_rate)),
+      d_virtual_time(virtual_time),
+      d_time_tags(false),
+      d_origin_secs(0),
+      d_origin_frac(0),
+      d_start_time(chrono::steady_clock::now()),
+      d_frame_index(0)
+{
+}
+
+void frame_clock::start()
+{
+    d_start_time = chrono::steady_clock::now();
+    d_frame_index.store(0, memory_order_relaxed);
+}
+
+int frame_clock::wait(int max_frames)
+{
+    if (max_frames <= 0 || d_virtual_time) {
+        return max_frames;
+    }
+    uint64_t index = frame_index();
+    auto due = d_start_time + static_cast<double>(index) * d_frame_duration;
+    auto now = chrono::steady_clock::now();
+    if (now < due) {
+        this_thread::sleep_until(due);
+        return 1;
+    }
+    // Frames due by now, the frame at index at least
+    double elapsed = chrono::duration<double>(now - d_start_time) / d_frame_duration;
+    uint64_t ndue = max<uint64_t>(static_cast<uint64_t>(elapsed) + 1, index + 1) - index;
+    return static_cast<int>(min<uint64_t>(max_frames, ndue));
+}
+
+void frame_clock::set_time_tags(bool enable, double time_origin)
+{
+    d_time_tags = enable;
+    d_origin_secs = static_cast<uint64_t>(floor(time_origin));
+    d_origin_frac = time_origin - floor(time_origin);
+}
+
+pmt::pmt_t frame_clock::tx_time(uint64_t index) const
+{
+    double t = d_origin_frac + frame_time(index);
+    double secs = floor(t);
+    return pmt::make_tuple(pmt::from_uint64(d_origin_secs + static_cast<uint64_t>(secs)),
+                           pmt::from_double(t - secs));
+}
+
+} // namespace dtl
+} // namespace gr
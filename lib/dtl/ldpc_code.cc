@@ -0,0 +1,383 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ldpc_code.h"
+#include "fec_utils.h"
+#include <gnuradio/fec/alist.h>
+#include <gnuradio/fec/cldpc.h>
+#include <gnuradio/testbed/logger.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace gr {
+namespace dtl {
+
+INIT_DTL_LOGGER("ldpc_code");
+
+using namespace std;
+
+namespace {
+
+const uint64_t IMAGE_MAGIC = 0x45444f4350444c44; // "DLDPCODE"
+const uint32_t IMAGE_VERSION = 1;
+
+// Compiled code image, followed by the permute, row_ptr and cols int32 arrays
+// and the 8 byte aligned generator.
+struct image_header_t {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    // Hash of the alist content
+    uint64_t hash;
+    // Hash of the image past the header
+    uint64_t checksum;
+    uint64_t size;
+    int32_t n;
+    int32_t k;
+    int32_t nrows;
+    int32_t gen_words;
+    int64_t edges;
+};
+
+struct image_layout_t {
+    size_t permute;
+    size_t row_ptr;
+    size_t cols;
+    size_t gen;
+    size_t size;
+};
+
+image_layout_t
+image_layout(int64_t n, int64_t k, int64_t nrows, int64_t edges, int64_t gen_words)
+{
+    image_layout_t l;
+    l.permute = sizeof(image_header_t);
+    l.row_ptr = l.permute + n * sizeof(int32_t);
+    l.cols = l.row_ptr + (nrows + 1) * sizeof(int32_t);
+    l.gen = 8 * ((l.cols + edges * sizeof(int32_t) + 7) / 8);
+    l.size = l.gen + k * gen_words * sizeof(uint64_t);
+    return l;
+}
+
+// 64 bit FNV-1a
+uint64_t content_hash(const void* data, size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = 0xcbf29ce484222325;
+    for (size_t i = 0; i < size; ++i) {
+        h = (h ^ p[i]) * 0x100000001b3;
+    }
+    return h;
+}
+
+string cache_dir()
+{
+    const char* dir = getenv("DTL_LDPC_CACHE_DIR");
+    if (dir) {
+        return dir;
+    }
+    if ((dir = getenv("XDG_CACHE_HOME")) && *dir) {
+        return string(dir) + "/gr-dtl/ldpc";
+    }
+    if ((dir = getenv("HOME")) && *dir) {
+        return string(dir) + "/.cache/gr-dtl/ldpc";
+    }
+    return "";
+}
+
+string cache_file(uint64_t hash)
+{
+    string dir = cache_dir();
+    if (dir.empty()) {
+        return "";
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.ldpc", static_cast<unsigned long long>(hash));
+    return dir + "/" + name;
+}
+
+void store_image(const string& fname, const vector<uint64_t>& image, size_t size)
+{
+    // Write to a temporary file and rename so that readers never map a partial file
+    error_code ec;
+    filesystem::create_directories(filesystem::path(fname).parent_path(), ec);
+    string tmp_fname = fname + ".tmp." + to_string(getpid());
+    {
+        ofstream out(tmp_fname, ios::binary | ios::trunc);
+        out.write(reinterpret_cast<const char*>(image.data()), size);
+        if (!out) {
+            DTL_LOG_ERROR("can't write LDPC cache file {}", tmp_fname);
+            filesystem::remove(tmp_fname, ec);
+            return;
+        }
+    }
+    filesystem::rename(tmp_fname, fname, ec);
+    if (ec) {
+        DTL_LOG_ERROR("can't write LDPC cache file {}: {}", fname, ec.message());
+        filesystem::remove(tmp_fname, ec);
+    }
+}
+
+} // namespace
+
+ldpc_code::ldpc_code()
+    : d_hash(0),
+      d_n(0),
+      d_k(0),
+      d_nrows(0),
+      d_gen_words(0),
+      d_permute(nullptr),
+      d_row_ptr(nullptr),
+      d_cols(nullptr),
+      d_gen(nullptr),
+      d_map(nullptr),
+      d_map_size(0)
+{
+}
+
+ldpc_code::~ldpc_code()
+{
+    if (d_map) {
+        munmap(d_map, d_map_size);
+    }
+}
+
+bool ldpc_code::attach(const void* image, size_t size, uint64_t hash)
+{
+    if (size < sizeof(image_header_t)) {
+        return false;
+    }
+    const image_header_t* hdr = static_cast<const image_header_t*>(image);
+    if (hdr->magic != IMAGE_MAGIC || hdr->version != IMAGE_VERSION ||
+        hdr->header_size != sizeof(image_header_t) || hdr->hash != hash ||
+        hdr->size != size || hdr->n <= 0 || hdr->k <= 0 || hdr->k >= hdr->n ||
+        hdr->nrows <= 0 || hdr->edges < 0 || hdr->gen_words < 0) {
+        return false;
+    }
+    image_layout_t l =
+        image_layout(hdr->n, hdr->k, hdr->nrows, hdr->edges, hdr->gen_words);
+    if (l.size != size) {
+        return false;
+    }
+
+    const char* base = static_cast<const char*>(image);
+    if (content_hash(base + sizeof(image_header_t), size - sizeof(image_header_t)) !=
+        hdr->checksum) {
+        return false;
+    }
+    d_hash = hash;
+    d_n = hdr->n;
+    d_k = hdr->k;
+    d_nrows = hdr->nrows;
+    d_gen_words = hdr->gen_words;
+    d_permute = reinterpret_cast<const int32_t*>(base + l.permute);
+    d_row_ptr = reinterpret_cast<const int32_t*>(base + l.row_ptr);
+    d_cols = reinterpret_cast<const int32_t*>(base + l.cols);
+    d_gen = reinterpret_cast<const uint64_t*>(base + l.gen);
+
+    // The coders index with these unchecked
+    if (d_row_ptr[0] != 0 || d_row_ptr[d_nrows] != hdr->edges) {
+        return false;
+    }
+    for (int i = 0; i < d_nrows; ++i) {
+        if (d_row_ptr[i + 1] < d_row_ptr[i]) {
+            return false;
+        }
+    }
+    for (int i = 0; i < d_n; ++i) {
+        if (d_permute[i] < 0 || d_permute[i] >= d_n) {
+            return false;
+        }
+    }
+    for (int64_t i = 0; i < hdr->edges; ++i) {
+        if (d_cols[i] < 0 || d_cols[i] >= d_n) {
+            return false;
+        }
+    }
+    return true;
+}
+
+vector<uint64_t> ldpc_code::compile(const string& alist_fname, uint64_t hash)
+{
+    alist list;
+    list.read(alist_fname.c_str());
+    cldpc code;
+    code.set_alist(list);
+    int n = code.get_N();
+    int k = code.dimension();
+    int ncheck = n - k;
+
+    // Column of H -> position in the encoder output
+    vector<int> permute(get_ldpc_permute(code));
+    vector<int> column_pos(n);
+    for (int i = 0; i < n; ++i) {
+        column_pos[permute[i]] = i;
+    }
+
+    vector<int> row_ptr{ 0 };
+    vector<int> cols;
+    for (auto& row : list.get_mlist()) {
+        for (auto col : row) {
+            // skip alist zero padding
+            if (col > 0) {
+                cols.push_back(column_pos[col - 1]);
+            }
+        }
+        row_ptr.push_back(cols.size());
+    }
+    int nrows = row_ptr.size() - 1;
+
+    // Packed H, one row of row_words per check
+    int row_words = (n + 63) / 64;
+    vector<uint64_t> h(nrows * row_words, 0);
+    for (int m = 0; m < nrows; ++m) {
+        for (int e = row_ptr[m]; e < row_ptr[m + 1]; ++e) {
+            h[m * row_words + cols[e] / 64] ^= uint64_t(1) << (cols[e] % 64);
+        }
+    }
+    auto bit = [&h, row_words](int row, int col) {
+        return (h[row * row_words + col / 64] >> (col % 64)) & 1;
+    };
+
+    // Reduce to [I | A]: the permutation puts independent columns first.
+    // Redundant checks end up as zero rows past ncheck.
+    for (int c = 0; c < ncheck; ++c) {
+        int pivot = c;
+        while (pivot < nrows && !bit(pivot, c)) {
+            ++pivot;
+        }
+        if (pivot == nrows) {
+            throw runtime_error("ldpc_code: check columns are not independent");
+        }
+        swap_ranges(
+            &h[pivot * row_words], &h[(pivot + 1) * row_words], &h[c * row_words]);
+        for (int m = 0; m < nrows; ++m) {
+            if (m != c && bit(m, c)) {
+                for (int w = 0; w < row_words; ++w) {
+                    h[m * row_words + w] ^= h[c * row_words + w];
+                }
+            }
+        }
+    }
+
+    int gen_words = 4 * ((ncheck + 255) / 256);
+    image_layout_t l = image_layout(n, k, nrows, cols.size(), gen_words);
+    vector<uint64_t> image((l.size + 7) / 8, 0);
+    char* base = reinterpret_cast<char*>(image.data());
+
+    image_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = IMAGE_MAGIC;
+    hdr.version = IMAGE_VERSION;
+    hdr.header_size = sizeof(image_header_t);
+    hdr.hash = hash;
+    hdr.size = l.size;
+    hdr.n = n;
+    hdr.k = k;
+    hdr.nrows = nrows;
+    hdr.gen_words = gen_words;
+    hdr.edges = cols.size();
+    memcpy(base, &hdr, sizeof(hdr));
+    copy(permute.begin(), permute.end(), reinterpret_cast<int32_t*>(base + l.permute));
+    copy(row_ptr.begin(), row_ptr.end(), reinterpret_cast<int32_t*>(base + l.row_ptr));
+    copy(cols.begin(), cols.end(), reinterpret_cast<int32_t*>(base + l.cols));
+
+    // Check bit i = XOR over data bits j of A[i][j]: store A column wise
+    uint64_t* gen = reinterpret_cast<uint64_t*>(base + l.gen);
+    for (int i = 0; i < ncheck; ++i) {
+        for (int j = 0; j < k; ++j) {
+            if (bit(i, ncheck + j)) {
+                gen[j * gen_words + i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+    reinterpret_cast<image_header_t*>(base)->checksum =
+        content_hash(base + sizeof(image_header_t), l.size - sizeof(image_header_t));
+    return image;
+}
+
+uint64_t ldpc_code::alist_hash(const string& alist_fname)
+{
+    ifstream in(alist_fname, ios::binary);
+    stringstream content;
+    content << in.rdbuf();
+    if (!in) {
+        throw runtime_error("ldpc_code: can't read " + alist_fname);
+    }
+    const string& alist_data = content.str();
+    return content_hash(alist_data.data(), alist_data.size());
+}
+
+ldpc_code::sptr ldpc_code::load(const string& alist_fname, uint64_t hash)
+{
+    shared_ptr<ldpc_code> code(new ldpc_code());
+    string fname = cache_file(hash);
+    if (!fname.empty()) {
+        int fd = open(fname.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                code->d_map = map;
+                code->d_map_size = st.st_size;
+            }
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    if (code->d_map && code->attach(code->d_map, code->d_map_size, hash)) {
+        DTL_LOG_DEBUG("load: alist={}, cache={}", alist_fname, fname);
+    } else {
+        if (code->d_map) {
+            munmap(code->d_map, code->d_map_size);
+            code->d_map = nullptr;
+        }
+        code->d_image = compile(alist_fname, hash);
+        size_t size = reinterpret_cast<const image_header_t*>(code->d_image.data())->size;
+        if (!code->attach(code->d_image.data(), size, hash)) {
+            throw runtime_error("ldpc_code: invalid code " + alist_fname);
+        }
+        if (!fname.empty()) {
+            store_image(fname, code->d_image, size);
+        }
+        DTL_LOG_DEBUG("load: alist={}, compiled, cache={}", alist_fname, fname);
+    }
+    DTL_LOG_DEBUG("load: n={}, k={}, rows={}", code->d_n, code->d_k, code->d_nrows);
+    return code;
+}
+
+ldpc_layers::ldpc_layers(ldpc_code::sptr code, int align)
+    : code(code), align(align), max_row(0)
+{
+    const int32_t* row_ptr = code->row_ptr();
+    for (int m = 0; m < code->nrows(); ++m) {
+        int deg = row_ptr[m + 1] - row_ptr[m];
+        int padded = align * ((deg + align - 1) / align);
+        row_offset.push_back(cols.size());
+        row_deg.push_back(deg);
+        edge_offset.push_back(row_ptr[m]);
+        cols.insert(
+            cols.end(), &code->cols()[row_ptr[m]], &code->cols()[row_ptr[m + 1]]);
+        cols.resize(cols.size() + padded - deg, 0);
+        max_row = max(max_row, padded);
+    }
+    row_offset.push_back(cols.size());
+}
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,116 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_LDPC_CODE_H
+#define INCLUDED_DTL_LDPC_CODE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Compiled description of an LDPC code read from an alist file.
+ *
+ * Holds what the encoders and decoders derive from the alist: the cldpc column
+ * permutation, the parity check matrix in CSR form with the columns mapped to
+ * the encoder output layout (check bits first, then data bits) and the packed
+ * generator used by ldpc_enc.
+ *
+ * Codes are obtained through fec_code_registry, which shares them between all
+ * encoders and decoders of the same alist content. load() stores compiled codes
+ * in a cache directory keyed by the hash of the alist content and memory maps
+ * them on the next start. The directory is $DTL_LDPC_CACHE_DIR,
+ * $XDG_CACHE_HOME/gr-dtl/ldpc or ~/.cache/gr-dtl/ldpc; setting
+ * DTL_LDPC_CACHE_DIR to an empty string disables the on-disk cache.
+ */
+class ldpc_code
+{
+public:
+    typedef std::shared_ptr<const ldpc_code> sptr;
+
+    // Hash of the alist file content, identifies the code
+    static uint64_t alist_hash(const std::string& alist_fname);
+
+    // Map the cached code for the hash or compile the alist file
+    static sptr load(const std::string& alist_fname, uint64_t hash);
+
+    ldpc_code(const ldpc_code&) = delete;
+    ldpc_code& operator=(const ldpc_code&) = delete;
+    ~ldpc_code();
+
+    uint64_t hash() const { return d_hash; }
+    int n() const { return d_n; }
+    int k() const { return d_k; }
+    int ncheck() const { return d_n - d_k; }
+    // Rows of H, including redundant checks
+    int nrows() const { return d_nrows; }
+    // H column (0 based alist column) at each encoder output position
+    const int32_t* permute() const { return d_permute; }
+    // Row i of H covers cols()[row_ptr()[i]] to cols()[row_ptr()[i + 1]]
+    const int32_t* row_ptr() const { return d_row_ptr; }
+    // Encoder output positions of the row entries
+    const int32_t* cols() const { return d_cols; }
+    // Words per generator column, multiple of 4
+    int gen_words() const { return d_gen_words; }
+    // k columns of gen_words() words, bit i of column j set if data bit j
+    // contributes to check bit i
+    const uint64_t* gen() const { return d_gen; }
+
+private:
+    uint64_t d_hash;
+    int d_n;
+    int d_k;
+    int d_nrows;
+    int d_gen_words;
+    const int32_t* d_permute;
+    const int32_t* d_row_ptr;
+    const int32_t* d_cols;
+    const uint64_t* d_gen;
+
+    // Backing storage: either a compiled image or a mapped cache file
+    std::vector<uint64_t> d_image;
+    void* d_map;
+    std::size_t d_map_size;
+
+    ldpc_code();
+
+    bool attach(const void* image, std::size_t size, uint64_t hash);
+
+    static std::vector<uint64_t> compile(const std::string& alist_fname,
+                                         uint64_t hash);
+};
+
+/*!
+ * Check rows of an ldpc_code laid out for the layered decoders: each row starts
+ * at row_offset[m] in cols and is padded to a multiple of align entries.
+ * edge_offset[m] is the index of the first edge of row m without padding.
+ */
+struct ldpc_layers {
+    typedef std::shared_ptr<const ldpc_layers> sptr;
+
+    ldpc_layers(ldpc_code::sptr code, int align);
+
+    // Keeps the code alive for the layout users
+    ldpc_code::sptr code;
+    int align;
+    // Longest padded row
+    int max_row;
+    std::vector<int> row_offset;
+    std::vector<int> row_deg;
+    std::vector<int> edge_offset;
+    std::vector<int> cols;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /*INCLUDED_DTL_LDPC_CODE_H*/
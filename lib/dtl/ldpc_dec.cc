@@ -6,7 +6,8 @@
  */
 
 #include "ldpc_dec.h"
-#include <cstring>
+#include "fec_code_registry.h"
+#include "ldpc_minsum_dec.h"
 #include <gnuradio/dtl/api.h>
 #include <iostream>
 #include <gnuradio/testbed/logger.h>
@@ -20,11 +21,29 @@ INIT_DTL_LOGGER("ldpc_dec");
 using namespace std;
 
 
-vector<fec_dec::sptr> DTL_API make_ldpc_decoders(const vector<string>& alist_fnames)
+vector<fec_dec::sptr> DTL_API make_ldpc_decoders(const vector<string>& alist_fnames,
+                                                 ldpc_decoder_type_t type,
+                                                 int max_it)
 {
     vector<fec_dec::sptr> decoders{nullptr};
     for (auto& fname: alist_fnames) {
-        ldpc_dec::sptr dec(new ldpc_dec(fname, 15));
+        fec_dec::sptr dec;
+        switch (type) {
+        case ldpc_decoder_type_t::BP:
+            dec = make_shared<ldpc_dec>(fname, max_it);
+            break;
+        case ldpc_decoder_type_t::MINSUM:
+            dec = make_shared<ldpc_minsum_dec<float>>(fname, max_it, 0.75, 0);
+            break;
+        case ldpc_decoder_type_t::MINSUM_INT16:
+            dec = make_shared<ldpc_minsum_dec<int16_t>>(fname, max_it, 1, 1);
+            break;
+        case ldpc_decoder_type_t::MINSUM_INT8:
+            dec = make_shared<ldpc_minsum_dec<int8_t>>(fname, max_it, 1, 1);
+            break;
+        default:
+            throw invalid_argument("Unknown LDPC decoder type");
+        }
         decoders.push_back(dec);
     }
     return decoders;
@@ -32,54 +51,48 @@ vector<fec_dec::sptr> DTL_API make_ldpc_decoders(const vector<string>& alist_fna
 
 
 ldpc_dec::ldpc_dec(const std::string& alist_fname, int max_it)
+    : d_code(fec_code_registry::instance().get_ldpc_code(alist_fname))
 {
     DTL_LOG_DEBUG("constructor: alist={}", alist_fname);
 
     d_list.read(alist_fname.c_str());
-    d_code.set_alist(d_list);
-    //HACK: Get internal permute
-    {
-        stringstream new_buf;
-        auto orig_buf = cout.rdbuf();
-        cout.rdbuf(new_buf.rdbuf());
-        d_code.print_permute();
-
-        for (int i; new_buf >> i;) {
-            d_permute.push_back(i);
-            if (new_buf.peek() == ',') {
-                new_buf.ignore();
-            }
-        }
-        cout.rdbuf(orig_buf);
-    }
     d_bp.set_alist(d_list);
     d_bp.set_max_iterations(max_it);
-    d_bp.set_K(d_code.dimension());
-    d_cw_buf.resize(d_code.get_N());
+    d_bp.set_K(d_code->k());
+    d_cw_buf.resize(d_code->n());
 }
 
 
 int ldpc_dec::decode(const float* in_data, int* nit, unsigned char* out_data)
 {
-    for (int i=0; i<d_code.get_N(); ++i) {
-        d_cw_buf[d_permute[i]] = -1 * in_data[i];
+    const int32_t* permute = d_code->permute();
+    for (int i = 0; i < d_code->n(); ++i) {
+        d_cw_buf[permute[i]] = -1 * in_data[i];
     }
     std::vector<uint8_t> estimated(d_bp.decode(d_cw_buf, nit));
-    std::vector<uint8_t> data(d_code.get_systematic_bits(estimated));
-    memcpy(out_data, &data[0], d_code.dimension());
-    return d_code.dimension();
+    // Systematic bits follow the check bits in the permuted order
+    for (int i = 0; i < d_code->k(); ++i) {
+        out_data[i] = estimated[permute[d_code->ncheck() + i]];
+    }
+    return d_code->k();
+}
+
+
+fec_dec::sptr ldpc_dec::clone()
+{
+    return make_shared<ldpc_dec>(*this);
 }
 
 
 int ldpc_dec::get_k()
 {
-    return d_code.dimension();
+    return d_code->k();
 }
 
 
 int ldpc_dec::get_n()
 {
-    return d_code.get_N();
+    return d_code->n();
 }
 
 
@@ -8,10 +8,10 @@
 #ifndef INCLUDED_DTL_LDPC_DEC_H
 #define INCLUDED_DTL_LDPC_DEC_H
 
+#include "ldpc_code.h"
 #include <gnuradio/dtl/fec.h>
 #include <gnuradio/fec/alist.h>
 #include <gnuradio/fec/awgn_bp.h>
-#include <gnuradio/fec/cldpc.h>
 
 namespace gr {
 namespace dtl {
@@ -20,16 +20,16 @@ class ldpc_dec: public fec_dec
 {
 private:
 
+    ldpc_code::sptr d_code;
     alist d_list;
-    cldpc d_code;
     awgn_bp d_bp;
     std::vector<float> d_cw_buf;
-    std::vector<int> d_permute;
 
 
 public:
     ldpc_dec(const std::string& alist_fname, int max_it);
     int decode(const float* in_data, int *nit, unsigned char* out_data) override;
+    fec_dec::sptr clone() override;
     int get_k() override;
     int get_n() override;
 
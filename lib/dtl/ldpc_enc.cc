@@ -6,10 +6,16 @@
  */
 
 #include "ldpc_enc.h"
-#include <cstring>
+#include "fec_code_registry.h"
+#include "fec_utils.h"
 #include <gnuradio/dtl/api.h>
-#include <iostream>
 #include <gnuradio/testbed/logger.h>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DTL_LDPC_ENC_X86 1
+#endif
 
 namespace gr {
 namespace dtl {
@@ -18,65 +24,113 @@ INIT_DTL_LOGGER("ldpc_enc");
 
 using namespace std;
 
+static void xor_generic(uint64_t* acc, const uint64_t* col, int nwords)
+{
+    for (int i = 0; i < nwords; ++i) {
+        acc[i] ^= col[i];
+    }
+}
+
+#if DTL_LDPC_ENC_X86
+
+__attribute__((target("avx2"))) static void
+xor_avx2(uint64_t* acc, const uint64_t* col, int nwords)
+{
+    for (int i = 0; i < nwords; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + i));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i),
+                            _mm256_xor_si256(a, c));
+    }
+}
+
+#endif // DTL_LDPC_ENC_X86
+
 vector<fec_enc::sptr> DTL_API make_ldpc_encoders(const vector<string>& alist_fnames)
 {
-    vector<fec_enc::sptr> encoders{nullptr};
-    for (auto& fname: alist_fnames) {
+    vector<fec_enc::sptr> encoders{ nullptr };
+    for (auto& fname : alist_fnames) {
         ldpc_enc::sptr enc(new ldpc_enc(fname));
         encoders.push_back(enc);
     }
-    encoders[1]->get_k();
     return encoders;
 }
 
-ldpc_enc::ldpc_enc(const string& alist_fname) {
-    DTL_LOG_DEBUG("constructor: alist={}", alist_fname);
-
-    d_list.read(alist_fname.c_str());
-    d_code.set_alist(d_list);
-
-    //HACK: Get internal permute
-    {
-        stringstream new_buf;
-        auto orig_buf = cout.rdbuf();
-        cout.rdbuf(new_buf.rdbuf());
-        d_code.print_permute();
-        for (int i; new_buf >> i;) {
-            d_permute.push_back(i);    
-            if (new_buf.peek() == ',') {
-                new_buf.ignore();
-            }
-        }
-        cout.rdbuf(orig_buf);
+ldpc_enc::ldpc_enc(const string& alist_fname)
+    : d_code(fec_code_registry::instance().get_ldpc_code(alist_fname)),
+      d_parity(d_code->gen_words()),
+      d_xor(xor_generic)
+{
+#if DTL_LDPC_ENC_X86
+    if (__builtin_cpu_supports("avx2")) {
+        d_xor = xor_avx2;
     }
-    d_in_buf.resize(d_code.dimension());
-    DTL_LOG_DEBUG("constructor: buf={}, k={}, n={}", d_in_buf.size(), d_code.dimension(), d_code.get_N());
+#endif
+
+    DTL_LOG_DEBUG("constructor: alist={}, k={}, n={}, gen_words={}",
+                  alist_fname,
+                  d_code->k(),
+                  d_code->n(),
+                  d_code->gen_words());
 }
 
 ldpc_enc::~ldpc_enc() {}
 
 void ldpc_enc::encode(const unsigned char* in_data, int len, unsigned char* out_data)
 {
-    std::vector<unsigned char> in_buf;
-    in_buf.resize(len);
-    memcpy(&in_buf[0], in_data, len);
-    std::vector<unsigned char> coded(d_code.encode(in_buf));
-    //memcpy(&out_data[0], &coded[0], coded.size());
-    for (size_t i=0; i<coded.size(); ++i) {
-        out_data[i] = coded[d_permute[i]];
+    int k = d_code->k();
+    int ncheck = d_code->ncheck();
+    int gen_words = d_code->gen_words();
+
+    fill(d_parity.begin(), d_parity.end(), 0);
+    const uint64_t* col = d_code->gen();
+    for (int j = 0; j < k; ++j, col += gen_words) {
+        if (in_data[j] & 1) {
+            d_xor(&d_parity[0], col, gen_words);
+        }
     }
-}
 
-int ldpc_enc::get_k()
-{
-    return d_code.dimension();
+    for (int i = 0; i < ncheck; ++i) {
+        out_data[i] = (d_parity[i / 64] >> (i % 64)) & 1;
+    }
+    for (int j = 0; j < k; ++j) {
+        out_data[ncheck + j] = in_data[j] & 1;
+    }
 }
 
-int ldpc_enc::get_n()
+void ldpc_enc::encode_packed(const unsigned char* in_data, unsigned char* out_data)
 {
-    return d_code.get_N();
+    int k = d_code->k();
+    int ncheck = d_code->ncheck();
+    int gen_words = d_code->gen_words();
+
+    fill(d_parity.begin(), d_parity.end(), 0);
+    const uint64_t* gen = d_code->gen();
+    for (int b = 0; b < align_bits_to_bytes(k); ++b) {
+        unsigned bits = in_data[b];
+        if (8 * b + 8 > k) {
+            bits &= (1u << (k % 8)) - 1;
+        }
+        while (bits) {
+            int j = 8 * b + __builtin_ctz(bits);
+            d_xor(&d_parity[0], gen + j * gen_words, gen_words);
+            bits &= bits - 1;
+        }
+    }
+
+    // Check bits are the low bits of the parity words, data bits follow
+    for (int i = 0; i < align_bits_to_bytes(ncheck); ++i) {
+        out_data[i] = d_parity[i / 8] >> (8 * (i % 8));
+    }
+    if (ncheck % 8) {
+        out_data[ncheck / 8] &= (1u << (ncheck % 8)) - 1;
+    }
+    copy_bits(in_data, 0, out_data, ncheck, k);
 }
 
+int ldpc_enc::get_k() { return d_code->k(); }
+
+int ldpc_enc::get_n() { return d_code->n(); }
 
 } // namespace dtl
-} // namespace gr
\ No newline at end of file
+} // namespace gr
@@ -8,29 +8,44 @@
 #ifndef INCLUDED_DTL_LDPC_ENC_H
 #define INCLUDED_DTL_LDPC_ENC_H
 
+#include "ldpc_code.h"
 #include <gnuradio/dtl/fec.h>
-#include <gnuradio/fec/alist.h>
-#include <gnuradio/fec/cldpc.h>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace gr {
 namespace dtl {
 
-class ldpc_enc: public fec_enc
+/*!
+ * Table driven LDPC encoder.
+ *
+ * Uses the generator of the compiled ldpc_code: the parity check matrix reduced
+ * to systematic form, with the gr::fec::cldpc column permutation already
+ * applied, as the packed set of check bits every data bit contributes to.
+ * encode() XORs the generator columns of the set data bits, 64 check bits per
+ * machine word (256 with AVX2), and writes the codeword in the layout expected
+ * by the decoders (check bits first, then data bits) without allocating.
+ * encode_packed() does the same on packed bits, visiting only the set data bits
+ * and storing the parity words as they are.
+ */
+class ldpc_enc : public fec_enc
 {
 private:
-    alist d_list;
-    cldpc d_code;
-    std::vector<char> d_in_buf;
-    std::vector<int> d_permute;
+    typedef void (*xor_kernel_t)(uint64_t* acc, const uint64_t* col, int nwords);
+
+    ldpc_code::sptr d_code;
+    std::vector<uint64_t> d_parity;
+    xor_kernel_t d_xor;
 
 public:
     explicit ldpc_enc(const std::string& alist_fname);
     ~ldpc_enc();
 
     void encode(const unsigned char* in_data, int len, unsigned char* out_data) override;
+    void encode_packed(const unsigned char* in_data, unsigned char* out_data) override;
     int get_k() override;
     int get_n() override;
-
 };
 
 } // namespace dtl
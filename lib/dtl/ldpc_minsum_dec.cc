@@ -0,0 +1,372 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ldpc_minsum_dec.h"
+#include "fec_code_registry.h"
+#include <gnuradio/testbed/logger.h>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace gr {
+namespace dtl {
+
+INIT_DTL_LOGGER("ldpc_minsum_dec");
+
+using namespace std;
+
+namespace {
+
+// Hard decision of k LLRs stride apart, one bit per byte or packed LSB first
+template <typename T>
+void hard_decision(const T* llr, int stride, int k, bool packed, unsigned char* out)
+{
+    if (!packed) {
+        for (int i = 0; i < k; ++i) {
+            out[i] = (llr[i * stride] < 0);
+        }
+        return;
+    }
+    for (int i = 0; i < k; i += 8) {
+        int nbits = min(8, k - i);
+        unsigned char byte = 0;
+        for (int b = 0; b < nbits; ++b) {
+            byte |= (llr[(i + b) * stride] < 0) << b;
+        }
+        out[i / 8] = byte;
+    }
+}
+
+} // namespace
+
+template <typename T>
+ldpc_minsum_dec<T>::ldpc_minsum_dec(const string& alist_fname,
+                                    int max_it,
+                                    float scale,
+                                    float offset)
+    : d_max_it(max_it),
+      d_kernel(get_minsum_row_kernel<T>()),
+      d_batch_kernel(get_minsum_batch_kernel<T>())
+{
+    fec_code_registry& registry = fec_code_registry::instance();
+    d_layers = registry.get_ldpc_layers(registry.get_ldpc_code(alist_fname),
+                                        MINSUM_ROW_ALIGN);
+    const ldpc_code& code = *d_layers->code;
+    d_n = code.n();
+    d_k = code.k();
+    int max_row = d_layers->max_row;
+    int row_offset = d_layers->row_offset.back();
+    int edges = code.row_ptr()[code.nrows()];
+
+    d_llr.resize(d_n);
+    d_msg.resize(row_offset);
+    d_q.resize(max_row);
+    d_l.resize(max_row);
+    d_params.scale = scale;
+    d_params.offset = static_cast<T>(offset);
+
+    constexpr int lanes = minsum_batch_lanes<T>();
+    d_lane_llr.resize(d_n * lanes);
+    d_lane_msg.resize(edges * lanes);
+    d_lane_q.resize(max_row * lanes);
+    d_lane_l.resize(max_row * lanes);
+    d_lane_done.resize(lanes);
+    d_lane_parity.resize(lanes);
+
+    // A batch runs all the lanes over the edges of a row, a codeword alone the
+    // padded row
+    d_min_lanes = max(2, lanes * edges / row_offset + 1);
+
+    DTL_LOG_DEBUG("constructor: alist={}, n={}, k={}, rows={}, edges={}, min_lanes={}",
+                  alist_fname,
+                  d_n,
+                  d_k,
+                  d_layers->row_deg.size(),
+                  row_offset,
+                  d_min_lanes);
+}
+
+template <typename T>
+void ldpc_minsum_dec<T>::load_llrs(const float* in_data, T* llr, int stride)
+{
+    // Input LLRs are positive for bit 1, the decoder works with positive for bit 0.
+    if constexpr (is_floating_point<T>::value) {
+        for (int i = 0; i < d_n; ++i) {
+            llr[i * stride] = -in_data[i];
+        }
+    } else {
+        // Fixed scale: the offset of the check node update is a fixed fraction of
+        // an LLR unit, and the channel LLRs keep their resolution whatever the
+        // number of shortened bits, which get their own level.
+        float qscale = minsum_traits<T>::chan_scale;
+        float chan_max = minsum_traits<T>::chan_max;
+        for (int i = 0; i < d_n; ++i) {
+            if (in_data[i] == SHORTENED_LLR) {
+                llr[i * stride] = minsum_traits<T>::shortened;
+                continue;
+            }
+            float v = -in_data[i] * qscale;
+            v = max(-chan_max, min(chan_max, v));
+            llr[i * stride] = static_cast<T>(lrintf(v));
+        }
+    }
+}
+
+template <typename T>
+void ldpc_minsum_dec<T>::update_layers()
+{
+    const ldpc_layers& layers = *d_layers;
+    for (size_t m = 0; m < layers.row_deg.size(); ++m) {
+        const int* cols = &layers.cols[layers.row_offset[m]];
+        T* msg = &d_msg[layers.row_offset[m]];
+        int deg = layers.row_deg[m];
+        int row_len = layers.row_offset[m + 1] - layers.row_offset[m];
+
+        for (int j = 0; j < deg; ++j) {
+            d_q[j] = minsum_saturate<T>(d_llr[cols[j]] - msg[j]);
+        }
+        fill(d_q.begin() + deg, d_q.begin() + row_len, minsum_traits<T>::max_llr);
+
+        d_kernel(&d_q[0], msg, &d_l[0], row_len, d_params);
+
+        for (int j = 0; j < deg; ++j) {
+            d_llr[cols[j]] = d_l[j];
+        }
+    }
+}
+
+template <typename T>
+bool ldpc_minsum_dec<T>::check_syndrome()
+{
+    const ldpc_layers& layers = *d_layers;
+    for (size_t m = 0; m < layers.row_deg.size(); ++m) {
+        const int* cols = &layers.cols[layers.row_offset[m]];
+        bool parity = false;
+        for (int j = 0; j < layers.row_deg[m]; ++j) {
+            parity ^= (d_llr[cols[j]] < 0);
+        }
+        if (parity) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::decode(const float* in_data, int* nit, unsigned char* out_data)
+{
+    return decode_cw(in_data, nit, out_data, false);
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::decode_cw(const float* in_data,
+                                  int* nit,
+                                  unsigned char* out_data,
+                                  bool packed)
+{
+    load_llrs(in_data, &d_llr[0], 1);
+    fill(d_msg.begin(), d_msg.end(), 0);
+
+    int it = 0;
+    while (it < d_max_it && !check_syndrome()) {
+        update_layers();
+        ++it;
+    }
+    *nit = it;
+
+    // Systematic bits follow the check bits
+    hard_decision(&d_llr[d_n - d_k], 1, d_k, packed, out_data);
+    return d_k;
+}
+
+template <typename T>
+void ldpc_minsum_dec<T>::load_lane_llrs(const float* llrs, int nlanes)
+{
+    constexpr int lanes = minsum_batch_lanes<T>();
+    for (int w = 0; w < lanes; ++w) {
+        if (w < nlanes) {
+            load_llrs(&llrs[w * d_n], &d_lane_llr[w], lanes);
+        } else {
+            // Unused lanes carry the all-zero codeword
+            for (int i = 0; i < d_n; ++i) {
+                d_lane_llr[i * lanes + w] = minsum_traits<T>::chan_max;
+            }
+        }
+    }
+}
+
+template <typename T>
+void ldpc_minsum_dec<T>::update_lane_layers()
+{
+    const ldpc_layers& layers = *d_layers;
+    constexpr int lanes = minsum_batch_lanes<T>();
+    for (size_t m = 0; m < layers.row_deg.size(); ++m) {
+        const int* cols = &layers.cols[layers.row_offset[m]];
+        T* msg = &d_lane_msg[layers.edge_offset[m] * lanes];
+        int deg = layers.row_deg[m];
+
+        for (int j = 0; j < deg; ++j) {
+            const T* llr = &d_lane_llr[cols[j] * lanes];
+            T* q = &d_lane_q[j * lanes];
+            for (int w = 0; w < lanes; ++w) {
+                q[w] = minsum_saturate<T>(llr[w] - msg[j * lanes + w]);
+            }
+        }
+
+        d_batch_kernel(&d_lane_q[0], msg, &d_lane_l[0], deg, d_params);
+
+        for (int j = 0; j < deg; ++j) {
+            copy(&d_lane_l[j * lanes],
+                 &d_lane_l[(j + 1) * lanes],
+                 &d_lane_llr[cols[j] * lanes]);
+        }
+    }
+}
+
+template <typename T>
+void ldpc_minsum_dec<T>::lane_hard_decision(int lane,
+                                            unsigned char* out_data,
+                                            bool packed)
+{
+    constexpr int lanes = minsum_batch_lanes<T>();
+    hard_decision(&d_lane_llr[(d_n - d_k) * lanes + lane], lanes, d_k, packed, out_data);
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::check_lane_syndrome(int it,
+                                            int* nit,
+                                            unsigned char* out_data,
+                                            bool packed)
+{
+    int stride = packed ? (d_k + 7) / 8 : d_k;
+    const ldpc_layers& layers = *d_layers;
+    constexpr int lanes = minsum_batch_lanes<T>();
+    // Lanes failing any parity check are marked in d_lane_parity
+    fill(d_lane_parity.begin(), d_lane_parity.end(), 0);
+    for (size_t m = 0; m < layers.row_deg.size(); ++m) {
+        const int* cols = &layers.cols[layers.row_offset[m]];
+        char row_parity[lanes] = { 0 };
+        for (int j = 0; j < layers.row_deg[m]; ++j) {
+            const T* llr = &d_lane_llr[cols[j] * lanes];
+            for (int w = 0; w < lanes; ++w) {
+                row_parity[w] ^= (llr[w] < 0);
+            }
+        }
+        for (int w = 0; w < lanes; ++w) {
+            d_lane_parity[w] |= row_parity[w];
+        }
+    }
+
+    // Freeze the output of lanes that just converged
+    int pending = 0;
+    for (int w = 0; w < lanes; ++w) {
+        if (d_lane_done[w]) {
+            continue;
+        }
+        if (!d_lane_parity[w]) {
+            lane_hard_decision(w, &out_data[w * stride], packed);
+            nit[w] = it;
+            d_lane_done[w] = 1;
+        } else {
+            ++pending;
+        }
+    }
+    return pending;
+}
+
+template <typename T>
+void ldpc_minsum_dec<T>::decode_lanes(const float* llrs,
+                                      int nlanes,
+                                      int* nit,
+                                      unsigned char* out_data,
+                                      bool packed)
+{
+    constexpr int lanes = minsum_batch_lanes<T>();
+    int stride = packed ? (d_k + 7) / 8 : d_k;
+    load_lane_llrs(llrs, nlanes);
+    fill(d_lane_msg.begin(), d_lane_msg.end(), 0);
+    for (int w = 0; w < lanes; ++w) {
+        d_lane_done[w] = (w >= nlanes);
+    }
+
+    int it = 0;
+    while (check_lane_syndrome(it, nit, out_data, packed) > 0 && it < d_max_it) {
+        update_lane_layers();
+        ++it;
+    }
+
+    for (int w = 0; w < nlanes; ++w) {
+        if (!d_lane_done[w]) {
+            lane_hard_decision(w, &out_data[w * stride], packed);
+            nit[w] = it;
+        }
+    }
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::decode_batch(const float* llrs,
+                                     int ncws,
+                                     int* nit,
+                                     unsigned char* out_data)
+{
+    return decode_cws(llrs, ncws, nit, out_data, false);
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::decode_batch_packed(const float* llrs,
+                                            int ncws,
+                                            int* nit,
+                                            unsigned char* out_data)
+{
+    return decode_cws(llrs, ncws, nit, out_data, true);
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::decode_cws(
+    const float* llrs, int ncws, int* nit, unsigned char* out_data, bool packed)
+{
+    constexpr int lanes = minsum_batch_lanes<T>();
+    int stride = packed ? (d_k + 7) / 8 : d_k;
+    for (int first = 0; first < ncws; first += lanes) {
+        int nlanes = min(lanes, ncws - first);
+        unsigned char* out = &out_data[first * stride];
+        if (nlanes < d_min_lanes) {
+            for (int c = 0; c < nlanes; ++c) {
+                decode_cw(
+                    &llrs[(first + c) * d_n], &nit[first + c], &out[c * stride], packed);
+            }
+        } else {
+            decode_lanes(&llrs[first * d_n], nlanes, &nit[first], out, packed);
+        }
+    }
+    return ncws * d_k;
+}
+
+template <typename T>
+fec_dec::sptr ldpc_minsum_dec<T>::clone()
+{
+    return make_shared<ldpc_minsum_dec<T>>(*this);
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::get_k()
+{
+    return d_k;
+}
+
+template <typename T>
+int ldpc_minsum_dec<T>::get_n()
+{
+    return d_n;
+}
+
+template class ldpc_minsum_dec<float>;
+template class ldpc_minsum_dec<int16_t>;
+template class ldpc_minsum_dec<int8_t>;
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_LDPC_MINSUM_DEC_H
+#define INCLUDED_DTL_LDPC_MINSUM_DEC_H
+
+#include "ldpc_code.h"
+#include "ldpc_minsum_kernels.h"
+#include <gnuradio/dtl/fec.h>
+#include <string>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Layered min-sum LDPC decoder.
+ *
+ * The parity check matrix is read from the same alist files as ldpc_dec and its
+ * columns are reordered to the systematic layout produced by ldpc_enc (check bits
+ * first, then data bits), so decode() works directly on the received LLRs.
+ *
+ * T selects the LLR representation: float (normalized min-sum) or int16_t/int8_t
+ * (offset min-sum on quantized LLRs). The row layout is shared through
+ * fec_code_registry, each instance (or clone) only owns its working buffers,
+ * all allocated by the constructor.
+ *
+ * decode_batch() decodes up to minsum_batch_lanes<T>() codewords at once, one
+ * codeword per SIMD lane, as long as enough codewords fill the lanes.
+ * decode_batch_packed() packs the hard decisions straight from the LLRs.
+ */
+template <typename T>
+class ldpc_minsum_dec : public fec_dec
+{
+private:
+    int d_n;
+    int d_k;
+    int d_max_it;
+    // Shared with all decoders of the code
+    ldpc_layers::sptr d_layers;
+    std::vector<T> d_llr;
+    std::vector<T> d_msg;
+    std::vector<T> d_q;
+    std::vector<T> d_l;
+    minsum_params_t<T> d_params;
+    minsum_row_kernel_t<T> d_kernel;
+
+    // Batch (lane interleaved) decoding state
+    std::vector<T> d_lane_llr;
+    std::vector<T> d_lane_msg;
+    std::vector<T> d_lane_q;
+    std::vector<T> d_lane_l;
+    std::vector<char> d_lane_done;
+    std::vector<char> d_lane_parity;
+    minsum_batch_kernel_t<T> d_batch_kernel;
+    // Fewer codewords are cheaper to decode one by one on the padded rows
+    int d_min_lanes;
+
+    void load_llrs(const float* in_data, T* llr, int stride);
+
+    void update_layers();
+
+    bool check_syndrome();
+
+    void load_lane_llrs(const float* llrs, int nlanes);
+
+    void update_lane_layers();
+
+    int check_lane_syndrome(int it, int* nit, unsigned char* out_data, bool packed);
+
+    void lane_hard_decision(int lane, unsigned char* out_data, bool packed);
+
+    void decode_lanes(
+        const float* llrs, int nlanes, int* nit, unsigned char* out_data, bool packed);
+
+    int decode_cw(const float* in_data, int* nit, unsigned char* out_data, bool packed);
+
+    int decode_cws(
+        const float* llrs, int ncws, int* nit, unsigned char* out_data, bool packed);
+
+public:
+    ldpc_minsum_dec(const std::string& alist_fname, int max_it, float scale, float offset);
+    int decode(const float* in_data, int* nit, unsigned char* out_data) override;
+    int decode_batch(const float* llrs,
+                     int ncws,
+                     int* nit,
+                     unsigned char* out_data) override;
+    int decode_batch_packed(const float* llrs,
+                            int ncws,
+                            int* nit,
+                            unsigned char* out_data) override;
+    fec_dec::sptr clone() override;
+    int get_k() override;
+    int get_n() override;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /*INCLUDED_DTL_LDPC_MINSUM_DEC_H*/
@@ -0,0 +1,607 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ldpc_minsum_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DTL_MINSUM_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DTL_MINSUM_NEON 1
+#endif
+
+namespace gr {
+namespace dtl {
+
+namespace {
+
+template <typename T>
+inline typename minsum_traits<T>::acc_t normalize(typename minsum_traits<T>::acc_t mag,
+                                                  const minsum_params_t<T>& params)
+{
+    typename minsum_traits<T>::acc_t v = mag - params.offset;
+    return v > 0 ? v : 0;
+}
+
+template <>
+inline float normalize<float>(float mag, const minsum_params_t<float>& params)
+{
+    float v = mag * params.scale - params.offset;
+    return v > 0 ? v : 0;
+}
+
+// Merge per lane (min1, min2) pairs into the row (min1, min2)
+template <typename T, int LANES>
+inline void reduce_two_min(const T* vmin1, const T* vmin2, T& min1, T& min2)
+{
+    min1 = minsum_traits<T>::max_llr;
+    min2 = minsum_traits<T>::max_llr;
+    for (int i = 0; i < LANES; ++i) {
+        if (vmin1[i] < min1) {
+            min2 = min1;
+            min1 = vmin1[i];
+        } else if (vmin1[i] < min2) {
+            min2 = vmin1[i];
+        }
+        min2 = std::min(min2, vmin2[i]);
+    }
+}
+
+} // namespace
+
+
+template <typename T>
+void minsum_row_generic(const T* q, T* r, T* l, int n, const minsum_params_t<T>& params)
+{
+    typedef typename minsum_traits<T>::acc_t acc_t;
+
+    acc_t min1 = minsum_traits<T>::max_llr;
+    acc_t min2 = minsum_traits<T>::max_llr;
+    bool parity = false;
+    for (int i = 0; i < n; ++i) {
+        acc_t mag = std::abs(static_cast<acc_t>(q[i]));
+        if (mag < min1) {
+            min2 = min1;
+            min1 = mag;
+        } else if (mag < min2) {
+            min2 = mag;
+        }
+        parity ^= (q[i] < 0);
+    }
+    acc_t m1 = normalize<T>(min1, params);
+    acc_t m2 = normalize<T>(min2, params);
+    for (int i = 0; i < n; ++i) {
+        acc_t mag = (std::abs(static_cast<acc_t>(q[i])) == min1) ? m2 : m1;
+        acc_t msg = (parity ^ (q[i] < 0)) ? -mag : mag;
+        r[i] = msg;
+        l[i] = minsum_saturate<T>(q[i] + msg);
+    }
+}
+
+template void minsum_row_generic<float>(const float*,
+                                        float*,
+                                        float*,
+                                        int,
+                                        const minsum_params_t<float>&);
+template void minsum_row_generic<int16_t>(const int16_t*,
+                                          int16_t*,
+                                          int16_t*,
+                                          int,
+                                          const minsum_params_t<int16_t>&);
+template void minsum_row_generic<int8_t>(const int8_t*,
+                                         int8_t*,
+                                         int8_t*,
+                                         int,
+                                         const minsum_params_t<int8_t>&);
+
+
+template <typename T>
+void minsum_batch_generic(const T* q, T* r, T* l, int deg, const minsum_params_t<T>& params)
+{
+    typedef typename minsum_traits<T>::acc_t acc_t;
+    constexpr int lanes = minsum_batch_lanes<T>();
+
+    acc_t min1[lanes];
+    acc_t min2[lanes];
+    bool parity[lanes];
+    for (int w = 0; w < lanes; ++w) {
+        min1[w] = minsum_traits<T>::max_llr;
+        min2[w] = minsum_traits<T>::max_llr;
+        parity[w] = false;
+    }
+    for (int i = 0; i < deg; ++i) {
+        const T* x = &q[i * lanes];
+        for (int w = 0; w < lanes; ++w) {
+            acc_t mag = std::abs(static_cast<acc_t>(x[w]));
+            min2[w] = std::min(min2[w], std::max(min1[w], mag));
+            min1[w] = std::min(min1[w], mag);
+            parity[w] ^= (x[w] < 0);
+        }
+    }
+    acc_t m1[lanes];
+    acc_t m2[lanes];
+    for (int w = 0; w < lanes; ++w) {
+        m1[w] = normalize<T>(min1[w], params);
+        m2[w] = normalize<T>(min2[w], params);
+    }
+    for (int i = 0; i < deg; ++i) {
+        const T* x = &q[i * lanes];
+        for (int w = 0; w < lanes; ++w) {
+            acc_t mag = (std::abs(static_cast<acc_t>(x[w])) == min1[w]) ? m2[w] : m1[w];
+            acc_t msg = (parity[w] ^ (x[w] < 0)) ? -mag : mag;
+            r[i * lanes + w] = msg;
+            l[i * lanes + w] = minsum_saturate<T>(x[w] + msg);
+        }
+    }
+}
+
+template void minsum_batch_generic<float>(const float*,
+                                          float*,
+                                          float*,
+                                          int,
+                                          const minsum_params_t<float>&);
+template void minsum_batch_generic<int16_t>(const int16_t*,
+                                            int16_t*,
+                                            int16_t*,
+                                            int,
+                                            const minsum_params_t<int16_t>&);
+template void minsum_batch_generic<int8_t>(const int8_t*,
+                                           int8_t*,
+                                           int8_t*,
+                                           int,
+                                           const minsum_params_t<int8_t>&);
+
+
+#if DTL_MINSUM_X86
+
+__attribute__((target("avx2"))) static void minsum_row_avx2_f(
+    const float* q, float* r, float* l, int n, const minsum_params_t<float>& params)
+{
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    __m256 vmin1 = _mm256_set1_ps(minsum_traits<float>::max_llr);
+    __m256 vmin2 = vmin1;
+    __m256 vpar = _mm256_setzero_ps();
+    for (int i = 0; i < n; i += 8) {
+        __m256 x = _mm256_loadu_ps(q + i);
+        __m256 a = _mm256_andnot_ps(sign_mask, x);
+        vmin2 = _mm256_min_ps(vmin2, _mm256_max_ps(vmin1, a));
+        vmin1 = _mm256_min_ps(vmin1, a);
+        vpar = _mm256_xor_ps(vpar, x);
+    }
+
+    alignas(32) float min1_lanes[8];
+    alignas(32) float min2_lanes[8];
+    _mm256_store_ps(min1_lanes, vmin1);
+    _mm256_store_ps(min2_lanes, vmin2);
+    float min1, min2;
+    reduce_two_min<float, 8>(min1_lanes, min2_lanes, min1, min2);
+    int parity = _mm256_movemask_ps(vpar);
+    parity = __builtin_parity(parity);
+
+    const __m256 vmin = _mm256_set1_ps(min1);
+    const __m256 vm1 = _mm256_set1_ps(normalize<float>(min1, params));
+    const __m256 vm2 = _mm256_set1_ps(normalize<float>(min2, params));
+    const __m256 vsign = parity ? sign_mask : _mm256_setzero_ps();
+    for (int i = 0; i < n; i += 8) {
+        __m256 x = _mm256_loadu_ps(q + i);
+        __m256 a = _mm256_andnot_ps(sign_mask, x);
+        __m256 mag = _mm256_blendv_ps(vm1, vm2, _mm256_cmp_ps(a, vmin, _CMP_EQ_OQ));
+        __m256 msg = _mm256_or_ps(mag, _mm256_and_ps(_mm256_xor_ps(x, vsign), sign_mask));
+        _mm256_storeu_ps(r + i, msg);
+        _mm256_storeu_ps(l + i, _mm256_add_ps(x, msg));
+    }
+}
+
+__attribute__((target("avx2"))) static void minsum_row_avx2_s16(
+    const int16_t* q, int16_t* r, int16_t* l, int n, const minsum_params_t<int16_t>& params)
+{
+    const __m256i vmax = _mm256_set1_epi16(minsum_traits<int16_t>::max_llr);
+    const __m256i vmax_neg = _mm256_set1_epi16(-minsum_traits<int16_t>::max_llr);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmin1 = vmax;
+    __m256i vmin2 = vmax;
+    __m256i vpar = zero;
+    for (int i = 0; i < n; i += 16) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i));
+        __m256i a = _mm256_abs_epi16(x);
+        vmin2 = _mm256_min_epi16(vmin2, _mm256_max_epi16(vmin1, a));
+        vmin1 = _mm256_min_epi16(vmin1, a);
+        vpar = _mm256_xor_si256(vpar, x);
+    }
+
+    alignas(32) int16_t min1_lanes[16];
+    alignas(32) int16_t min2_lanes[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(min1_lanes), vmin1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(min2_lanes), vmin2);
+    int16_t min1, min2;
+    reduce_two_min<int16_t, 16>(min1_lanes, min2_lanes, min1, min2);
+    // Two movemask bits per 16-bit lane, keep the sign (high) byte only
+    int parity = __builtin_parity(_mm256_movemask_epi8(vpar) & 0xAAAAAAAA);
+
+    const __m256i vmin = _mm256_set1_epi16(min1);
+    const __m256i vm1 = _mm256_set1_epi16(normalize<int16_t>(min1, params));
+    const __m256i vm2 = _mm256_set1_epi16(normalize<int16_t>(min2, params));
+    const __m256i vsign = _mm256_set1_epi16(parity ? -1 : 0);
+    for (int i = 0; i < n; i += 16) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i));
+        __m256i a = _mm256_abs_epi16(x);
+        __m256i mag = _mm256_blendv_epi8(vm1, vm2, _mm256_cmpeq_epi16(a, vmin));
+        __m256i neg = _mm256_cmpgt_epi16(zero, _mm256_xor_si256(x, vsign));
+        __m256i msg = _mm256_sub_epi16(_mm256_xor_si256(mag, neg), neg);
+        __m256i sum = _mm256_adds_epi16(x, msg);
+        sum = _mm256_max_epi16(_mm256_min_epi16(sum, vmax), vmax_neg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), msg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(l + i), sum);
+    }
+}
+
+__attribute__((target("avx2"))) static void minsum_row_avx2_s8(
+    const int8_t* q, int8_t* r, int8_t* l, int n, const minsum_params_t<int8_t>& params)
+{
+    const __m256i vmax = _mm256_set1_epi8(minsum_traits<int8_t>::max_llr);
+    const __m256i vmax_neg = _mm256_set1_epi8(-minsum_traits<int8_t>::max_llr);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmin1 = vmax;
+    __m256i vmin2 = vmax;
+    __m256i vpar = zero;
+    for (int i = 0; i < n; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i));
+        __m256i a = _mm256_abs_epi8(x);
+        vmin2 = _mm256_min_epi8(vmin2, _mm256_max_epi8(vmin1, a));
+        vmin1 = _mm256_min_epi8(vmin1, a);
+        vpar = _mm256_xor_si256(vpar, x);
+    }
+
+    alignas(32) int8_t min1_lanes[32];
+    alignas(32) int8_t min2_lanes[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(min1_lanes), vmin1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(min2_lanes), vmin2);
+    int8_t min1, min2;
+    reduce_two_min<int8_t, 32>(min1_lanes, min2_lanes, min1, min2);
+    int parity = __builtin_parity(static_cast<unsigned>(_mm256_movemask_epi8(vpar)));
+
+    const __m256i vmin = _mm256_set1_epi8(min1);
+    const __m256i vm1 = _mm256_set1_epi8(normalize<int8_t>(min1, params));
+    const __m256i vm2 = _mm256_set1_epi8(normalize<int8_t>(min2, params));
+    const __m256i vsign = _mm256_set1_epi8(parity ? -1 : 0);
+    for (int i = 0; i < n; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + i));
+        __m256i a = _mm256_abs_epi8(x);
+        __m256i mag = _mm256_blendv_epi8(vm1, vm2, _mm256_cmpeq_epi8(a, vmin));
+        __m256i neg = _mm256_cmpgt_epi8(zero, _mm256_xor_si256(x, vsign));
+        __m256i msg = _mm256_sub_epi8(_mm256_xor_si256(mag, neg), neg);
+        __m256i sum = _mm256_adds_epi8(x, msg);
+        sum = _mm256_max_epi8(_mm256_min_epi8(sum, vmax), vmax_neg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), msg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(l + i), sum);
+    }
+}
+
+__attribute__((target("avx2"))) static void minsum_batch_avx2_f(
+    const float* q, float* r, float* l, int deg, const minsum_params_t<float>& params)
+{
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 vmin1 = _mm256_set1_ps(minsum_traits<float>::max_llr);
+    __m256 vmin2 = vmin1;
+    __m256 vpar = zero;
+    for (int i = 0; i < deg; ++i) {
+        __m256 x = _mm256_loadu_ps(q + 8 * i);
+        __m256 a = _mm256_andnot_ps(sign_mask, x);
+        vmin2 = _mm256_min_ps(vmin2, _mm256_max_ps(vmin1, a));
+        vmin1 = _mm256_min_ps(vmin1, a);
+        vpar = _mm256_xor_ps(vpar, x);
+    }
+
+    const __m256 vscale = _mm256_set1_ps(params.scale);
+    const __m256 voffset = _mm256_set1_ps(params.offset);
+    const __m256 vm1 =
+        _mm256_max_ps(_mm256_sub_ps(_mm256_mul_ps(vmin1, vscale), voffset), zero);
+    const __m256 vm2 =
+        _mm256_max_ps(_mm256_sub_ps(_mm256_mul_ps(vmin2, vscale), voffset), zero);
+    for (int i = 0; i < deg; ++i) {
+        __m256 x = _mm256_loadu_ps(q + 8 * i);
+        __m256 a = _mm256_andnot_ps(sign_mask, x);
+        __m256 mag = _mm256_blendv_ps(vm1, vm2, _mm256_cmp_ps(a, vmin1, _CMP_EQ_OQ));
+        __m256 msg = _mm256_or_ps(mag, _mm256_and_ps(_mm256_xor_ps(x, vpar), sign_mask));
+        _mm256_storeu_ps(r + 8 * i, msg);
+        _mm256_storeu_ps(l + 8 * i, _mm256_add_ps(x, msg));
+    }
+}
+
+__attribute__((target("avx2"))) static void minsum_batch_avx2_s16(
+    const int16_t* q, int16_t* r, int16_t* l, int deg, const minsum_params_t<int16_t>& params)
+{
+    const __m256i vmax = _mm256_set1_epi16(minsum_traits<int16_t>::max_llr);
+    const __m256i vmax_neg = _mm256_set1_epi16(-minsum_traits<int16_t>::max_llr);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmin1 = vmax;
+    __m256i vmin2 = vmax;
+    __m256i vpar = zero;
+    for (int i = 0; i < deg; ++i) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + 16 * i));
+        __m256i a = _mm256_abs_epi16(x);
+        vmin2 = _mm256_min_epi16(vmin2, _mm256_max_epi16(vmin1, a));
+        vmin1 = _mm256_min_epi16(vmin1, a);
+        vpar = _mm256_xor_si256(vpar, x);
+    }
+
+    const __m256i voffset = _mm256_set1_epi16(params.offset);
+    const __m256i vm1 = _mm256_subs_epu16(vmin1, voffset);
+    const __m256i vm2 = _mm256_subs_epu16(vmin2, voffset);
+    for (int i = 0; i < deg; ++i) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + 16 * i));
+        __m256i a = _mm256_abs_epi16(x);
+        __m256i mag = _mm256_blendv_epi8(vm1, vm2, _mm256_cmpeq_epi16(a, vmin1));
+        __m256i neg = _mm256_cmpgt_epi16(zero, _mm256_xor_si256(x, vpar));
+        __m256i msg = _mm256_sub_epi16(_mm256_xor_si256(mag, neg), neg);
+        __m256i sum = _mm256_adds_epi16(x, msg);
+        sum = _mm256_max_epi16(_mm256_min_epi16(sum, vmax), vmax_neg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 16 * i), msg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(l + 16 * i), sum);
+    }
+}
+
+__attribute__((target("avx2"))) static void minsum_batch_avx2_s8(
+    const int8_t* q, int8_t* r, int8_t* l, int deg, const minsum_params_t<int8_t>& params)
+{
+    const __m256i vmax = _mm256_set1_epi8(minsum_traits<int8_t>::max_llr);
+    const __m256i vmax_neg = _mm256_set1_epi8(-minsum_traits<int8_t>::max_llr);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmin1 = vmax;
+    __m256i vmin2 = vmax;
+    __m256i vpar = zero;
+    for (int i = 0; i < deg; ++i) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + 32 * i));
+        __m256i a = _mm256_abs_epi8(x);
+        vmin2 = _mm256_min_epi8(vmin2, _mm256_max_epi8(vmin1, a));
+        vmin1 = _mm256_min_epi8(vmin1, a);
+        vpar = _mm256_xor_si256(vpar, x);
+    }
+
+    const __m256i voffset = _mm256_set1_epi8(params.offset);
+    const __m256i vm1 = _mm256_subs_epu8(vmin1, voffset);
+    const __m256i vm2 = _mm256_subs_epu8(vmin2, voffset);
+    for (int i = 0; i < deg; ++i) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + 32 * i));
+        __m256i a = _mm256_abs_epi8(x);
+        __m256i mag = _mm256_blendv_epi8(vm1, vm2, _mm256_cmpeq_epi8(a, vmin1));
+        __m256i neg = _mm256_cmpgt_epi8(zero, _mm256_xor_si256(x, vpar));
+        __m256i msg = _mm256_sub_epi8(_mm256_xor_si256(mag, neg), neg);
+        __m256i sum = _mm256_adds_epi8(x, msg);
+        sum = _mm256_max_epi8(_mm256_min_epi8(sum, vmax), vmax_neg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 32 * i), msg);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(l + 32 * i), sum);
+    }
+}
+
+static bool cpu_has_avx2()
+{
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+#endif // DTL_MINSUM_X86
+
+
+#if DTL_MINSUM_NEON
+
+static void minsum_row_neon_f(
+    const float* q, float* r, float* l, int n, const minsum_params_t<float>& params)
+{
+    const uint32x4_t sign_mask = vdupq_n_u32(0x80000000);
+    float32x4_t vmin1 = vdupq_n_f32(minsum_traits<float>::max_llr);
+    float32x4_t vmin2 = vmin1;
+    uint32x4_t vpar = vdupq_n_u32(0);
+    for (int i = 0; i < n; i += 4) {
+        float32x4_t x = vld1q_f32(q + i);
+        float32x4_t a = vabsq_f32(x);
+        vmin2 = vminq_f32(vmin2, vmaxq_f32(vmin1, a));
+        vmin1 = vminq_f32(vmin1, a);
+        vpar = veorq_u32(vpar, vreinterpretq_u32_f32(x));
+    }
+
+    float min1_lanes[4];
+    float min2_lanes[4];
+    uint32_t par_lanes[4];
+    vst1q_f32(min1_lanes, vmin1);
+    vst1q_f32(min2_lanes, vmin2);
+    vst1q_u32(par_lanes, vpar);
+    float min1, min2;
+    reduce_two_min<float, 4>(min1_lanes, min2_lanes, min1, min2);
+    uint32_t parity = (par_lanes[0] ^ par_lanes[1] ^ par_lanes[2] ^ par_lanes[3]) >> 31;
+
+    const float32x4_t vmin = vdupq_n_f32(min1);
+    const float32x4_t vm1 = vdupq_n_f32(normalize<float>(min1, params));
+    const float32x4_t vm2 = vdupq_n_f32(normalize<float>(min2, params));
+    const uint32x4_t vsign = vdupq_n_u32(parity ? 0x80000000 : 0);
+    for (int i = 0; i < n; i += 4) {
+        float32x4_t x = vld1q_f32(q + i);
+        float32x4_t mag = vbslq_f32(vceqq_f32(vabsq_f32(x), vmin), vm2, vm1);
+        uint32x4_t sign =
+            vandq_u32(veorq_u32(vreinterpretq_u32_f32(x), vsign), sign_mask);
+        float32x4_t msg =
+            vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(mag), sign));
+        vst1q_f32(r + i, msg);
+        vst1q_f32(l + i, vaddq_f32(x, msg));
+    }
+}
+
+static void minsum_row_neon_s16(
+    const int16_t* q, int16_t* r, int16_t* l, int n, const minsum_params_t<int16_t>& params)
+{
+    const int16x8_t vmax = vdupq_n_s16(minsum_traits<int16_t>::max_llr);
+    const int16x8_t vmax_neg = vdupq_n_s16(-minsum_traits<int16_t>::max_llr);
+    int16x8_t vmin1 = vmax;
+    int16x8_t vmin2 = vmax;
+    int16x8_t vpar = vdupq_n_s16(0);
+    for (int i = 0; i < n; i += 8) {
+        int16x8_t x = vld1q_s16(q + i);
+        int16x8_t a = vqabsq_s16(x);
+        vmin2 = vminq_s16(vmin2, vmaxq_s16(vmin1, a));
+        vmin1 = vminq_s16(vmin1, a);
+        vpar = veorq_s16(vpar, x);
+    }
+
+    int16_t min1_lanes[8];
+    int16_t min2_lanes[8];
+    int16_t par_lanes[8];
+    vst1q_s16(min1_lanes, vmin1);
+    vst1q_s16(min2_lanes, vmin2);
+    vst1q_s16(par_lanes, vpar);
+    int16_t min1, min2;
+    reduce_two_min<int16_t, 8>(min1_lanes, min2_lanes, min1, min2);
+    int16_t par_acc = 0;
+    for (auto p : par_lanes) {
+        par_acc ^= p;
+    }
+    bool parity = par_acc < 0;
+
+    const int16x8_t vmin = vdupq_n_s16(min1);
+    const int16x8_t vm1 = vdupq_n_s16(normalize<int16_t>(min1, params));
+    const int16x8_t vm2 = vdupq_n_s16(normalize<int16_t>(min2, params));
+    const int16x8_t vsign = vdupq_n_s16(parity ? -1 : 0);
+    for (int i = 0; i < n; i += 8) {
+        int16x8_t x = vld1q_s16(q + i);
+        int16x8_t mag = vbslq_s16(vceqq_s16(vqabsq_s16(x), vmin), vm2, vm1);
+        uint16x8_t neg = vcltzq_s16(veorq_s16(x, vsign));
+        int16x8_t msg = vbslq_s16(neg, vnegq_s16(mag), mag);
+        int16x8_t sum = vmaxq_s16(vminq_s16(vqaddq_s16(x, msg), vmax), vmax_neg);
+        vst1q_s16(r + i, msg);
+        vst1q_s16(l + i, sum);
+    }
+}
+
+static void minsum_row_neon_s8(
+    const int8_t* q, int8_t* r, int8_t* l, int n, const minsum_params_t<int8_t>& params)
+{
+    const int8x16_t vmax = vdupq_n_s8(minsum_traits<int8_t>::max_llr);
+    const int8x16_t vmax_neg = vdupq_n_s8(-minsum_traits<int8_t>::max_llr);
+    int8x16_t vmin1 = vmax;
+    int8x16_t vmin2 = vmax;
+    int8x16_t vpar = vdupq_n_s8(0);
+    for (int i = 0; i < n; i += 16) {
+        int8x16_t x = vld1q_s8(q + i);
+        int8x16_t a = vqabsq_s8(x);
+        vmin2 = vminq_s8(vmin2, vmaxq_s8(vmin1, a));
+        vmin1 = vminq_s8(vmin1, a);
+        vpar = veorq_s8(vpar, x);
+    }
+
+    int8_t min1_lanes[16];
+    int8_t min2_lanes[16];
+    int8_t par_lanes[16];
+    vst1q_s8(min1_lanes, vmin1);
+    vst1q_s8(min2_lanes, vmin2);
+    vst1q_s8(par_lanes, vpar);
+    int8_t min1, min2;
+    reduce_two_min<int8_t, 16>(min1_lanes, min2_lanes, min1, min2);
+    int8_t par_acc = 0;
+    for (auto p : par_lanes) {
+        par_acc ^= p;
+    }
+    bool parity = par_acc < 0;
+
+    const int8x16_t vmin = vdupq_n_s8(min1);
+    const int8x16_t vm1 = vdupq_n_s8(normalize<int8_t>(min1, params));
+    const int8x16_t vm2 = vdupq_n_s8(normalize<int8_t>(min2, params));
+    const int8x16_t vsign = vdupq_n_s8(parity ? -1 : 0);
+    for (int i = 0; i < n; i += 16) {
+        int8x16_t x = vld1q_s8(q + i);
+        int8x16_t mag = vbslq_s8(vceqq_s8(vqabsq_s8(x), vmin), vm2, vm1);
+        uint8x16_t neg = vcltzq_s8(veorq_s8(x, vsign));
+        int8x16_t msg = vbslq_s8(neg, vnegq_s8(mag), mag);
+        int8x16_t sum = vmaxq_s8(vminq_s8(vqaddq_s8(x, msg), vmax), vmax_neg);
+        vst1q_s8(r + i, msg);
+        vst1q_s8(l + i, sum);
+    }
+}
+
+#endif // DTL_MINSUM_NEON
+
+
+template <>
+minsum_row_kernel_t<float> get_minsum_row_kernel<float>()
+{
+#if DTL_MINSUM_X86
+    if (cpu_has_avx2()) {
+        return minsum_row_avx2_f;
+    }
+#elif DTL_MINSUM_NEON
+    return minsum_row_neon_f;
+#endif
+    return minsum_row_generic<float>;
+}
+
+template <>
+minsum_row_kernel_t<int16_t> get_minsum_row_kernel<int16_t>()
+{
+#if DTL_MINSUM_X86
+    if (cpu_has_avx2()) {
+        return minsum_row_avx2_s16;
+    }
+#elif DTL_MINSUM_NEON
+    return minsum_row_neon_s16;
+#endif
+    return minsum_row_generic<int16_t>;
+}
+
+template <>
+minsum_row_kernel_t<int8_t> get_minsum_row_kernel<int8_t>()
+{
+#if DTL_MINSUM_X86
+    if (cpu_has_avx2()) {
+        return minsum_row_avx2_s8;
+    }
+#elif DTL_MINSUM_NEON
+    return minsum_row_neon_s8;
+#endif
+    return minsum_row_generic<int8_t>;
+}
+
+
+// The generic batch kernel only has fixed length lane loops, these are
+// auto-vectorized where no explicit kernel exists (e.g. NEON).
+template <>
+minsum_batch_kernel_t<float> get_minsum_batch_kernel<float>()
+{
+#if DTL_MINSUM_X86
+    if (cpu_has_avx2()) {
+        return minsum_batch_avx2_f;
+    }
+#endif
+    return minsum_batch_generic<float>;
+}
+
+template <>
+minsum_batch_kernel_t<int16_t> get_minsum_batch_kernel<int16_t>()
+{
+#if DTL_MINSUM_X86
+    if (cpu_has_avx2()) {
+        return minsum_batch_avx2_s16;
+    }
+#endif
+    return minsum_batch_generic<int16_t>;
+}
+
+template <>
+minsum_batch_kernel_t<int8_t> get_minsum_batch_kernel<int8_t>()
+{
+#if DTL_MINSUM_X86
+    if (cpu_has_avx2()) {
+        return minsum_batch_avx2_s8;
+    }
+#endif
+    return minsum_batch_generic<int8_t>;
+}
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,133 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_LDPC_MINSUM_KERNELS_H
+#define INCLUDED_DTL_LDPC_MINSUM_KERNELS_H
+
+#include <cstdint>
+
+namespace gr {
+namespace dtl {
+
+// Check node rows are processed in chunks padded to this many values so that
+// every SIMD kernel (up to 32 x int8 lanes) runs without a tail loop.
+static constexpr int MINSUM_ROW_ALIGN = 32;
+
+/*
+ * max_llr bounds the messages and posterior LLRs. The quantized decoders load
+ * the channel LLRs, in natural units, at chan_scale levels per unit, clipped to
+ * chan_max, and the shortened bits at the shortened level.
+ */
+template <typename T>
+struct minsum_traits;
+
+template <>
+struct minsum_traits<float> {
+    typedef float acc_t;
+    static constexpr float max_llr = 1e30f;
+    static constexpr float chan_max = 1e30f;
+    static constexpr float chan_scale = 1;
+    static constexpr float shortened = 1e30f;
+};
+
+template <>
+struct minsum_traits<int16_t> {
+    typedef int acc_t;
+    static constexpr int16_t max_llr = 32767;
+    static constexpr int16_t chan_max = 4095;
+    static constexpr int16_t chan_scale = 2;
+    static constexpr int16_t shortened = 24;
+};
+
+template <>
+struct minsum_traits<int8_t> {
+    typedef int acc_t;
+    static constexpr int8_t max_llr = 127;
+    static constexpr int8_t chan_max = 63;
+    static constexpr int8_t chan_scale = 2;
+    static constexpr int8_t shortened = 24;
+};
+
+template <typename T>
+inline T minsum_saturate(typename minsum_traits<T>::acc_t v)
+{
+    if (v > minsum_traits<T>::max_llr) {
+        return minsum_traits<T>::max_llr;
+    } else if (v < -minsum_traits<T>::max_llr) {
+        return -minsum_traits<T>::max_llr;
+    }
+    return v;
+}
+
+template <>
+inline float minsum_saturate<float>(float v)
+{
+    return v;
+}
+
+template <typename T>
+struct minsum_params_t {
+    // Normalization factor (float LLRs only)
+    float scale;
+    // Offset subtracted from the check node magnitude
+    T offset;
+};
+
+/*!
+ * Check node update of one layer.
+ *
+ * q: variable-to-check messages of the row, n values (n multiple of
+ *    MINSUM_ROW_ALIGN, padding set to minsum_traits<T>::max_llr)
+ * r: updated check-to-variable messages (out)
+ * l: updated posterior LLRs q + r (out)
+ */
+template <typename T>
+using minsum_row_kernel_t = void (*)(const T* q,
+                                     T* r,
+                                     T* l,
+                                     int n,
+                                     const minsum_params_t<T>& params);
+
+/*!
+ * Check node update of one layer for a batch of codewords, one codeword per
+ * SIMD lane (minsum_batch_lanes<T>() lanes, i.e. one 256 bit vector).
+ *
+ * q, r, l: deg x lanes values, lane index varies fastest. Same semantics as
+ *          minsum_row_kernel_t.
+ */
+template <typename T>
+using minsum_batch_kernel_t = void (*)(const T* q,
+                                       T* r,
+                                       T* l,
+                                       int deg,
+                                       const minsum_params_t<T>& params);
+
+template <typename T>
+constexpr int minsum_batch_lanes()
+{
+    return 32 / sizeof(T);
+}
+
+// Select the fastest row kernel supported by the running CPU
+template <typename T>
+minsum_row_kernel_t<T> get_minsum_row_kernel();
+
+template <typename T>
+minsum_batch_kernel_t<T> get_minsum_batch_kernel();
+
+template <typename T>
+void minsum_row_generic(
+    const T* q, T* r, T* l, int n, const minsum_params_t<T>& params);
+
+template <typename T>
+void minsum_batch_generic(
+    const T* q, T* r, T* l, int deg, const minsum_params_t<T>& params);
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_LDPC_MINSUM_KERNELS_H */
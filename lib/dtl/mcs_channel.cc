@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/dtl/mcs_channel.h>
+#include <chrono>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+mcs_channel::sptr mcs_channel::make() { return make_shared<mcs_channel>(); }
+
+mcs_channel::mcs_channel()
+    : d_seq(0),
+      d_constellation(static_cast<int>(constellation_type_t::UNKNOWN)),
+      d_fec_idx(0),
+      d_snr(0),
+      d_timestamp(0)
+{
+}
+
+void mcs_channel::publish(constellation_type_t constellation, int fec_idx, float snr)
+{
+    int64_t now = chrono::duration_cast<chrono::nanoseconds>(
+                      chrono::steady_clock::now().time_since_epoch())
+                      .count();
+
+    uint64_t seq = d_seq.load(memory_order_relaxed);
+    d_seq.store(seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    d_constellation.store(static_cast<int>(constellation), memory_order_relaxed);
+    d_fec_idx.store(fec_idx, memory_order_relaxed);
+    d_snr.store(snr, memory_order_relaxed);
+    d_timestamp.store(now, memory_order_relaxed);
+
+    d_seq.store(seq + 2, memory_order_release);
+}
+
+bool mcs_channel::read(mcs_t& mcs, uint64_t& seq) const
+{
+    while (true) {
+        uint64_t begin = d_seq.load(memory_order_acquire);
+        if (begin == 2 * seq) {
+            return false;
+        }
+        if (begin & 1) {
+            continue;
+        }
+
+        mcs_t m;
+        m.constellation =
+            static_cast<constellation_type_t>(d_constellation.load(memory_order_relaxed));
+        m.fec_idx = d_fec_idx.load(memory_order_relaxed);
+        m.snr = d_snr.load(memory_order_relaxed);
+        m.timestamp = d_timestamp.load(memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (d_seq.load(memory_order_relaxed) == begin) {
+            mcs = m;
+            seq = begin / 2;
+            return true;
+        }
+    }
+}
+
+uint64_t mcs_channel::version() const { return d_seq.load(memory_order_acquire) / 2; }
+
+} // namespace dtl
+} // namespace gr
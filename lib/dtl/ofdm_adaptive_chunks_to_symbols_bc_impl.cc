@@ -49,7 +49,11 @@ ofdm_adaptive_chunks_to_symbols_bc_impl::ofdm_adaptive_chunks_to_symbols_bc_impl
         if (constellation == nullptr) {
             throw std::invalid_argument("Unknown constellation");
         }
-        d_constellations[constellation_type] = constellation;
+        size_t idx = static_cast<size_t>(constellation_type);
+        if (idx >= d_mappers.size()) {
+            d_mappers.resize(idx + 1);
+        }
+        d_mappers[idx] = std::make_unique<symbol_mapper>(constellation);
     }
 }
 
@@ -63,20 +67,18 @@ int ofdm_adaptive_chunks_to_symbols_bc_impl::work(int noutput_items,
 {
     auto in = static_cast<const input_type*>(input_items[0]);
     auto out = static_cast<output_type*>(output_items[0]);
-    std::vector<tag_t> tags;
     this->get_tags_in_range(
-        tags, 0, this->nitems_read(0), this->nitems_read(0) + 1);
-    constellation_type_t constellation_type = find_constellation_type(tags);
+        d_tags, 0, this->nitems_read(0), this->nitems_read(0) + 1);
+    constellation_type_t constellation_type = find_constellation_type(d_tags);
     if (constellation_type_t::UNKNOWN == constellation_type) {
         throw std::invalid_argument("Constellation not found");
     }
     DTL_LOG_DEBUG("size:{}, constellation: {}, noutput_items: {}", ninput_items[0], (int)constellation_type, noutput_items);
-    constellation_sptr constellation = d_constellations[constellation_type];
-    for (int i = 0; i < ninput_items[0]; ++i) {
-        constellation->map_to_points(*in, out);
-        ++in;
-        ++out;
+    size_t idx = static_cast<size_t>(constellation_type);
+    if (idx >= d_mappers.size() || !d_mappers[idx]) {
+        throw std::invalid_argument("Unknown constellation");
     }
+    d_mappers[idx]->map(in, ninput_items[0], out);
     return ninput_items[0];
 }
 
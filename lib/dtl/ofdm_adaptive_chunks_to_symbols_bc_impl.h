@@ -8,7 +8,10 @@
 #ifndef INCLUDED_DTL_OFDM_ADAPTIVE_CHUNKS_TO_SYMBOLS_BC_IMPL_H
 #define INCLUDED_DTL_OFDM_ADAPTIVE_CHUNKS_TO_SYMBOLS_BC_IMPL_H
 
+#include "symbol_mapper.h"
 #include <gnuradio/dtl/ofdm_adaptive_chunks_to_symbols_bc.h>
+#include <memory>
+#include <vector>
 
 namespace gr {
 namespace dtl {
@@ -16,7 +19,9 @@ namespace dtl {
 class ofdm_adaptive_chunks_to_symbols_bc_impl : public ofdm_adaptive_chunks_to_symbols_bc
 {
 private:
-    constellation_dictionary_t d_constellations;
+    // Mapper of each known constellation, indexed by constellation_type_t
+    std::vector<std::unique_ptr<symbol_mapper>> d_mappers;
+    std::vector<tag_t> d_tags;
 
 public:
     ofdm_adaptive_chunks_to_symbols_bc_impl(
@@ -20,10 +20,14 @@ INIT_DTL_LOGGER("ofdm_adaptive_constellation_soft_cf");
 
 
 ofdm_adaptive_constellation_soft_cf::sptr ofdm_adaptive_constellation_soft_cf::make(
-    const std::vector<constellation_type_t>& constellations, const std::string& len_key)
+    const std::vector<constellation_type_t>& constellations,
+    const std::string& len_key,
+    int fft_len,
+    const std::vector<std::vector<int>>& occupied_carriers,
+    int symbols_skipped)
 {
     return gnuradio::make_block_sptr<ofdm_adaptive_constellation_soft_cf_impl>(
-        constellations, len_key);
+        constellations, len_key, fft_len, occupied_carriers, symbols_skipped);
 }
 
 
@@ -31,7 +35,11 @@ ofdm_adaptive_constellation_soft_cf::sptr ofdm_adaptive_constellation_soft_cf::m
  * The private constructor
  */
 ofdm_adaptive_constellation_soft_cf_impl::ofdm_adaptive_constellation_soft_cf_impl(
-    const std::vector<constellation_type_t>& constellations, const std::string& len_key)
+    const std::vector<constellation_type_t>& constellations,
+    const std::string& len_key,
+    int fft_len,
+    const std::vector<std::vector<int>>& occupied_carriers,
+    int symbols_skipped)
     : gr::block(
           "ofdm_adaptive_constellation_soft_cf",
           gr::io_signature::make(
@@ -46,7 +54,22 @@ ofdm_adaptive_constellation_soft_cf_impl::ofdm_adaptive_constellation_soft_cf_im
         if (constellation == nullptr) {
             throw std::invalid_argument("Unknown constellation");
         }
-        d_constellations[constellation_type] = constellation;
+        d_demappers.emplace(constellation_type, soft_demapper(constellation));
+    }
+
+    // Carriers in the order of ofdm_serializer_vcc (shifted input), starting with
+    // the carrier set of the first payload symbol
+    if (fft_len > 0) {
+        for (size_t i = 0; i < occupied_carriers.size(); i++) {
+            const auto& carriers =
+                occupied_carriers[(symbols_skipped + i) % occupied_carriers.size()];
+            for (int carr : carriers) {
+                if (carr < 0) {
+                    carr += fft_len;
+                }
+                d_carriers.push_back((carr + fft_len / 2) % fft_len);
+            }
+        }
     }
     set_max_noutput_items(65536);
     set_tag_propagation_policy(tag_propagation_policy_t::TPP_DONT);
@@ -86,7 +109,9 @@ int ofdm_adaptive_constellation_soft_cf_impl::general_work(
                                 this->nitems_read(0) + read_index,
                                 this->nitems_read(0) + read_index + 1);
         int test = 0;
-        double sigma = 0.001;
+        // Noise power calc_soft_dec got before a noise tag, as in former releases
+        float noise = 0.001;
+        pmt::pmt_t carrier_snr = pmt::PMT_NIL;
         for (auto& tag : tags) {
             DTL_LOG_DEBUG("offset={}, key={}", tag.offset, pmt::symbol_to_string(tag.key));
             if (tag.key == get_constellation_tag_key()) {
@@ -97,12 +122,10 @@ int ofdm_adaptive_constellation_soft_cf_impl::general_work(
                 test |= 2;
                 //remove_item_tag(0, tag);
             } else if (tag.key == noise_tag_key()) {
-                double noise = pmt::to_double(tag.value);
-                sigma = sqrt(noise);
+                noise = pmt::to_double(tag.value);
                 test |= 4;
-            }
-            if (test == 7) {
-                break;
+            } else if (tag.key == carrier_snr_tag_key()) {
+                carrier_snr = tag.value;
             }
         }
         if (test != 7 && test != 3) {
@@ -110,15 +133,19 @@ int ofdm_adaptive_constellation_soft_cf_impl::general_work(
             throw std::runtime_error("Tags missing");
         }
 
-        d_constellation = d_constellations[cnst];
-        int bps = d_constellation->bits_per_symbol();
+        auto it_demapper = d_demappers.find(cnst);
+        if (it_demapper == d_demappers.end()) {
+            throw std::runtime_error("Unknown constellation");
+        }
+        const soft_demapper& demapper = it_demapper->second;
+        int bps = demapper.bits_per_symbol();
 
         DTL_LOG_DEBUG("len_key={}, val={}, offset={}", pmt::symbol_to_string(d_len_key), len * bps, nitems_written(0) + write_index);
 
         set_relative_rate(bps, 1);
         set_output_multiple(len * bps);
 
-        DTL_LOG_DEBUG("work: ninput={}, noutput={}, cnst={}, len={}, bps={}, sigma={}", ninput_items[0], noutput_items, (int)cnst, len, bps, sigma);
+        DTL_LOG_DEBUG("work: ninput={}, noutput={}, cnst={}, len={}, bps={}, noise={}", ninput_items[0], noutput_items, (int)cnst, len, bps, noise);
 
         if (read_index + len > ninput_items[0]) {
             break;
@@ -140,12 +167,21 @@ int ofdm_adaptive_constellation_soft_cf_impl::general_work(
             }
         }
 
-        for (int i=0; i < len; ++i, ++read_index, write_index += bps) {
-            std::vector<float> llrs(d_constellation->calc_soft_dec(in[read_index], sigma));
-            // TODO: Use MSB order to avoid reversing here
-            std::reverse(llrs.begin(), llrs.end());
-            memcpy(&out[write_index], &llrs[0], sizeof(float) * llrs.size());
+        if (!d_carriers.empty() && pmt::is_f32vector(carrier_snr)) {
+            size_t fft_len = 0;
+            const float* snr = pmt::f32vector_elements(carrier_snr, fft_len);
+            d_symbol_snr.resize(len);
+            for (int i = 0, j = 0; i < len; i++) {
+                int k = d_carriers[j];
+                d_symbol_snr[i] = k < (int)fft_len ? snr[k] : 1.0f / noise;
+                j = j + 1 < (int)d_carriers.size() ? j + 1 : 0;
+            }
+            demapper.demap(&in[read_index], len, d_symbol_snr.data(), &out[write_index]);
+        } else {
+            demapper.demap(&in[read_index], len, noise, &out[write_index]);
         }
+        read_index += len;
+        write_index += len * bps;
         d_tag_offset += len * bps;
     }
 
@@ -8,8 +8,9 @@
 #ifndef INCLUDED_DTL_OFDM_ADAPTIVE_CONSTELLATION_SOFT_CF_IMPL_H
 #define INCLUDED_DTL_OFDM_ADAPTIVE_CONSTELLATION_SOFT_CF_IMPL_H
 
+#include "soft_demapper.h"
 #include <gnuradio/dtl/ofdm_adaptive_constellation_soft_cf.h>
-#include <gnuradio/digital/constellation.h>
+#include <map>
 
 
 namespace gr {
@@ -19,13 +20,20 @@ class ofdm_adaptive_constellation_soft_cf_impl
     : public ofdm_adaptive_constellation_soft_cf
 {
 private:
-    constellation_dictionary_t d_constellations;
+    std::map<constellation_type_t, soft_demapper> d_demappers;
     pmt::pmt_t d_len_key;
     uint64_t d_tag_offset;
-    digital::constellation_sptr d_constellation;
+    // Carrier of each serialized symbol over a cycle of the carrier sets
+    std::vector<int> d_carriers;
+    std::vector<float> d_symbol_snr;
 
 public:
-    ofdm_adaptive_constellation_soft_cf_impl(const std::vector<constellation_type_t>& constellations, const std::string& len_key);
+    ofdm_adaptive_constellation_soft_cf_impl(
+        const std::vector<constellation_type_t>& constellations,
+        const std::string& len_key,
+        int fft_len,
+        const std::vector<std::vector<int>>& occupied_carriers,
+        int symbols_skipped);
     ~ofdm_adaptive_constellation_soft_cf_impl();
 
     void forecast(int noutput_items,
@@ -11,6 +11,7 @@
 
 #include <gnuradio/testbed/logger.h>
 
+#include "ofdm_equalizer_kernel.h"
 #include <gnuradio/dtl/ofdm_adaptive_equalizer.h>
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
 
@@ -211,6 +212,30 @@ ofdm_adaptive_equalizer_base::ofdm_adaptive_equalizer_base(
                 pilot_symbols[i][k];
         }
     }
+
+    // Carrier index lists for frame_equalize()
+    int n_sets = std::max<int>(1, d_pilot_carriers.size());
+    d_data_carriers.resize(n_sets);
+    d_pilot_carrier_idx.resize(n_sets);
+    for (int set = 0; set < n_sets; set++) {
+        for (int k = 0; k < fft_len; k++) {
+            if (!d_pilot_carriers.empty() && d_pilot_carriers[set][k]) {
+                d_pilot_carrier_idx[set].push_back(k);
+            } else if (d_occupied_carriers[k]) {
+                d_data_carriers[set].push_back(k);
+            }
+        }
+    }
+    for (const auto& symbols : d_pilot_symbols) {
+        d_pilot_inv.emplace_back(fft_len);
+        for (int k = 0; k < fft_len; k++) {
+            if (symbols[k] != gr_complex(0, 0)) {
+                d_pilot_inv.back()[k] = gr_complex(1, 0) / symbols[k];
+            }
+        }
+    }
+    d_pilots.reserve(fft_len);
+    d_carrier_buf.resize(9 * fft_len);
 }
 
 
@@ -224,46 +249,80 @@ void ofdm_adaptive_equalizer_base::frame_equalize(
     if (!initial_taps.empty()) {
         d_channel_state = initial_taps;
     }
-    gr_complex sym_eq, sym_est, pilot_eq;
+
+    auto& kernel = d_kernels[constellation];
+    if (!kernel) {
+        kernel = std::make_shared<const ofdm_equalizer_kernel>(constellation);
+    }
+
+    // Split buffers of the data carriers
+    int n_buf = d_fft_len;
+    ofdm_equalizer_kernel::carriers_t c;
+    c.y_re = &d_carrier_buf[0];
+    c.y_im = &d_carrier_buf[n_buf];
+    c.h_re = &d_carrier_buf[2 * n_buf];
+    c.h_im = &d_carrier_buf[3 * n_buf];
+    c.eq_re = &d_carrier_buf[4 * n_buf];
+    c.eq_im = &d_carrier_buf[5 * n_buf];
+    c.est_re = &d_carrier_buf[6 * n_buf];
+    c.est_im = &d_carrier_buf[7 * n_buf];
+    float* y_re = &d_carrier_buf[0];
+    float* y_im = &d_carrier_buf[n_buf];
+    float* gain = &d_carrier_buf[8 * n_buf];
 
     // Reset SNR estimator each frame
     d_snr_estimator->reset();
-    int pilot_symbols_set = 0;
     for (int i = 0; i < n_sym; i++) {
-        pilot_symbols_set = (d_symbols_skipped + i) % d_pilot_symbols.size();
-        for (int k = 0; k < d_fft_len; k++) {
-            bool is_pilot_carrier =
-                !d_pilot_carriers.empty() && d_pilot_carriers[d_pilot_carr_set][k];
-            if (!d_occupied_carriers[k] && !is_pilot_carrier) {
-                continue;
-            }
-            if (is_pilot_carrier) {
-                pilot_eq = frame[i * d_fft_len + k] / d_channel_state[k];
-                // Update SNR estimation with each pilot
-                d_snr_estimator->update(1, &pilot_eq);
+        gr_complex* sym = &frame[i * d_fft_len];
+        int carr_set = d_pilot_carriers.empty() ? 0 : d_pilot_carr_set;
+
+        const std::vector<int>& pilot_carriers = d_pilot_carrier_idx[carr_set];
+        if (!pilot_carriers.empty()) {
+            int pilot_symbols_set = (d_symbols_skipped + i) % d_pilot_symbols.size();
+            const gr_complex* pilot_symbols = d_pilot_symbols[pilot_symbols_set].data();
+            const gr_complex* pilot_inv = d_pilot_inv[pilot_symbols_set].data();
+            d_pilots.clear();
+            for (int k : pilot_carriers) {
+                gr_complex h = d_channel_state[k];
+                d_pilots.push_back(sym[k] * std::conj(h) / std::norm(h));
                 // Update channel state
-                d_channel_state[k] = d_alpha * d_channel_state[k] +
-                                     (1 - d_alpha) * frame[i * d_fft_len + k] /
-                                         d_pilot_symbols[pilot_symbols_set][k];
-                frame[i * d_fft_len + k] = d_pilot_symbols[pilot_symbols_set][k];
-            } else {
-                sym_eq = frame[i * d_fft_len + k] / d_channel_state[k];
-                // NOTE: The `map_to_points` function will treat `sym_est` as an array
-                // pointer.  This call is "safe" only for 1-dimension constellations.
-                constellation->map_to_points(constellation->decision_maker(&sym_eq),
-                                             &sym_est);
-                d_channel_state[k] = d_alpha * d_channel_state[k] +
-                                     (1 - d_alpha) * frame[i * d_fft_len + k] / sym_est;
-                frame[i * d_fft_len + k] = sym_est;
-                if (frame_soft) {
-                    frame_soft[i * d_fft_len + k] = sym_eq;
-                }
+                d_channel_state[k] =
+                    d_alpha * h + (1 - d_alpha) * sym[k] * pilot_inv[k];
+                sym[k] = pilot_symbols[k];
             }
+            // Update SNR estimation with the pilots of the symbol
+            d_snr_estimator->update(d_pilots.size(), d_pilots.data());
+        }
+
+        const std::vector<int>& data_carriers = d_data_carriers[carr_set];
+        int n = data_carriers.size();
+        for (int j = 0; j < n; j++) {
+            int k = data_carriers[j];
+            y_re[j] = sym[k].real();
+            y_im[j] = sym[k].imag();
+            c.h_re[j] = d_channel_state[k].real();
+            c.h_im[j] = d_channel_state[k].imag();
+        }
+        for (int j = 0; j < n; j++) {
+            gain[j] = c.h_re[j] * c.h_re[j] + c.h_im[j] * c.h_im[j];
         }
+        kernel->equalize(d_alpha, c, n);
+        d_snr_estimator->update_carriers(n, gain, c.eq_re, c.eq_im, c.est_re, c.est_im);
+        for (int j = 0; j < n; j++) {
+            int k = data_carriers[j];
+            d_channel_state[k] = gr_complex(c.h_re[j], c.h_im[j]);
+            sym[k] = gr_complex(c.est_re[j], c.est_im[j]);
+        }
+        if (frame_soft) {
+            gr_complex* sym_soft = &frame_soft[i * d_fft_len];
+            for (int j = 0; j < n; j++) {
+                sym_soft[data_carriers[j]] = gr_complex(c.eq_re[j], c.eq_im[j]);
+            }
+        }
+
         if (!d_pilot_carriers.empty()) {
             d_pilot_carr_set = (d_pilot_carr_set + 1) % d_pilot_carriers.size();
         }
-        get_noise();
     }
 }
 
@@ -278,6 +337,11 @@ void ofdm_adaptive_equalizer_base::equalize(gr_complex* frame,
 
 double ofdm_adaptive_equalizer_base::get_snr() { return d_snr_estimator->snr(); }
 
+double ofdm_adaptive_equalizer_base::get_effective_snr(constellation_type_t constellation)
+{
+    return d_snr_estimator->effective_snr(constellation);
+}
+
 double ofdm_adaptive_equalizer_base::get_noise()
 {
     d_snr_estimator->snr();
@@ -286,5 +350,38 @@ double ofdm_adaptive_equalizer_base::get_noise()
     return pow(10, noise_db / 10.0);
 }
 
+void ofdm_adaptive_equalizer_base::get_carrier_snr(std::vector<float>& snr)
+{
+    snr.assign(d_fft_len, 0);
+
+    // Average 1 / |H_k|^2 over the carriers the noise was measured on
+    double inv_gain = 0;
+    int n_carriers = 0;
+    for (int k = 0; k < d_fft_len; k++) {
+        bool is_pilot_carrier = false;
+        for (const auto& pilot_carriers : d_pilot_carriers) {
+            is_pilot_carrier = is_pilot_carrier || pilot_carriers[k];
+        }
+        if (!is_pilot_carrier && !(d_pilot_carriers.empty() && d_occupied_carriers[k])) {
+            continue;
+        }
+        float gain = std::norm(d_channel_state[k]);
+        if (gain > 0) {
+            inv_gain += 1.0 / gain;
+            n_carriers++;
+        }
+    }
+    if (n_carriers == 0) {
+        return;
+    }
+
+    double sigma2 = get_noise() * n_carriers / inv_gain;
+    for (int k = 0; k < d_fft_len; k++) {
+        if (d_occupied_carriers[k]) {
+            snr[k] = std::norm(d_channel_state[k]) / sigma2;
+        }
+    }
+}
+
 } // namespace dtl
 } /* namespace gr */
@@ -9,8 +9,13 @@
 #include <gnuradio/testbed/logger.h>
 #include <gnuradio/testbed/monitor_msg.h>
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer_reader.h>
 #include <gnuradio/io_signature.h>
 #include "ofdm_adaptive_fec_decoder_impl.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace gr {
 namespace dtl {
@@ -28,17 +33,28 @@ ofdm_adaptive_fec_decoder::sptr
 ofdm_adaptive_fec_decoder::make(const vector<fec_dec::sptr>& decoders,
                                 int frame_capacity,
                                 int max_bps,
-                                const string& len_key)
+                                const string& len_key,
+                                int nthreads,
+                                int max_tb_in_flight,
+                                bool incremental)
 {
-    return gnuradio::make_block_sptr<ofdm_adaptive_fec_decoder_impl>(
-        decoders, frame_capacity, max_bps, len_key);
+    return gnuradio::make_block_sptr<ofdm_adaptive_fec_decoder_impl>(decoders,
+                                                                      frame_capacity,
+                                                                      max_bps,
+                                                                      len_key,
+                                                                      nthreads,
+                                                                      max_tb_in_flight,
+                                                                      incremental);
 }
 
 ofdm_adaptive_fec_decoder_impl::ofdm_adaptive_fec_decoder_impl(
     const vector<fec_dec::sptr>& decoders,
     int frame_capacity,
     int max_bps,
-    const string& len_key)
+    const string& len_key,
+    int nthreads,
+    int max_tb_in_flight,
+    bool incremental)
     : gr::block(
           "ofdm_adaptive_fec_decoder",
           gr::io_signature::make(1 /* min inputs */, 1 /* max inputs */, sizeof(float)),
@@ -49,7 +65,7 @@ ofdm_adaptive_fec_decoder_impl::ofdm_adaptive_fec_decoder_impl(
       d_frame_capacity(frame_capacity),
       d_processed_input(0),
       d_crc(4, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF),
-      d_to_bytes(1, 8)
+      d_link_adaptation(nullptr)
 {
     auto it_max_n = max_element(d_decoders.begin() + 1,
                                 d_decoders.end(),
@@ -68,14 +84,51 @@ ofdm_adaptive_fec_decoder_impl::ofdm_adaptive_fec_decoder_impl(
     }
     int frame_len = d_frame_capacity * max_bps;
     int ncws = compute_tb_len((*it_max_n)->get_n(), frame_len);
-    d_tb_dec = make_shared<tb_decoder>((*it_max_n)->get_n() * ncws);
-    d_crc_buffer.resize((*it_max_k)->get_k() * ncws / 8 + 1);
+    d_tb_dec = make_shared<tb_decoder>(
+        (*it_max_n)->get_n() * ncws, nthreads, max_tb_in_flight, incremental);
+
+    // Largest TB payload, and room for the two TBs a frame can complete
+    d_max_tb_bytes = 0;
+    int frame_bits = 8 * align_bits_to_bytes(d_frame_capacity * max_bps);
+    for (auto it = d_decoders.begin() + 1; it != d_decoders.end(); ++it) {
+        int tb_len = compute_tb_len((*it)->get_n(), frame_bits);
+        d_max_tb_bytes =
+            max(d_max_tb_bytes, align_bits_to_bytes(tb_len * (*it)->get_k()));
+    }
+    // One item of a stream buffer is never written
+    set_min_output_buffer(2 * d_max_tb_bytes + 1);
     message_port_register_out(pmt::mp("monitor"));
     set_tag_propagation_policy(block::tag_propagation_policy_t::TPP_DONT);
 }
 
 ofdm_adaptive_fec_decoder_impl::~ofdm_adaptive_fec_decoder_impl() {}
 
+void ofdm_adaptive_fec_decoder_impl::set_link_adaptation(
+    ofdm_adaptive_feedback_decision_base::sptr link_adaptation)
+{
+    d_link_adaptation = link_adaptation;
+}
+
+
+void ofdm_adaptive_fec_decoder_impl::forecast(int noutput_items,
+                                              gr_vector_int& ninput_items_required)
+{
+    // Called without input while TBs are decoding in the worker pool
+    ninput_items_required[0] = d_tb_dec->pending() ? 0 : noutput_items;
+}
+
+bool ofdm_adaptive_fec_decoder_impl::stop()
+{
+    // The output buffers are gone: wait for the TBs still decoding and drop them
+    int dropped = 0;
+    d_tb_dec->flush(numeric_limits<int>::max(),
+                    [&dropped](const std::vector<unsigned char>&, fec_info_t::sptr, int) {
+                        ++dropped;
+                    });
+    DTL_LOG_DEBUG("stop: dropped_tbs={}", dropped);
+    return block::stop();
+}
+
 
 int ofdm_adaptive_fec_decoder_impl::general_work(int noutput_items,
                                                  gr_vector_int& ninput_items,
@@ -90,7 +143,64 @@ int ofdm_adaptive_fec_decoder_impl::general_work(int noutput_items,
 
     DTL_LOG_DEBUG("work: ninput={}, noutput={}", ninput_items[0], noutput_items);
 
+    // When transport block is decoded copy user data to the output buffer
+    auto on_data_ready = [this, &write_index, &out](
+                            const std::vector<unsigned char>& data_buffer,
+                            fec_info_t::sptr tb_fec_info, int avg_it) {
+        int bps = tb_fec_info->d_bps;
+        int ncws = compute_tb_len(tb_fec_info->get_n(),
+                                  8 * align_bits_to_bytes(d_frame_capacity * bps));
+        // The TB payload comes packed: check the CRC on the bytes as they are
+        // An empty payload is a TB the worker pool failed to decode
+        bool crc_ok = !data_buffer.empty() &&
+                      d_crc.verify_crc(&data_buffer[0], data_buffer.size());
+        int user_data_len = crc_ok ? data_buffer.size() - d_crc.get_crc_len() : 0;
+
+        // Output the user bytes as they are, tagged with their length in bytes
+        if (crc_ok) {
+            memcpy(&out[write_index], &data_buffer[0], user_data_len);
+            add_item_tag(0, nitems_written(0)+write_index, d_len_key, pmt::from_long(user_data_len));
+            write_index += user_data_len;
+        }
+        if (d_link_adaptation) {
+            d_link_adaptation->report_tb(
+                make_pair(tb_fec_info->d_constellation,
+                          static_cast<unsigned char>(tb_fec_info->d_fec_idx)),
+                tb_fec_info->d_snr,
+                crc_ok);
+        }
+        double tber = 100 * d_crc.get_failed() / static_cast<double>(d_crc.get_failed() + d_crc.get_success());
+
+        pmt::pmt_t msg = monitor_msg_builder.build_any(
+            make_pair("tb_no", tb_fec_info->d_tb_number),
+            make_pair("tb_payload", tb_fec_info->d_tb_payload_len),
+            make_pair("tb_code_k", tb_fec_info->get_k()),
+            make_pair("tb_code_n", tb_fec_info->get_n()),
+            make_pair("tb_codewords", ncws),
+            make_pair("frame_payload", tb_fec_info->d_frame_payload),
+            make_pair("bps", bps),
+            make_pair("crc_ok_count", d_crc.get_success()),
+            make_pair("crc_fail_count", d_crc.get_failed()),
+            make_pair("tber", tber),
+            make_pair("avg_it", avg_it));
+        message_port_pub(MONITOR_PORT, msg);
+
+        DTL_LOG_DEBUG("tb_payload_ready: crc_ok={}, tb_no={}, tb_payload={}, bps={}, user_data_len={}, avg_it={}, crc_fail_count={}",
+                    crc_ok,
+                    tb_fec_info->d_tb_number,
+                    tb_fec_info->d_tb_payload_len,
+                    bps,
+                    user_data_len, avg_it, d_crc.get_failed());
+    };
+
     while (read_index < ninput_items[0]) {
+        // The TBs the frame completes must fit in the output, the ones the worker
+        // pool decodes wait in it for the space
+        if (noutput_items - write_index < 2 * d_max_tb_bytes &&
+            d_tb_dec->free_slots() < 2) {
+            break;
+        }
+
         vector<tag_t> tags;
         get_tags_in_range(
             tags, 0, nitems_read(0) + read_index, nitems_read(0) + read_index + 1);
@@ -99,20 +209,21 @@ int ofdm_adaptive_fec_decoder_impl::general_work(int noutput_items,
         int bps = 0;
         int len = 0;
         int frame_len = 0;
+        constellation_type_t cnst = constellation_type_t::UNKNOWN;
+        double snr = NAN;
 
         for (auto& tag : tags) {
 
             if (tag.key == get_constellation_tag_key()) {
-                bps = get_bits_per_symbol(
-                    static_cast<constellation_type_t>(pmt::to_long(tag.value)));
+                cnst = static_cast<constellation_type_t>(pmt::to_long(tag.value));
+                bps = get_bits_per_symbol(cnst);
                 test |= 1;
             } else if (tag.key == d_len_key) {
                 len = pmt::to_long(tag.value);
                 test |= 2;
                 // remove_item_tag(0, tag);
-            }
-            if (test == 3) {
-                break;
+            } else if (tag.key == estimated_snr_tag_key()) {
+                snr = pmt::to_double(tag.value);
             }
         }
 
@@ -145,63 +256,9 @@ int ofdm_adaptive_fec_decoder_impl::general_work(int noutput_items,
         } else {
             // ... proceed with the frame.
             fec_info->d_tb_offset *= 8;
-            int code_n = fec_info->get_n();
-            int ncws = compute_tb_len(code_n, 8 * align_bits_to_bytes(d_frame_capacity * bps));
-
-
-            // Make sure we consume input only if we'll be able to produce the output
-            // if ((d_tb_dec->receive_buffer_empty() &&
-            //     noutput_items < fec_info->d_tb_payload_len) ||
-            //     (!d_tb_dec->receive_buffer_empty() &&
-            //     noutput_items < d_tb_dec->get_current_tb_payload())) {
-            //     break;
-            // }
-
-            // When transport block is decoded copy user data to the output buffer
-            auto on_data_ready = [this, &write_index, &out, &bps, &code_n, &ncws](
-                                    const std::vector<unsigned char>& data_buffer,
-                                    fec_info_t::sptr tb_fec_info, int avg_it) {
-                int user_data_len = data_buffer.size() - d_crc.get_crc_len() * 8;
-                int crc_buf_len = d_to_bytes.repack_lsb_first(
-                    &data_buffer[0], user_data_len, &d_crc_buffer[0]);
-                d_to_bytes.repack_lsb_first(&data_buffer[user_data_len],
-                                            d_crc.get_crc_len() * 8,
-                                            &d_crc_buffer[crc_buf_len]);
-                bool crc_ok =
-                    d_crc.verify_crc(&d_crc_buffer[0], crc_buf_len + d_crc.get_crc_len());
-
-                if (crc_ok) {
-                    struct iphdr *iph = (struct iphdr *)&data_buffer[0];
-                    memcpy(&out[write_index], &data_buffer[0], user_data_len);
-
-                    // int data_bytes = d_to_bytes.repack_lsb_first(&data_buffer[0], user_data_len, &out[write_index]);
-                    // assert(data_bytes == user_data_len/8);
-                    add_item_tag(0, nitems_written(0)+write_index, d_len_key, pmt::from_long(user_data_len));
-                    write_index += user_data_len;
-                }
-                double tber = 100 * d_crc.get_failed() / static_cast<double>(d_crc.get_failed() + d_crc.get_success());
-
-                pmt::pmt_t msg = monitor_msg_builder.build_any(
-                    make_pair("tb_no", tb_fec_info->d_tb_number),
-                    make_pair("tb_payload", tb_fec_info->d_tb_payload_len),
-                    make_pair("tb_code_k", tb_fec_info->get_k()),
-                    make_pair("tb_code_n", tb_fec_info->get_n()),
-                    make_pair("tb_codewords", ncws),
-                    make_pair("frame_payload", tb_fec_info->d_frame_payload),
-                    make_pair("bps", bps),
-                    make_pair("crc_ok_count", d_crc.get_success()),
-                    make_pair("crc_fail_count", d_crc.get_failed()),
-                    make_pair("tber", tber),
-                    make_pair("avg_it", avg_it));
-                message_port_pub(MONITOR_PORT, msg);
-
-                DTL_LOG_DEBUG("tb_payload_ready: crc_ok={}, tb_no={}, tb_payload={}, bps={}, user_data_len={}, avg_it={}, crc_fail_count={}",
-                            crc_ok,
-                            tb_fec_info->d_tb_number,
-                            tb_fec_info->d_tb_payload_len,
-                            bps,
-                            user_data_len, avg_it, d_crc.get_failed());
-            };
+            fec_info->d_bps = bps;
+            fec_info->d_constellation = cnst;
+            fec_info->d_snr = snr;
 
             d_tb_dec->process_frame(&in[read_index],
                                     8 * align_bits_to_bytes(d_frame_capacity * bps),
@@ -211,6 +268,19 @@ int ofdm_adaptive_fec_decoder_impl::general_work(int noutput_items,
             read_index += frame_len;
         }
     }
+    if (read_index == 0 && d_tb_dec->pending()) {
+        // Nothing to receive: at the end of the stream output all the TBs
+        // still decoding, otherwise wait for the oldest instead of spinning
+        if (detail()->input(0)->done()) {
+            d_tb_dec->flush(noutput_items - write_index, on_data_ready);
+        } else {
+            d_tb_dec->poll(noutput_items - write_index, on_data_ready, true);
+        }
+    } else {
+        // TBs the worker pool has finished, the others are output by next calls
+        d_tb_dec->poll(noutput_items - write_index, on_data_ready);
+    }
+
     DTL_LOG_DEBUG("work: consumed={}, produced={}", read_index, write_index);
     consume_each(read_index);
     return write_index;
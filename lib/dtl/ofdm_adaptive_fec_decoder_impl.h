@@ -14,7 +14,6 @@
 #include <gnuradio/dtl/ofdm_adaptive_fec_decoder.h>
 #include "ofdm_adaptive_monitor.h"
 #include "proto/monitor_ofdm.pb.h"
-#include <gnuradio/testbed/repack.h>
 #include "tb_decoder.h"
 
 namespace gr {
@@ -26,17 +25,31 @@ private:
     pmt::pmt_t d_len_key;
     std::vector<fec_dec::sptr> d_decoders;
     int d_frame_capacity;
+    // Largest TB payload in bytes, the most a TB outputs
+    int d_max_tb_bytes;
     tb_decoder::sptr d_tb_dec;
     bool d_processed_input;
-    std::vector<unsigned char> d_crc_buffer;
     crc_util d_crc;
-    repack d_to_bytes;
     proto_fec_builder_t monitor_msg_builder;
+    ofdm_adaptive_feedback_decision_base::sptr d_link_adaptation;
 
 public:
-    ofdm_adaptive_fec_decoder_impl(const std::vector<fec_dec::sptr>& decoders, int frame_capacity, int max_bps, const std::string& len_key);
+    ofdm_adaptive_fec_decoder_impl(const std::vector<fec_dec::sptr>& decoders,
+                                   int frame_capacity,
+                                   int max_bps,
+                                   const std::string& len_key,
+                                   int nthreads,
+                                   int max_tb_in_flight,
+                                   bool incremental);
     ~ofdm_adaptive_fec_decoder_impl();
 
+    void set_link_adaptation(
+        ofdm_adaptive_feedback_decision_base::sptr link_adaptation) override;
+
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+
+    bool stop() override;
+
     // Where all the action really happens
     int general_work(int noutput_items,
              gr_vector_int& ninput_items,
@@ -36,8 +36,6 @@ endif
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
 #include <gnuradio/io_signature.h>
 #include <gnuradio/testbed/logger.h>
-#include <gnuradio/testbed/repack.h>
-#include <thread>
 
 namespace gr {
 namespace dtl {
@@ -96,12 +94,17 @@ ofdm_adaptive_fec_frame_bvb_impl::ofdm_adaptive_fec_frame_bvb_impl(
       d_consecutive_empty_frames(0),
       d_crc(4, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF),
       d_total_frames(0),
-      d_frame_duration(std::chrono::duration<double>(1.0 / frame_rate)),
+      d_clock(frame_clock::make(frame_rate)),
       d_max_empty_frames(max_empty_frames),
       d_feedback_fec_idx(0),
       d_feedback_cnst(constellation_type_t::UNKNOWN),
       d_current_pdu_remain(0),
-      d_loaded_frames(0)
+      d_loaded_frames(0),
+      d_burst_frames(0),
+      d_feedback_channel(nullptr),
+      d_header_channel(nullptr),
+      d_feedback_seq(0),
+      d_header_seq(0)
 {
     // Find longest code
     if (d_encoders.size() <= 1) {
@@ -123,7 +126,6 @@ ofdm_adaptive_fec_frame_bvb_impl::ofdm_adaptive_fec_frame_bvb_impl(
     int ncws = compute_tb_len((*it_max_n)->get_n(), d_frame_capacity * max_bps);
     d_tb_enc = make_shared<tb_encoder>((*it_max_n)->get_n() * ncws, (*it_max_n)->get_n());
 
-    d_tb_payload.resize((*it_max_k)->get_k() * ncws);
     d_crc_buffer.resize((*it_max_k)->get_k() * ncws / 8 + 1);
 
     set_min_noutput_items(1);
@@ -144,7 +146,7 @@ ofdm_adaptive_fec_frame_bvb_impl::~ofdm_adaptive_fec_frame_bvb_impl() {}
 
 bool ofdm_adaptive_fec_frame_bvb_impl::start()
 {
-    // d_start_time = std::chrono::steady_clock::now();
+    d_clock->start();
     d_total_frames = 0;
     return block::start();
 }
@@ -201,6 +203,53 @@ void ofdm_adaptive_fec_frame_bvb_impl::process_feedback_header(pmt::pmt_t header
 }
 
 
+void ofdm_adaptive_fec_frame_bvb_impl::set_feedback_channel(mcs_channel::sptr channel)
+{
+    d_feedback_channel = channel;
+}
+
+
+void ofdm_adaptive_fec_frame_bvb_impl::set_header_channel(mcs_channel::sptr channel)
+{
+    d_header_channel = channel;
+}
+
+
+void ofdm_adaptive_fec_frame_bvb_impl::set_frame_clock(frame_clock::sptr clock)
+{
+    d_clock = clock;
+}
+
+
+void ofdm_adaptive_fec_frame_bvb_impl::set_burst_frames(int nframes)
+{
+    d_burst_frames = nframes;
+}
+
+
+void ofdm_adaptive_fec_frame_bvb_impl::read_mcs_channels()
+{
+    // Same updates as the feedback and header messages
+    mcs_t mcs;
+    if (d_feedback_channel && d_feedback_channel->read(mcs, d_feedback_seq)) {
+        if (get_bits_per_symbol(mcs.constellation)) {
+            d_feedback_cnst = mcs.constellation;
+        }
+        if (mcs.fec_idx >= 0) {
+            d_feedback_fec_idx = mcs.fec_idx;
+        }
+    }
+    if (d_header_channel && d_header_channel->read(mcs, d_header_seq)) {
+        if (get_bits_per_symbol(mcs.constellation)) {
+            d_header_cnst = mcs.constellation;
+        }
+        if (mcs.fec_idx >= 0) {
+            d_header_fec_idx = mcs.fec_idx;
+        }
+    }
+}
+
+
 void ofdm_adaptive_fec_frame_bvb_impl::forecast(int noutput_items,
                                                 gr_vector_int& ninput_items_required)
 {
@@ -236,6 +285,12 @@ void ofdm_adaptive_fec_frame_bvb_impl::add_frame_tags(int frame_payload)
                  pmt::from_long(static_cast<int>(d_feedback_cnst) & 0xf));
     add_item_tag(
         0, d_tag_offset, fec_feedback_key(), pmt::from_long(d_feedback_fec_idx & 0xf));
+    if (d_clock->time_tags()) {
+        // Index and transmission time of the frame
+        add_item_tag(
+            0, d_tag_offset, frame_index_key(), pmt::from_uint64(d_total_frames));
+        add_item_tag(0, d_tag_offset, tx_time_key(), d_clock->tx_time(d_total_frames));
+    }
     ++d_tag_offset;
     ++d_total_frames;
     DTL_LOG_DEBUG("frame_out: tb_no={}, frame_payaload={}", d_tb_count, frame_payload);
@@ -273,11 +328,26 @@ int ofdm_adaptive_fec_frame_bvb_impl::current_frame_available_bytes()
 }
 
 
-int ofdm_adaptive_fec_frame_bvb_impl::produce_one_frame()
+int ofdm_adaptive_fec_frame_bvb_impl::max_tb_frames()
+{
+    // A TB of the next MCS starts in the current frame, which may be finalized
+    // before it on an MCS change, and ends in a frame finalized after it
+    int frame_bits = d_frame_capacity * get_bits_per_symbol(d_header_cnst) / 8 * 8;
+    int n = d_encoders[d_header_fec_idx]->get_n();
+    int tb_bits = compute_tb_len(n, frame_bits) * n;
+    return 1 + (tb_bits + frame_bits - 1) / frame_bits;
+}
+
+
+int ofdm_adaptive_fec_frame_bvb_impl::produce_frames(int noutput_items)
 {
-    DTL_LOG_DEBUG("produced: loaded_frames={}", d_loaded_frames);
-    d_expected_time += d_frame_duration;
-    return static_cast<int>(static_cast<bool>(d_loaded_frames--));
+    // The loaded frames whose slots have started, the others stay at the start of the
+    // output buffer for the next calls
+    int produced = d_clock->wait(min(d_loaded_frames, noutput_items));
+    d_loaded_frames -= produced;
+    d_clock->advance(produced);
+    DTL_LOG_DEBUG("produced: frames={}, loaded_frames={}", produced, d_loaded_frames);
+    return produced;
 }
 
 
@@ -289,12 +359,11 @@ int ofdm_adaptive_fec_frame_bvb_impl::general_work(int noutput_items,
     auto in = static_cast<const unsigned char*>(input_items[0]);
     auto out = static_cast<unsigned char*>(output_items[0]);
 
-    int write_index = d_current_frame_offset;
+    // After the frames loaded in previous calls
+    int write_index = d_loaded_frames * d_frame_capacity + d_current_frame_offset;
     int read_index = 0;
     int consumed_input = 0;
     int output_available = noutput_items * d_frame_capacity;
-    repack to_bytes(1, 8);
-    repack to_bits(8, 1);
 
     DTL_LOG_DEBUG("work_start: d_frame_capacity={}, noutput={}, ninput={}, action={}",
                   d_frame_capacity,
@@ -302,39 +371,44 @@ int ofdm_adaptive_fec_frame_bvb_impl::general_work(int noutput_items,
                   ninput_items[0],
                   (int)d_action);
 
-    if (d_total_frames == 0) {
-        d_expected_time = std::chrono::steady_clock::now();
-    } else {
-        auto now = std::chrono::steady_clock::now();
-        if (now < d_expected_time) {
-            DTL_LOG_DEBUG("produced wait");
-            std::this_thread::sleep_until(d_expected_time);
-        }
-        // Produce
-        if (d_loaded_frames) {
-            return produce_one_frame();
-        }
+    if (d_loaded_frames == 0) {
+        // Wait for the slot of the next frame
+        d_clock->wait(1);
     }
 
-    // If no input but enough space in output buffer, generate an empty frame
-    if (ninput_items[0] == 0 && noutput_items > 0 && d_loaded_frames == 0) {
+    // Latest decisions, after waiting for the frame slot
+    read_mcs_channels();
+
+    // In burst mode, keep encoding the input while the loaded frames wait for their
+    // slots, if the next TB fits in the output buffer
+    bool encode_ahead = d_loaded_frames < d_burst_frames && ninput_items[0] > 0 &&
+                        d_loaded_frames + max_tb_frames() <= noutput_items;
+    if (d_loaded_frames && !encode_ahead) {
+        return produce_frames(noutput_items);
+    }
+
+    // If no input and no TB left to output, generate the empty frames due
+    if (ninput_items[0] == 0 && noutput_items > 0 && d_loaded_frames == 0 &&
+        d_action == Action::PROCESS_INPUT) {
         int frame_payload = tb_offset_to_bytes();
-        if (output_available >= 1) {
+        int nempty = d_clock->wait(noutput_items);
+        for (int i = 0; i < nempty; ++i) {
             if (d_max_empty_frames >= 0 &&
-                ++d_consecutive_empty_frames >= d_max_empty_frames) {
+                d_consecutive_empty_frames >= d_max_empty_frames) {
                 DTL_LOG_DEBUG("work_done: consecutive_empty_frames={}",
                               d_consecutive_empty_frames);
-                return WORK_DONE;
-            } else {
-                DTL_LOG_DEBUG("empty_frame: payload={}", frame_payload);
-                add_frame_tags(frame_payload);
-                memset(out, 0, d_frame_capacity);
-                ++d_loaded_frames;
-                return produce_one_frame();
+                if (d_loaded_frames == 0) {
+                    return WORK_DONE;
+                }
+                break;
             }
-        } else {
-            return 0;
+            DTL_LOG_DEBUG("empty_frame: payload={}", frame_payload);
+            add_frame_tags(frame_payload);
+            memset(&out[d_loaded_frames * d_frame_capacity], 0, d_frame_capacity);
+            ++d_loaded_frames;
+            ++d_consecutive_empty_frames;
         }
+        return produce_frames(noutput_items);
     }
 
     bool wait_next_work = false;
@@ -343,7 +417,7 @@ int ofdm_adaptive_fec_frame_bvb_impl::general_work(int noutput_items,
     while ((read_index < ninput_items[0] || d_action != Action::PROCESS_INPUT) &&
            !wait_next_work) {
 
-        assert(d_action == Action::PROCESS_INPUT && d_tb_enc->ready());
+        assert(d_action != Action::PROCESS_INPUT || d_tb_enc->ready());
 
         switch (d_action) {
 
@@ -395,14 +469,11 @@ int ofdm_adaptive_fec_frame_bvb_impl::general_work(int noutput_items,
             if (to_read) {
                 // Copy user data in payload and CRC buffers
                 memcpy(&d_crc_buffer[0], &in[read_index], to_read);
-                //  Compute CRC and move the value in payload buffer
+                //  Compute CRC and encode the TB from the packed bytes
                 d_crc.append_crc(&d_crc_buffer[0], to_read);
-                to_bits.repack_lsb_first(&d_crc_buffer[0],
-                                         to_read + d_crc.get_crc_len(),
-                                         &d_tb_payload[0]);
 
                 // TODO: Compute new tb len if len<max
-                d_tb_enc->encode(&d_tb_payload[0],
+                d_tb_enc->encode(&d_crc_buffer[0],
                                  (to_read + d_crc.get_crc_len()) * 8,
                                  d_current_enc,
                                  d_tb_len);
@@ -453,14 +524,19 @@ int ofdm_adaptive_fec_frame_bvb_impl::general_work(int noutput_items,
                         d_current_frame_offset,
                         write_index);
 
-                    // Reset frame buffer in case frame is not filled
-                    memset(&out[write_index], 0, d_frame_capacity);
-
-                    d_tb_enc->buf_out(
+                    int syms = d_tb_enc->buf_out(
                         &out[write_index],
                         min(out_frame_bytes * 8, d_tb_enc->remaining_buf_size()),
                         d_current_bps);
 
+                    // Zero only the rest of the frame, the TB symbols are written once
+                    int frame_end = (d_loaded_frames + 1) * d_frame_capacity;
+                    if (write_index + syms < frame_end) {
+                        memset(&out[write_index + syms],
+                               0,
+                               frame_end - write_index - syms);
+                    }
+
                     // If we fill out the current frame ...
                     int avail_bytes = current_frame_available_bytes();
                     if (out_frame_bytes == avail_bytes) {
@@ -518,6 +594,15 @@ int ofdm_adaptive_fec_frame_bvb_impl::general_work(int noutput_items,
         }
         case Action::FINALIZE_FRAME: {
             if (d_action == Action::FINALIZE_FRAME) {
+                if (d_loaded_frames >= noutput_items) {
+                    // No room for the frame, finalize it in the next calls
+                    wait_next_work = true;
+                    break;
+                }
+                if (d_frame_used_capacity == 0) {
+                    // No TB symbols in the frame
+                    memset(&out[d_loaded_frames * d_frame_capacity], 0, d_frame_capacity);
+                }
                 add_frame_tags(d_current_frame_payload);
                 d_action = Action::PROCESS_INPUT;
                 ++d_loaded_frames;
@@ -556,10 +641,10 @@ int ofdm_adaptive_fec_frame_bvb_impl::general_work(int noutput_items,
 
 
 
+    // Consume all, the frames not due yet are produced by the next calls
+    consume_each(consumed_input);
     if (d_loaded_frames) {
-        // Consume all but produce only one and defer the reset for next calls
-        consume_each(consumed_input);
-        return produce_one_frame();
+        return produce_frames(noutput_items);
     }
     return 0;
 }
@@ -9,7 +9,6 @@
 #define INCLUDED_DTL_OFDM_ADAPTIVE_FEC_FRAME_BVB_IMPL_H
 
 #include "crc_util.h"
-#include <chrono>
 #include <gnuradio/dtl/fec.h>
 #include <gnuradio/dtl/ofdm_adaptive_fec_frame_bvb.h>
 #include <gnuradio/dtl/ofdm_adaptive_utils.h>
@@ -31,7 +30,9 @@ private:
     int tb_offset_to_bytes();
     int current_frame_available_bytes();
     int align_bytes_to_syms(int nbytes);
-    int produce_one_frame();
+    int max_tb_frames();
+    int produce_frames(int noutput_items);
+    void read_mcs_channels();
 
     std::vector<fec_enc::sptr> d_encoders;
     int d_frame_capacity;
@@ -57,19 +58,22 @@ private:
     int d_frame_padding_syms;
     int d_frame_used_capacity;
     int d_consecutive_empty_frames;
-    std::vector<unsigned char> d_tb_payload;
     std::vector<unsigned char> d_crc_buffer;
     crc_util d_crc;
-    std::chrono::time_point<std::chrono::steady_clock> d_start_time;
     unsigned long d_total_frames;
-    std::chrono::duration<double> d_frame_duration;
+    frame_clock::sptr d_clock;
     int d_max_empty_frames;
     unsigned char d_feedback_fec_idx;
     constellation_type_t d_feedback_cnst;
-    std::chrono::time_point<std::chrono::steady_clock, std::chrono::duration<double>> d_expected_time;
     int d_current_pdu_remain;
     pdu_consumer consumer;
+    // Frames of the output buffer, produced once their slots have started
     int d_loaded_frames;
+    int d_burst_frames;
+    mcs_channel::sptr d_feedback_channel;
+    mcs_channel::sptr d_header_channel;
+    uint64_t d_feedback_seq;
+    uint64_t d_header_seq;
 
 public:
     ofdm_adaptive_fec_frame_bvb_impl(const std::vector<fec_enc::sptr>& encoders,
@@ -84,6 +88,14 @@ public:
 
     void process_feedback_header(pmt::pmt_t header_data);
 
+    void set_feedback_channel(mcs_channel::sptr channel) override;
+
+    void set_header_channel(mcs_channel::sptr channel) override;
+
+    void set_frame_clock(frame_clock::sptr clock) override;
+
+    void set_burst_frames(int nframes) override;
+
     void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
 
     // Where all the action really happens
@@ -9,7 +9,9 @@
 #include <gnuradio/dtl/ofdm_adaptive_feedback_decision.h>
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <limits>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -18,6 +20,32 @@ namespace dtl {
 
 INIT_DTL_LOGGER("ofdm_adaptive_feedback_decision");
 
+// SNR grid of the BLER curves [dB]
+static const double SNR_MIN = -10;
+static const double SNR_STEP = 0.25;
+static const int SNR_BINS = 201;
+// Slope of the initial BLER curves around the lut thresholds [1/dB]
+static const double PRIOR_SLOPE = 1.5;
+// Weight of a CRC outcome in the BLER of its SNR bin
+static const float BLER_LEARNING_RATE = 0.05;
+// Bound of the outer loop offset [dB]
+static const double OLLA_MAX_OFFSET = 10;
+// Every EXPLORATION_PERIOD-th decision probes the MCS above the best one, so a curve
+// raised by NACKs gets outcomes again once the channel improves
+static const int EXPLORATION_PERIOD = 50;
+
+void ofdm_adaptive_feedback_decision_base::report_tb(ofdm_adaptive_feedback_t mcs,
+                                                     double snr,
+                                                     bool crc_ok)
+{
+}
+
+ofdm_adaptive_feedback_t
+ofdm_adaptive_feedback_decision_base::get_feedback(const effective_snr_t& effective_snr)
+{
+    return get_feedback(effective_snr(constellation_type_t::UNKNOWN));
+}
+
 ofdm_adaptive_feedback_decision_base::~ofdm_adaptive_feedback_decision_base() {}
 
 ofdm_adaptive_feedback_decision::sptr ofdm_adaptive_feedback_decision::make(
@@ -62,15 +90,41 @@ ofdm_adaptive_feedback_decision::get_feedback(double estimated_snr)
         (int)d_new_decision,
         d_decision_counter);
 
+    return decide(estimated_snr, estimated_snr);
+}
+
+ofdm_adaptive_feedback_t
+ofdm_adaptive_feedback_decision::get_feedback(const effective_snr_t& effective_snr)
+{
+    mcs_id_t current_mcs_id = d_last_decision;
+    double current_snr = effective_snr(d_feedback_lut[current_mcs_id].second.first);
+    double better_snr = current_snr;
+    if (current_mcs_id + 1 < static_cast<mcs_id_t>(d_feedback_lut.size())) {
+        better_snr = effective_snr(d_feedback_lut[current_mcs_id + 1].second.first);
+    }
+    DTL_LOG_DEBUG("Get feedback for effective snr={}/{}, last_decision={}, "
+                  "new_decision={}, counter={}",
+                  current_snr,
+                  better_snr,
+                  (int)d_last_decision,
+                  (int)d_new_decision,
+                  d_decision_counter);
+
+    return decide(current_snr, better_snr);
+}
+
+ofdm_adaptive_feedback_t ofdm_adaptive_feedback_decision::decide(double current_snr,
+                                                                 double better_snr)
+{
     mcs_id_t current_mcs_id = d_last_decision;
     auto& mcs = d_feedback_lut[current_mcs_id];
 
-    if (estimated_snr < mcs.first) {
+    if (current_snr < mcs.first) {
         assert(current_mcs_id > 0);
         update_decision(current_mcs_id-1);
     } else if (current_mcs_id+1 < d_feedback_lut.size()) {
         auto& better_mcs = d_feedback_lut[current_mcs_id+1];
-        if (estimated_snr > (better_mcs.first + d_hyteresis)) {
+        if (better_snr > (better_mcs.first + d_hyteresis)) {
             update_decision(current_mcs_id+1);
         } else {
             d_decision_counter = 0;
@@ -95,5 +149,205 @@ void ofdm_adaptive_feedback_decision::update_decision(mcs_id_t mcs_id)
     }
 }
 
+
+ofdm_adaptive_link_adaptation::sptr ofdm_adaptive_link_adaptation::make(
+    const std::vector<std::pair<double, ofdm_adaptive_feedback_t>>& lut,
+    const std::vector<double>& efficiency,
+    double target_bler,
+    double olla_step,
+    mcs_id_t initial_mcs)
+{
+    return std::make_shared<ofdm_adaptive_link_adaptation>(
+        lut, efficiency, target_bler, olla_step, initial_mcs);
+}
+
+ofdm_adaptive_link_adaptation::ofdm_adaptive_link_adaptation(
+    const std::vector<std::pair<double, ofdm_adaptive_feedback_t>>& lut,
+    const std::vector<double>& efficiency,
+    double target_bler,
+    double olla_step,
+    mcs_id_t initial_mcs)
+    : d_feedback_lut(lut),
+      d_efficiency(efficiency),
+      d_olla_step_down(olla_step),
+      d_olla_step_up(olla_step * target_bler / (1 - target_bler)),
+      d_olla_offset(0),
+      d_bler(lut.size() * SNR_BINS),
+      d_decision_table(SNR_BINS, initial_mcs),
+      d_last_decision(initial_mcs),
+      d_decisions(0)
+{
+    if (d_feedback_lut.size() == 0) {
+        throw std::runtime_error("Feedback lookup table is empty");
+    }
+    if (target_bler <= 0 || target_bler >= 1) {
+        throw std::invalid_argument("Target BLER must be in (0, 1)");
+    }
+    if (initial_mcs < 0 || initial_mcs >= static_cast<mcs_id_t>(lut.size())) {
+        throw std::invalid_argument("Initial MCS is not in the lookup table");
+    }
+    if (d_efficiency.empty()) {
+        for (auto& mcs : d_feedback_lut) {
+            d_efficiency.push_back(get_bits_per_symbol(mcs.second.first));
+        }
+    } else if (d_efficiency.size() != d_feedback_lut.size()) {
+        throw std::invalid_argument("One efficiency per lookup table entry expected");
+    }
+
+    // Logistic BLER with BLER(threshold) = target_bler
+    double target_logit = std::log((1 - target_bler) / target_bler);
+    for (size_t m = 0; m < d_feedback_lut.size(); ++m) {
+        for (int b = 0; b < SNR_BINS; ++b) {
+            double snr = SNR_MIN + b * SNR_STEP;
+            double x = PRIOR_SLOPE * (snr - d_feedback_lut[m].first) + target_logit;
+            d_bler[m * SNR_BINS + b] = 1 / (1 + std::exp(x));
+        }
+    }
+    update_decision_table(0, SNR_BINS);
+}
+
+ofdm_adaptive_link_adaptation::~ofdm_adaptive_link_adaptation() {}
+
+int ofdm_adaptive_link_adaptation::snr_bin(double snr) const
+{
+    double bin = std::round((snr - SNR_MIN) / SNR_STEP);
+    return static_cast<int>(std::min<double>(std::max<double>(bin, 0), SNR_BINS - 1));
+}
+
+void ofdm_adaptive_link_adaptation::update_decision_table(int begin, int end)
+{
+    for (int b = begin; b < end; ++b) {
+        // Lowest MCS unless a higher one is strictly better
+        mcs_id_t best = 0;
+        double best_goodput = d_efficiency[0] * (1 - d_bler[b]);
+        for (size_t m = 1; m < d_feedback_lut.size(); ++m) {
+            double goodput = d_efficiency[m] * (1 - d_bler[m * SNR_BINS + b]);
+            if (goodput > best_goodput) {
+                best = m;
+                best_goodput = goodput;
+            }
+        }
+        d_decision_table[b] = best;
+    }
+}
+
+mcs_id_t ofdm_adaptive_link_adaptation::explore(mcs_id_t mcs_id)
+{
+    d_decisions = (d_decisions + 1) % EXPLORATION_PERIOD;
+    if (d_decisions == 0 && mcs_id + 1 < static_cast<mcs_id_t>(d_feedback_lut.size())) {
+        return mcs_id + 1;
+    }
+    return mcs_id;
+}
+
+ofdm_adaptive_feedback_t ofdm_adaptive_link_adaptation::get_feedback(double estimated_snr)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (std::isfinite(estimated_snr)) {
+        d_last_decision = d_decision_table[snr_bin(estimated_snr + d_olla_offset)];
+    }
+    mcs_id_t decision = explore(d_last_decision);
+    DTL_LOG_DEBUG("Get feedback for snr={}, olla_offset={}, decision={}",
+                  estimated_snr,
+                  d_olla_offset,
+                  (int)decision);
+    return d_feedback_lut[decision].second;
+}
+
+ofdm_adaptive_feedback_t
+ofdm_adaptive_link_adaptation::get_feedback(const effective_snr_t& effective_snr)
+{
+    // Effective SNR of each constellation of the lut, evaluated once
+    std::vector<double> snr(d_feedback_lut.size());
+    for (size_t m = 0; m < d_feedback_lut.size(); ++m) {
+        constellation_type_t cnst = d_feedback_lut[m].second.first;
+        if (m > 0 && cnst == d_feedback_lut[m - 1].second.first) {
+            snr[m] = snr[m - 1];
+        } else {
+            snr[m] = effective_snr(cnst);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    // Lowest MCS unless a higher one is strictly better
+    mcs_id_t best = -1;
+    double best_goodput = 0;
+    for (size_t m = 0; m < d_feedback_lut.size(); ++m) {
+        if (!std::isfinite(snr[m])) {
+            continue;
+        }
+        int b = snr_bin(snr[m] + d_olla_offset);
+        double goodput = d_efficiency[m] * (1 - d_bler[m * SNR_BINS + b]);
+        if (best < 0 || goodput > best_goodput) {
+            best = m;
+            best_goodput = goodput;
+        }
+    }
+    if (best >= 0) {
+        d_last_decision = best;
+    }
+    mcs_id_t decision = explore(d_last_decision);
+    DTL_LOG_DEBUG("Get feedback for effective snr, olla_offset={}, decision={}",
+                  d_olla_offset,
+                  (int)decision);
+    return d_feedback_lut[decision].second;
+}
+
+void ofdm_adaptive_link_adaptation::report_tb(ofdm_adaptive_feedback_t mcs,
+                                              double snr,
+                                              bool crc_ok)
+{
+    auto it = std::find_if(
+        d_feedback_lut.begin(),
+        d_feedback_lut.end(),
+        [&mcs](const std::pair<double, ofdm_adaptive_feedback_t>& entry) {
+            return entry.second == mcs;
+        });
+    if (it == d_feedback_lut.end()) {
+        DTL_LOG_DEBUG("report_tb: MCS ({}, {}) not in the lookup table",
+                      (int)mcs.first,
+                      (int)mcs.second);
+        return;
+    }
+    size_t m = it - d_feedback_lut.begin();
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (std::isfinite(snr)) {
+        float* bler = &d_bler[m * SNR_BINS];
+        int b = snr_bin(snr);
+        bler[b] += BLER_LEARNING_RATE * ((crc_ok ? 0.0f : 1.0f) - bler[b]);
+        // Keep the curve non increasing in SNR. It was before the update, so only
+        // the bins next to b up to the first one already in order change.
+        int end = b + 1;
+        for (; end < SNR_BINS && bler[end] > bler[b]; ++end) {
+            bler[end] = bler[b];
+        }
+        int begin = b;
+        for (; begin > 0 && bler[begin - 1] < bler[b]; --begin) {
+            bler[begin - 1] = bler[b];
+        }
+        // Only the decisions of the changed bins can differ
+        update_decision_table(begin, end);
+    }
+
+    d_olla_offset += crc_ok ? d_olla_step_up : -d_olla_step_down;
+    d_olla_offset = std::min(std::max(d_olla_offset, -OLLA_MAX_OFFSET), OLLA_MAX_OFFSET);
+}
+
+double ofdm_adaptive_link_adaptation::get_bler(mcs_id_t mcs_id, double snr) const
+{
+    if (mcs_id < 0 || mcs_id >= static_cast<mcs_id_t>(d_feedback_lut.size())) {
+        throw std::out_of_range("MCS is not in the lookup table");
+    }
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_bler[mcs_id * SNR_BINS + snr_bin(snr)];
+}
+
+double ofdm_adaptive_link_adaptation::get_olla_offset() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_olla_offset;
+}
+
 } /* namespace dtl */
 } /* namespace gr */
\ No newline at end of file
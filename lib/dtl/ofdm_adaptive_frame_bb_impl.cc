@@ -7,9 +7,10 @@
 
 
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <gnuradio/testbed/logger.h>
 #include "ofdm_adaptive_frame_bb_impl.h"
-#include <thread>
 
 namespace gr {
 namespace dtl {
@@ -65,9 +66,13 @@ ofdm_adaptive_frame_bb_impl::ofdm_adaptive_frame_bb_impl(
       d_frame_count(0),
       d_frame_in_bytes(0),
       d_consecutive_empty_frames(0),
-      d_frame_duration(std::chrono::duration<double>(1.0/frame_rate)),
+      d_clock(frame_clock::make(frame_rate)),
       d_feedback_cnst(constellation_type_t::UNKNOWN),
-      d_frame_capacity(n_payload_carriers * frame_len)
+      d_frame_capacity(n_payload_carriers * frame_len),
+      d_feedback_channel(nullptr),
+      d_header_channel(nullptr),
+      d_feedback_seq(0),
+      d_header_seq(0)
 {
     this->message_port_register_in(pmt::mp("feedback"));
     this->set_msg_handler(pmt::mp("feedback"),
@@ -130,6 +135,43 @@ void ofdm_adaptive_frame_bb_impl::process_feedback_header(pmt::pmt_t header_data
 }
 
 
+void ofdm_adaptive_frame_bb_impl::set_feedback_channel(mcs_channel::sptr channel)
+{
+    d_feedback_channel = channel;
+}
+
+void ofdm_adaptive_frame_bb_impl::set_header_channel(mcs_channel::sptr channel)
+{
+    d_header_channel = channel;
+}
+
+void ofdm_adaptive_frame_bb_impl::set_frame_clock(frame_clock::sptr clock)
+{
+    d_clock = clock;
+}
+
+void ofdm_adaptive_frame_bb_impl::set_padding_table(bool table)
+{
+    gr::thread::scoped_lock guard(d_setlock);
+    d_pad.use_table(table);
+}
+
+void ofdm_adaptive_frame_bb_impl::read_mcs_channels()
+{
+    // Same updates as the feedback and header messages
+    mcs_t mcs;
+    if (d_feedback_channel && d_feedback_channel->read(mcs, d_feedback_seq) &&
+        get_bits_per_symbol(mcs.constellation)) {
+        d_feedback_cnst = mcs.constellation;
+    }
+    if (d_header_channel && d_header_channel->read(mcs, d_header_seq) &&
+        get_bits_per_symbol(mcs.constellation)) {
+        d_constellation = mcs.constellation;
+        d_bps = get_bits_per_symbol(mcs.constellation);
+    }
+}
+
+
 void ofdm_adaptive_frame_bb_impl::forecast(int noutput_items,
                                            gr_vector_int& ninput_items_required)
 {
@@ -140,7 +182,7 @@ int ofdm_adaptive_frame_bb_impl::frame_out(const unsigned char* in,
                                             int nbytes_in,
                                             unsigned char* out,
                                             int nsyms_out,
-                                            repack& repacker)
+                                            fast_repack& repacker)
 {
 
     assert(nbytes_in <= d_frame_in_bytes);
@@ -155,10 +197,10 @@ int ofdm_adaptive_frame_bb_impl::frame_out(const unsigned char* in,
     bytes_read += d_crc.get_crc_len();
 
     // If frame not full...
-    if (bytes_read < d_frame_in_bytes) {
+    int frame_bytes = d_frame_in_bytes + d_crc.get_crc_len();
+    if (bytes_read < frame_bytes) {
         // ... pad with random bytes.
-        rand_pad(
-            &d_frame_buffer[bytes_read], d_frame_in_bytes - bytes_read, 8);
+        d_pad.fill(&d_frame_buffer[bytes_read], frame_bytes - bytes_read);
     }
     // Repack frame buffer and output
     int frame_out_symbols =
@@ -183,11 +225,11 @@ int ofdm_adaptive_frame_bb_impl::general_work(int noutput_items,
     auto in = static_cast<const unsigned char*>(input_items[0]);
     auto out = static_cast<unsigned char*>(output_items[0]);
 
-    auto expected_time = d_start_time + d_frame_count * d_frame_duration;
-    auto now = std::chrono::steady_clock::now();
-    if (now < expected_time) {
-        std::this_thread::sleep_until(expected_time);
-    }
+    // Frames whose slots have started, after waiting for the first one
+    int nframes = d_clock->wait(noutput_items);
+
+    // Latest decisions, after waiting for the frame slot
+    read_mcs_channels();
 
     DTL_LOG_DEBUG("work: d_frame_len={}, d_payload_carriers={}, "
                   "noutput_items={}, nitems_written={}, ninput_items={}",
@@ -198,21 +240,28 @@ int ofdm_adaptive_frame_bb_impl::general_work(int noutput_items,
                   ninput_items[0]);
 
 
-    if (noutput_items >= 1) {
+    if (nframes >= 1) {
 
         if (ninput_items[0] == 0) {
-            // Empty frame
+            // Empty frames
             if (d_max_empty_frames >= 0 && d_consecutive_empty_frames == d_max_empty_frames) {
                 return WORK_DONE;
             } else {
                 constellation_type_t cnst = d_constellation; // makes sure is the same constellation in this frame
                 unsigned char bps = get_bits_per_symbol(cnst);
-                rand_pad(
-                    out, d_frame_capacity, get_bits_per_symbol(cnst));
-                add_tags(0, d_frame_capacity, cnst);
-                ++d_consecutive_empty_frames;
-                ++d_frame_count;
-                return 1;
+                int produced = 0;
+                do {
+                    d_pad.fill_symbols(
+                        &out[produced * d_frame_capacity], d_frame_capacity, bps);
+                    add_tags(0, d_frame_capacity, cnst);
+                    ++d_consecutive_empty_frames;
+                    ++d_frame_count;
+                    ++produced;
+                } while (produced < nframes &&
+                         (d_max_empty_frames < 0 ||
+                          d_consecutive_empty_frames < d_max_empty_frames));
+                d_clock->advance(produced);
+                return produced;
             }
         } else {
             // Consume input
@@ -225,7 +274,7 @@ int ofdm_adaptive_frame_bb_impl::general_work(int noutput_items,
 
             d_consecutive_empty_frames = 0;
 
-            while (read_index < ninput_items[0] && produced < noutput_items && !wait_next_work) {
+            while (read_index < ninput_items[0] && produced < nframes && !wait_next_work) {
 
                 int frame_payload = -1;
 
@@ -234,7 +283,7 @@ int ofdm_adaptive_frame_bb_impl::general_work(int noutput_items,
                 // keep constellation during one frame or one TB (depending if FEC is present)
                 constellation_type_t cnst = d_constellation;
                 unsigned char bps = get_bits_per_symbol(cnst);
-                repack repacker(8, bps);
+                fast_repack repacker(8, bps);
 
                 // Leave room for CRC
                 d_frame_in_bytes =
@@ -274,13 +323,13 @@ int ofdm_adaptive_frame_bb_impl::general_work(int noutput_items,
                 assert(frame_out_symbols == frame_syms);
                 frame_payload = next_frame_nbytes;
                 read_index += next_frame_nbytes;
-                write_index += frame_out_symbols;
+                write_index += d_frame_capacity;
 
                 d_waiting_for_input = true;
 
                 // add tags
                 add_tags(frame_payload, frame_syms, cnst);
-                assert(d_tag_offset == nitems_written(0) + write_index/frame_syms);
+                assert(d_tag_offset == nitems_written(0) + write_index / d_frame_capacity);
 
                 produced_payload += frame_payload;
                 d_frame_store.store(frame_payload,
@@ -295,13 +344,11 @@ int ofdm_adaptive_frame_bb_impl::general_work(int noutput_items,
                 monitor_msg = pmt::dict_add(
                     monitor_msg, FRAME_COUNT_KEY, pmt::from_long(frame_payload));
                 message_port_pub(MONITOR_PORT, monitor_msg);
-                if (produced) {
-                    break;
-                }
             }
 
             DTL_LOG_DEBUG("work: consumed={}, produced={}, write_index={}, produced_payload={}", read_index, produced, write_index, produced_payload);
             consume_each(read_index);
+            d_clock->advance(produced);
             return produced;
         }
     } else {
@@ -347,27 +394,23 @@ void ofdm_adaptive_frame_bb_impl::add_tags(int payload, int frame_syms, constell
                                 payload_length_key(),
                                 pmt::from_long(0));
             }
+            if (d_clock->time_tags()) {
+                // Index and transmission time of the frame
+                add_item_tag(
+                    0, d_tag_offset, frame_index_key(), pmt::from_uint64(d_frame_count));
+                add_item_tag(0, d_tag_offset, tx_time_key(), d_clock->tx_time(d_frame_count));
+            }
             ++d_tag_offset;
 
 }
 
 
-void ofdm_adaptive_frame_bb_impl::rand_pad(unsigned char* buf,
-                                           size_t len,
-                                           int bps)
-{
-    std::uniform_int_distribution<> dist(0, pow(2, bps) - 1);
-    std::mt19937 gen(std::random_device{}());
-    for (unsigned int i = 0; i < len; ++i) {
-        buf[i] = dist(gen);
-    }
-}
-
 bool ofdm_adaptive_frame_bb_impl::start()
 {
     d_tag_offset = 0;
-    d_start_time = std::chrono::steady_clock::now();
+    d_clock->start();
     d_frame_count = 0;
+    d_pad.reset();
     return block::start();
 }
 
@@ -9,13 +9,12 @@
 #define INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_BB_IMPL_H
 
 
-#include <chrono>
 #include "crc_util.h"
 #include "frame_file_store.h"
 #include <gnuradio/dtl/ofdm_adaptive_frame_bb.h>
-#include <gnuradio/testbed/repack.h>
+#include <gnuradio/testbed/fast_repack.h>
+#include "pad_generator.h"
 #include "pdu_consumer.h"
-#include <random>
 
 
 namespace gr {
@@ -48,6 +47,10 @@ public:
                      gr_vector_void_star& output_items) override;
     bool start() override;
     void set_constellation(constellation_type_t constellation) override;
+    void set_feedback_channel(mcs_channel::sptr channel) override;
+    void set_header_channel(mcs_channel::sptr channel) override;
+    void set_frame_clock(frame_clock::sptr clock) override;
+    void set_padding_table(bool table) override;
 
 protected:
     void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
@@ -58,16 +61,16 @@ private:
                              size_t bits_per_symbol);
     size_t frame_length();
 
-    void rand_pad(unsigned char* buf, size_t len, int bps);
-
     int frame_out(const unsigned char* in,
                    int nbytes_in,
                    unsigned char* out,
                    int nsyms_out,
-                   repack& repacker);
+                   fast_repack& repacker);
 
     void add_tags(int payload, int frame_syms, constellation_type_t cnst);
 
+    void read_mcs_channels();
+
     constellation_type_t d_constellation;
     unsigned char d_fec_scheme;
     uint64_t d_tag_offset;
@@ -80,15 +83,19 @@ private:
     int d_max_empty_frames;
     crc_util d_crc;
     std::vector<unsigned char> d_frame_buffer;
+    pad_generator d_pad;
     unsigned long d_frame_count;
     frame_file_store d_frame_store;
     int d_frame_in_bytes;
     int d_consecutive_empty_frames;
-    std::chrono::time_point<std::chrono::steady_clock> d_start_time;
-    std::chrono::duration<double> d_frame_duration;
+    frame_clock::sptr d_clock;
     constellation_type_t d_feedback_cnst;
     int d_frame_capacity;
     pdu_consumer consumer;
+    mcs_channel::sptr d_feedback_channel;
+    mcs_channel::sptr d_header_channel;
+    uint64_t d_feedback_seq;
+    uint64_t d_header_seq;
 };
 
 } // namespace dtl
@@ -0,0 +1,346 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ofdm_adaptive_frame_bc_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/testbed/logger.h>
+#include <algorithm>
+#include <cstring>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+INIT_DTL_LOGGER("ofdm_adaptive_frame_bc")
+
+static const pmt::pmt_t FRAME_COUNT_KEY = pmt::mp("frame_count_key");
+static const pmt::pmt_t FRAME_PAYLOAD_KEY = pmt::mp("frame_payload_key");
+static const pmt::pmt_t MONITOR_PORT = pmt::mp("monitor");
+
+ofdm_adaptive_frame_bc::sptr
+ofdm_adaptive_frame_bc::make(const std::string& len_tag_key,
+                             const std::vector<constellation_type_t>& constellations,
+                             size_t frame_len,
+                             double frame_rate,
+                             size_t n_payload_carriers,
+                             std::string frames_fname,
+                             int max_empty_frames)
+{
+    return gnuradio::make_block_sptr<ofdm_adaptive_frame_bc_impl>(len_tag_key,
+                                                                  constellations,
+                                                                  frame_len,
+                                                                  frame_rate,
+                                                                  n_payload_carriers,
+                                                                  frames_fname,
+                                                                  max_empty_frames);
+}
+
+
+ofdm_adaptive_frame_bc_impl::ofdm_adaptive_frame_bc_impl(
+    const std::string& len_tag_key,
+    const std::vector<constellation_type_t>& constellations,
+    size_t frame_len,
+    double frame_rate,
+    size_t n_payload_carriers,
+    string frames_fname,
+    int max_empty_frames)
+    : block("ofdm_adaptive_frame_bc",
+            io_signature::make(1, 1, sizeof(char)),
+            io_signature::make2(1, 2, sizeof(gr_complex), sizeof(char))),
+      d_constellation(constellation_type_t::BPSK),
+      d_len_key(pmt::mp(len_tag_key)),
+      d_frame_len(frame_len),
+      d_payload_carriers(n_payload_carriers),
+      d_frame_capacity(n_payload_carriers * frame_len),
+      d_max_empty_frames(max_empty_frames),
+      d_crc(4, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF),
+      d_frame_count(0),
+      d_consecutive_empty_frames(0),
+      d_clock(frame_clock::make(frame_rate)),
+      d_feedback_cnst(constellation_type_t::UNKNOWN),
+      d_feedback_channel(nullptr),
+      d_header_channel(nullptr),
+      d_feedback_seq(0),
+      d_header_seq(0)
+{
+    this->message_port_register_in(pmt::mp("feedback"));
+    this->set_msg_handler(pmt::mp("feedback"),
+                          [this](pmt::pmt_t msg) { this->process_feedback(msg); });
+    this->message_port_register_in(pmt::mp("header"));
+    this->set_msg_handler(pmt::mp("header"),
+                          [this](pmt::pmt_t msg) { this->process_feedback_header(msg); });
+    message_port_register_out(MONITOR_PORT);
+
+    // Populate known constellations
+    for (const auto& constellation_type : constellations) {
+        auto constellation = create_constellation(constellation_type);
+        if (constellation == nullptr) {
+            throw std::invalid_argument("Unknown constellation");
+        }
+        size_t idx = static_cast<size_t>(constellation_type);
+        if (idx >= d_mappers.size()) {
+            d_mappers.resize(idx + 1);
+        }
+        d_mappers[idx] = std::make_unique<symbol_mapper>(constellation);
+    }
+
+    // A whole frame of the largest constellation, and the zero byte completing its
+    // last symbol
+    int max_bps = get_max_bps(constellations).second;
+    d_frame_buffer.resize((d_frame_capacity * max_bps + 7) / 8 + 1);
+    set_min_noutput_items(d_frame_capacity);
+    d_frame_store = frame_file_store(frames_fname);
+}
+
+void ofdm_adaptive_frame_bc_impl::process_feedback(pmt::pmt_t feedback)
+{
+    if (pmt::is_dict(feedback) &&
+        pmt::dict_has_key(feedback, feedback_constellation_key())) {
+        constellation_type_t constellation = static_cast<constellation_type_t>(
+            pmt::to_long(pmt::dict_ref(feedback,
+                                       feedback_constellation_key(),
+                                       pmt::from_long(static_cast<int>(
+                                           constellation_type_t::BPSK)))));
+        // Update constellation only if valid data received
+        if (get_bits_per_symbol(constellation)) {
+            d_feedback_cnst = constellation;
+        }
+    }
+    DTL_LOG_DEBUG("process_feedback: d_feedback_cnst={}",
+                  static_cast<int>(d_feedback_cnst));
+}
+
+void ofdm_adaptive_frame_bc_impl::process_feedback_header(pmt::pmt_t header_data)
+{
+    if (pmt::is_dict(header_data) &&
+        pmt::dict_has_key(header_data, feedback_constellation_key())) {
+        constellation_type_t constellation = static_cast<constellation_type_t>(
+            pmt::to_long(pmt::dict_ref(header_data,
+                                       feedback_constellation_key(),
+                                       pmt::from_long(static_cast<int>(
+                                           constellation_type_t::BPSK)))));
+        // Update constellation only if valid data received
+        if (get_bits_per_symbol(constellation)) {
+            d_constellation = constellation;
+        }
+    }
+    DTL_LOG_DEBUG("process_feedback_header: d_constellation={}",
+                  static_cast<int>(d_constellation));
+}
+
+void ofdm_adaptive_frame_bc_impl::set_feedback_channel(mcs_channel::sptr channel)
+{
+    d_feedback_channel = channel;
+}
+
+void ofdm_adaptive_frame_bc_impl::set_header_channel(mcs_channel::sptr channel)
+{
+    d_header_channel = channel;
+}
+
+void ofdm_adaptive_frame_bc_impl::set_frame_clock(frame_clock::sptr clock)
+{
+    d_clock = clock;
+}
+
+void ofdm_adaptive_frame_bc_impl::set_padding_table(bool table)
+{
+    gr::thread::scoped_lock guard(d_setlock);
+    d_pad.use_table(table);
+}
+
+void ofdm_adaptive_frame_bc_impl::read_mcs_channels()
+{
+    // Same updates as the feedback and header messages
+    mcs_t mcs;
+    if (d_feedback_channel && d_feedback_channel->read(mcs, d_feedback_seq) &&
+        get_bits_per_symbol(mcs.constellation)) {
+        d_feedback_cnst = mcs.constellation;
+    }
+    if (d_header_channel && d_header_channel->read(mcs, d_header_seq) &&
+        get_bits_per_symbol(mcs.constellation)) {
+        d_constellation = mcs.constellation;
+    }
+}
+
+void ofdm_adaptive_frame_bc_impl::forecast(int noutput_items,
+                                           gr_vector_int& ninput_items_required)
+{
+    ninput_items_required[0] = 0;
+}
+
+void ofdm_adaptive_frame_bc_impl::map_frame(const symbol_mapper& mapper,
+                                            int nbytes,
+                                            int nsyms,
+                                            int offset,
+                                            gr_vector_void_star& output_items)
+{
+    // The bits of the last symbol past the frame are zero, as after a repack
+    d_frame_buffer[nbytes] = 0;
+    mapper.map_packed(d_frame_buffer.data(),
+                      nsyms,
+                      static_cast<gr_complex*>(output_items[0]) + offset);
+    if (output_items.size() > 1) {
+        memset(static_cast<char*>(output_items[1]) + offset, 0, nsyms);
+    }
+}
+
+int ofdm_adaptive_frame_bc_impl::general_work(int noutput_items,
+                                              gr_vector_int& ninput_items,
+                                              gr_vector_const_void_star& input_items,
+                                              gr_vector_void_star& output_items)
+{
+    gr::thread::scoped_lock guard(d_setlock);
+
+    auto in = static_cast<const unsigned char*>(input_items[0]);
+
+    // Frames whose slots have started and fit in the output, after waiting for the
+    // first one
+    int nframes = d_clock->wait(noutput_items / d_frame_capacity);
+
+    // Latest decisions, after waiting for the frame slot
+    read_mcs_channels();
+
+    if (nframes < 1) {
+        return 0;
+    }
+
+    // Keep the constellation during the frames of this call
+    constellation_type_t cnst = d_constellation;
+    size_t cnst_idx = static_cast<size_t>(cnst);
+    if (cnst_idx >= d_mappers.size() || !d_mappers[cnst_idx]) {
+        throw runtime_error("constellation was not set correctly");
+    }
+    const symbol_mapper& mapper = *d_mappers[cnst_idx];
+    int bps = mapper.bits_per_symbol();
+
+    if (ninput_items[0] == 0) {
+        // Empty frames
+        if (d_max_empty_frames >= 0 &&
+            d_consecutive_empty_frames == d_max_empty_frames) {
+            return WORK_DONE;
+        }
+        int nbytes = (d_frame_capacity * bps + 7) / 8;
+        int produced = 0;
+        do {
+            d_pad.fill(d_frame_buffer.data(), nbytes);
+            map_frame(mapper, nbytes, d_frame_capacity, produced, output_items);
+            add_tags(nitems_written(0) + produced,
+                     0,
+                     d_frame_capacity,
+                     cnst,
+                     output_items.size());
+            produced += d_frame_capacity;
+            ++d_consecutive_empty_frames;
+            ++d_frame_count;
+        } while (produced < nframes * d_frame_capacity &&
+                 (d_max_empty_frames < 0 ||
+                  d_consecutive_empty_frames < d_max_empty_frames));
+        d_clock->advance(produced / d_frame_capacity);
+        return produced;
+    }
+
+    // Payload, CRC and padding bytes of a frame, as ofdm_adaptive_frame_bb
+    int frame_bytes = d_frame_capacity * bps / 8;
+    int frame_in_bytes = frame_bytes - d_crc.get_crc_len();
+    int frame_syms = (frame_bytes * 8 + bps - 1) / bps;
+
+    int read_index = 0;
+    int produced = 0;
+    int nframes_out = 0;
+    while (read_index < ninput_items[0] && nframes_out < nframes) {
+        int nbytes_in = d_consumer.advance(
+            ninput_items[0], frame_in_bytes, read_index, [this](int offset) {
+                this->get_tags_in_window(d_tags, 0, offset, offset + 1);
+                auto len_tag = find_tag(d_tags, d_len_key);
+                if (len_tag == d_tags.end()) {
+                    return std::optional<tag_t>{};
+                }
+                return std::optional<tag_t>(*len_tag);
+            });
+
+        memcpy(d_frame_buffer.data(), &in[read_index], nbytes_in);
+        d_crc.append_crc(d_frame_buffer.data(), nbytes_in);
+        int nbytes = nbytes_in + d_crc.get_crc_len();
+        d_pad.fill(&d_frame_buffer[nbytes], frame_bytes - nbytes);
+        map_frame(mapper, frame_bytes, frame_syms, produced, output_items);
+
+        add_tags(nitems_written(0) + produced,
+                 nbytes_in,
+                 frame_syms,
+                 cnst,
+                 output_items.size());
+        d_frame_store.store(nbytes_in,
+                            d_frame_count & 0xFFF,
+                            reinterpret_cast<char*>(d_frame_buffer.data()));
+        d_consecutive_empty_frames = 0;
+        ++d_frame_count;
+
+        pmt::pmt_t monitor_msg = pmt::make_dict();
+        monitor_msg =
+            pmt::dict_add(monitor_msg, FRAME_COUNT_KEY, pmt::from_long(d_frame_count));
+        monitor_msg =
+            pmt::dict_add(monitor_msg, FRAME_PAYLOAD_KEY, pmt::from_long(nbytes_in));
+        message_port_pub(MONITOR_PORT, monitor_msg);
+
+        read_index += nbytes_in;
+        produced += frame_syms;
+        ++nframes_out;
+    }
+
+    DTL_LOG_DEBUG("work: consumed={}, frames={}, produced={}, constellation={}",
+                  read_index,
+                  nframes_out,
+                  produced,
+                  static_cast<int>(cnst));
+    consume_each(read_index);
+    d_clock->advance(nframes_out);
+    return produced;
+}
+
+void ofdm_adaptive_frame_bc_impl::add_tags(uint64_t offset,
+                                           int payload,
+                                           int frame_syms,
+                                           constellation_type_t cnst,
+                                           int noutputs)
+{
+    // Frame length in symbols, constellation, feedback and transported payload
+    // bytes including the CRC, if any
+    pmt::pmt_t len = pmt::from_long(frame_syms);
+    pmt::pmt_t constellation = pmt::from_long(static_cast<int>(cnst));
+    pmt::pmt_t feedback = pmt::from_long(static_cast<int>(d_feedback_cnst) & 0xf);
+    pmt::pmt_t payload_len =
+        pmt::from_long(payload ? payload + d_crc.get_crc_len() : 0);
+    for (int i = 0; i < noutputs; ++i) {
+        add_item_tag(i, offset, d_len_key, len);
+        add_item_tag(i, offset, get_constellation_tag_key(), constellation);
+        add_item_tag(i, offset, feedback_constellation_key(), feedback);
+        add_item_tag(i, offset, payload_length_key(), payload_len);
+    }
+    if (d_clock->time_tags()) {
+        // Index and transmission time of the frame, on the payload symbols
+        add_item_tag(0, offset, frame_index_key(), pmt::from_uint64(d_frame_count));
+        add_item_tag(0, offset, tx_time_key(), d_clock->tx_time(d_frame_count));
+    }
+}
+
+bool ofdm_adaptive_frame_bc_impl::start()
+{
+    d_clock->start();
+    d_frame_count = 0;
+    d_pad.reset();
+    return block::start();
+}
+
+void ofdm_adaptive_frame_bc_impl::set_constellation(constellation_type_t constellation)
+{
+    d_constellation = constellation;
+}
+
+} /* namespace dtl */
+} /* namespace gr */
@@ -0,0 +1,97 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_BC_IMPL_H
+#define INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_BC_IMPL_H
+
+#include "crc_util.h"
+#include "frame_file_store.h"
+#include "pad_generator.h"
+#include "pdu_consumer.h"
+#include "symbol_mapper.h"
+#include <gnuradio/dtl/ofdm_adaptive_frame_bc.h>
+#include <memory>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+class ofdm_adaptive_frame_bc_impl : public ofdm_adaptive_frame_bc
+{
+public:
+    ofdm_adaptive_frame_bc_impl(const std::string& len_tag_key,
+                                const std::vector<constellation_type_t>& constellations,
+                                size_t frame_len,
+                                double frame_rate,
+                                size_t n_payload_carriers,
+                                std::string frames_fname,
+                                int max_empty_frames);
+
+    void process_feedback(pmt::pmt_t feedback);
+
+    void process_feedback_header(pmt::pmt_t header_data);
+
+    int general_work(int noutput_items,
+                     gr_vector_int& ninput_items,
+                     gr_vector_const_void_star& input_items,
+                     gr_vector_void_star& output_items) override;
+    bool start() override;
+    void set_constellation(constellation_type_t constellation) override;
+    void set_feedback_channel(mcs_channel::sptr channel) override;
+    void set_header_channel(mcs_channel::sptr channel) override;
+    void set_frame_clock(frame_clock::sptr clock) override;
+    void set_padding_table(bool table) override;
+
+protected:
+    void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+
+private:
+    // Maps the nbytes of the frame buffer to nsyms symbols of the mapper, at
+    // offset of the outputs
+    void map_frame(const symbol_mapper& mapper,
+                   int nbytes,
+                   int nsyms,
+                   int offset,
+                   gr_vector_void_star& output_items);
+
+    void add_tags(uint64_t offset,
+                  int payload,
+                  int frame_syms,
+                  constellation_type_t cnst,
+                  int noutputs);
+
+    void read_mcs_channels();
+
+    constellation_type_t d_constellation;
+    pmt::pmt_t d_len_key;
+    int d_frame_len;
+    int d_payload_carriers;
+    int d_frame_capacity;
+    int d_max_empty_frames;
+    crc_util d_crc;
+    // Payload, CRC and padding of a frame, packed
+    std::vector<unsigned char> d_frame_buffer;
+    // Mapper of each known constellation, indexed by constellation_type_t
+    std::vector<std::unique_ptr<symbol_mapper>> d_mappers;
+    pad_generator d_pad;
+    unsigned long d_frame_count;
+    frame_file_store d_frame_store;
+    int d_consecutive_empty_frames;
+    frame_clock::sptr d_clock;
+    constellation_type_t d_feedback_cnst;
+    pdu_consumer d_consumer;
+    std::vector<tag_t> d_tags;
+    mcs_channel::sptr d_feedback_channel;
+    mcs_channel::sptr d_header_channel;
+    uint64_t d_feedback_seq;
+    uint64_t d_header_seq;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_OFDM_ADAPTIVE_FRAME_BC_IMPL_H */
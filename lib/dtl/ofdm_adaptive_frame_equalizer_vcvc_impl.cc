@@ -25,7 +25,10 @@ using namespace std;
 static const pmt::pmt_t CARR_OFFSET_KEY = pmt::mp("ofdm_sync_carr_offset");
 static const pmt::pmt_t CHAN_TAPS_KEY = pmt::mp("ofdm_sync_chan_taps");
 static const pmt::pmt_t FEEDBACK_PORT = pmt::mp("feedback_port");
+static const pmt::pmt_t FEEDBACK_PDU_PORT = pmt::mp("feedback_pdu");
 static const pmt::pmt_t MONITOR_PORT = pmt::mp("monitor");
+// Unchanged feedback is published again after this many frames
+static const int FEEDBACK_REFRESH_FRAMES = 32;
 
 
 ofdm_adaptive_frame_equalizer_vcvc::sptr ofdm_adaptive_frame_equalizer_vcvc::make(
@@ -68,7 +71,13 @@ ofdm_adaptive_frame_equalizer_vcvc_impl::ofdm_adaptive_frame_equalizer_vcvc_impl
       d_channel_state(equalizer->fft_len(), gr_complex(1, 0)),
       d_decision_feedback(feedback_decision),
       d_propagate_feedback_tags(propagate_feedback_tags),
+      d_length_tag_key(pmt::string_to_symbol(len_tag_key)),
       d_frame_no_key(pmt::string_to_symbol(frame_no_key)),
+      d_feedback(constellation_type_t::UNKNOWN, 0),
+      d_feedback_constellation(pmt::PMT_NIL),
+      d_feedback_fec(pmt::PMT_NIL),
+      d_feedback_age(-1),
+      d_feedback_channel(nullptr),
       d_expected_frame_no(0),
       d_lost_frames(0),
       d_frames_count(0)
@@ -80,17 +89,24 @@ ofdm_adaptive_frame_equalizer_vcvc_impl::ofdm_adaptive_frame_equalizer_vcvc_impl
     set_tag_propagation_policy(TPP_DONT);
 
     message_port_register_out(FEEDBACK_PORT);
+    message_port_register_out(FEEDBACK_PDU_PORT);
     message_port_register_out(MONITOR_PORT);
 }
 
 ofdm_adaptive_frame_equalizer_vcvc_impl::~ofdm_adaptive_frame_equalizer_vcvc_impl() {}
 
+void ofdm_adaptive_frame_equalizer_vcvc_impl::set_feedback_channel(
+    mcs_channel::sptr channel)
+{
+    d_feedback_channel = channel;
+}
+
 void ofdm_adaptive_frame_equalizer_vcvc_impl::parse_length_tags(
     const std::vector<std::vector<tag_t>>& tags, gr_vector_int& n_input_items_reqd)
 {
 
     for (unsigned k = 0; k < tags[0].size(); k++) {
-        if (tags[0][k].key == pmt::string_to_symbol(d_length_tag_key_str)) {
+        if (tags[0][k].key == d_length_tag_key) {
             n_input_items_reqd[0] = pmt::to_long(tags[0][k].value);
         }
     }
@@ -111,11 +127,13 @@ int ofdm_adaptive_frame_equalizer_vcvc_impl::work(int noutput_items,
     int payload = 0;
     int current_frame_no = 0;
 
-    std::vector<tag_t> tags;
+    std::vector<tag_t>& tags = d_tags;
     get_tags_in_window(tags, 0, 0, 1);
     for (unsigned i = 0, test = 0; i < tags.size() && test != 15; i++) {
         if (tags[i].key == CHAN_TAPS_KEY) {
-            d_channel_state = pmt::c32vector_elements(tags[i].value);
+            size_t n_taps = 0;
+            const gr_complex* taps = pmt::c32vector_elements(tags[i].value, n_taps);
+            d_channel_state.assign(taps, taps + n_taps);
             test |= 1;
         } else if (tags[i].key == CARR_OFFSET_KEY) {
             carrier_offset = pmt::to_long(tags[i].value);
@@ -184,6 +202,7 @@ int ofdm_adaptive_frame_equalizer_vcvc_impl::work(int noutput_items,
         d_logger->error(e.what());
     }
     d_eq->get_channel_state(d_channel_state);
+    d_eq->get_carrier_snr(d_carrier_snr);
 
     // Update the channel state regarding the frequency offset
     phase_correction =
@@ -192,61 +211,85 @@ int ofdm_adaptive_frame_equalizer_vcvc_impl::work(int noutput_items,
         d_channel_state[k] *= phase_correction;
     }
 
-    // Publish decided constellation to decision feedback port.
-    ofdm_adaptive_feedback_t feedback = d_decision_feedback->get_feedback(d_eq->get_snr());
-    pmt::pmt_t feedback_msg = pmt::dict_add(
-        pmt::make_dict(),
-        feedback_constellation_key(),
-        pmt::from_long(static_cast<unsigned char>(feedback.first))
-    );
-    feedback_msg = pmt::dict_add(
-        feedback_msg,
-        fec_feedback_key(),
-        pmt::from_long(feedback.second)
-    );
-
-    message_port_pub(FEEDBACK_PORT, feedback_msg);
-
-    pmt::pmt_t msg = msg_builder.build_any(
-        make_pair("constellation_key", static_cast<unsigned char>(feedback.first)),
-        make_pair("fec_key", feedback.second),
-        make_pair("estimated_snr_tag_key", d_eq->get_snr()),
-        make_pair("noise_tag_key", d_eq->get_noise()),
-        make_pair("lost_frames_rate", 100*(double)d_lost_frames/d_frames_count));
-    message_port_pub(MONITOR_PORT, msg);
+    // Publish decided constellation to decision feedback port when it changes, and
+    // periodically in case a feedback transmission got lost. Each MCS is decided on
+    // the effective SNR of its constellation.
+    ofdm_adaptive_feedback_t feedback = d_decision_feedback->get_feedback(
+        [this](constellation_type_t cnst) { return d_eq->get_effective_snr(cnst); });
+    if (feedback != d_feedback || d_feedback_age < 0) {
+        d_feedback = feedback;
+        d_feedback_constellation =
+            pmt::from_long(static_cast<unsigned char>(feedback.first));
+        d_feedback_fec = pmt::from_long(feedback.second);
+        d_feedback_age = 0;
+    }
+    if (d_feedback_channel) {
+        d_feedback_channel->publish(feedback.first, feedback.second, d_eq->get_snr());
+    }
+    if (d_feedback_age == 0 && !pmt::is_null(message_subscribers(FEEDBACK_PORT))) {
+        pmt::pmt_t feedback_msg = pmt::dict_add(
+            pmt::make_dict(), feedback_constellation_key(), d_feedback_constellation);
+        feedback_msg = pmt::dict_add(feedback_msg, fec_feedback_key(), d_feedback_fec);
+        message_port_pub(FEEDBACK_PORT, feedback_msg);
+    }
+    if (d_feedback_age == 0 && !pmt::is_null(message_subscribers(FEEDBACK_PDU_PORT))) {
+        pmt::pmt_t vec = pmt::make_u8vector(2, 0);
+        pmt::u8vector_set(vec, 0, static_cast<uint8_t>(feedback.first));
+        pmt::u8vector_set(vec, 1, feedback.second);
+        message_port_pub(FEEDBACK_PDU_PORT, pmt::cons(pmt::PMT_NIL, vec));
+    }
+    d_feedback_age = (d_feedback_age + 1) % FEEDBACK_REFRESH_FRAMES;
+
+    if (!pmt::is_null(message_subscribers(MONITOR_PORT))) {
+        pmt::pmt_t msg = msg_builder.build_any(
+            make_pair("constellation_key", static_cast<unsigned char>(feedback.first)),
+            make_pair("fec_key", feedback.second),
+            make_pair("estimated_snr_tag_key", d_eq->get_snr()),
+            make_pair("noise_tag_key", d_eq->get_noise()),
+            make_pair("lost_frames_rate", 100*(double)d_lost_frames/d_frames_count));
+        message_port_pub(MONITOR_PORT, msg);
+    }
 
     if (payload) {
+        // Per carrier SNR for the LLR scaling of the soft demapper, soft output only
+        pmt::pmt_t carrier_snr = d_carrier_snr_pool.f32vector(d_carrier_snr);
+        pmt::pmt_t channel_state = pmt::PMT_NIL;
+        if (d_propagate_channel_state) {
+            channel_state = d_channel_state_pool.c32vector(d_channel_state);
+        }
+        pmt::pmt_t noise = pmt::from_double(d_eq->get_noise());
+        pmt::pmt_t estimated_snr = pmt::from_double(d_eq->get_snr());
+        // The FEC decoder reports the TB outcomes at the effective SNR of the frame
+        pmt::pmt_t effective_snr = pmt::from_double(
+            d_eq->get_effective_snr(get_constellation_type(*cnst_tag_it)));
         for (int oi=0; oi<2; ++oi) {
             // Propagate tags (except for the channel state and the TSB tag)
             for (size_t i = 0; i < tags.size(); i++) {
-                if (tags[i].key != CHAN_TAPS_KEY &&
-                    tags[i].key != pmt::mp(d_length_tag_key_str)) {
+                if (tags[i].key != CHAN_TAPS_KEY && tags[i].key != d_length_tag_key) {
                     add_item_tag(oi, nitems_written(0), tags[i].key, tags[i].value);
                 }
             }
 
             // Housekeeping
             if (d_propagate_channel_state) {
-                add_item_tag(oi,
-                            nitems_written(0),
-                            CHAN_TAPS_KEY,
-                            pmt::init_c32vector(d_fft_len, d_channel_state));
+                add_item_tag(oi, nitems_written(0), CHAN_TAPS_KEY, channel_state);
+            }
+            add_item_tag(oi, nitems_written(0), noise_tag_key(), noise);
+            if (oi == 1) {
+                add_item_tag(oi, nitems_written(0), carrier_snr_tag_key(), carrier_snr);
+                if (!d_propagate_feedback_tags) {
+                    add_item_tag(
+                        oi, nitems_written(0), estimated_snr_tag_key(), effective_snr);
+                }
             }
-            add_item_tag(oi,
-                            nitems_written(0),
-                            noise_tag_key(),
-                            pmt::from_double(d_eq->get_noise()));
             // Propagate feedback via tags
             if (d_propagate_feedback_tags) {
-                add_item_tag(oi,
-                            nitems_written(0),
-                            estimated_snr_tag_key(),
-                            pmt::from_double(d_eq->get_snr()));
+                add_item_tag(oi, nitems_written(0), estimated_snr_tag_key(), estimated_snr);
                 add_item_tag(oi,
                             nitems_written(0),
                             feedback_constellation_key(),
-                            pmt::from_long(static_cast<unsigned char>(feedback.first)));
-                add_item_tag(oi, nitems_written(0), fec_feedback_key(), pmt::from_long(feedback.second));
+                            d_feedback_constellation);
+                add_item_tag(oi, nitems_written(0), fec_feedback_key(), d_feedback_fec);
             }
         }
         return n_ofdm_sym;
@@ -10,6 +10,7 @@
 
 #include <gnuradio/dtl/ofdm_adaptive_frame_equalizer_vcvc.h>
 #include "ofdm_adaptive_monitor.h"
+#include "pmt_vector_pool.h"
 
 namespace gr {
 namespace dtl {
@@ -22,9 +23,20 @@ private:
     gr::dtl::ofdm_adaptive_equalizer_base::sptr d_eq;
     bool d_propagate_channel_state;
     std::vector<gr_complex> d_channel_state;
+    std::vector<float> d_carrier_snr;
     ofdm_adaptive_feedback_decision_base::sptr d_decision_feedback;
     bool d_propagate_feedback_tags;
+    pmt::pmt_t d_length_tag_key;
     pmt::pmt_t d_frame_no_key;
+    std::vector<tag_t> d_tags;
+    pmt_vector_pool d_channel_state_pool;
+    pmt_vector_pool d_carrier_snr_pool;
+    // Last published feedback and its tag values
+    ofdm_adaptive_feedback_t d_feedback;
+    pmt::pmt_t d_feedback_constellation;
+    pmt::pmt_t d_feedback_fec;
+    int d_feedback_age;
+    mcs_channel::sptr d_feedback_channel;
     int d_expected_frame_no;
     long d_lost_frames;
     long d_frames_count;
@@ -45,6 +57,8 @@ public:
         bool propagate_feedback_tags);
     ~ofdm_adaptive_frame_equalizer_vcvc_impl() override;
 
+    void set_feedback_channel(mcs_channel::sptr channel) override;
+
     int work(int noutput_items,
              gr_vector_int& ninput_items,
              gr_vector_const_void_star& input_items,
@@ -65,7 +65,7 @@ void ofdm_adaptive_frame_pack_bb_impl::parse_length_tags(
     if (constellation_type_t::UNKNOWN != constellation_type) {
         d_bits_per_symbol = get_bits_per_symbol(constellation_type);
         set_relative_rate(d_bits_per_symbol, 8);
-        d_repacker = repack(d_bits_per_symbol, 8);
+        d_repacker = fast_repack(d_bits_per_symbol, 8);
     }
 }
 
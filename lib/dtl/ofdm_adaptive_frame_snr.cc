@@ -0,0 +1,217 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/dtl/ofdm_adaptive_frame_snr.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+// SNR grid of the EESM tables: 16 steps per octave from 2^-8 (-24 dB) to 2^16
+// (48 dB). The grid index of a float is its biased exponent followed by its 4
+// high mantissa bits, so no logarithm is needed.
+static const int GRID_STEP_BITS = 4;
+static const int GRID_MIN_EXP = -8;
+static const int GRID_SIZE = 24 << GRID_STEP_BITS;
+static const int GRID_OFFSET = (127 + GRID_MIN_EXP) << GRID_STEP_BITS;
+
+static const map<constellation_type_t, double> DEFAULT_BETA = {
+    { constellation_type_t::BPSK, 1.0 },
+    { constellation_type_t::QPSK, 1.6 },
+    { constellation_type_t::PSK8, 3.2 },
+    { constellation_type_t::QAM16, 6.5 },
+};
+
+// Lanes of the sums, for the loops to vectorize without reassociation
+static const int LANES = 8;
+
+static double grid_snr(int idx)
+{
+    int steps = 1 << GRID_STEP_BITS;
+    double mantissa = 1 + ((idx % steps) + 0.5) / steps;
+    return ldexp(mantissa, GRID_MIN_EXP + idx / steps);
+}
+
+ofdm_adaptive_frame_snr_eesm::sptr
+ofdm_adaptive_frame_snr_eesm::make(const map<constellation_type_t, double>& beta)
+{
+    return make_shared<ofdm_adaptive_frame_snr_eesm>(beta);
+}
+
+ofdm_adaptive_frame_snr_eesm::ofdm_adaptive_frame_snr_eesm(
+    const map<constellation_type_t, double>& beta)
+    : d_error(0), d_eq_error(0), d_snr(0), d_estimated(true)
+{
+    map<constellation_type_t, double> betas = beta;
+    betas.insert(DEFAULT_BETA.begin(), DEFAULT_BETA.end());
+    for (auto& b : betas) {
+        if (b.second <= 0) {
+            throw invalid_argument("EESM beta must be positive");
+        }
+        eesm_table_t& table = d_tables[b.first];
+        table.beta = b.second;
+        table.exp_snr.resize(GRID_SIZE);
+        for (int i = 0; i < GRID_SIZE; i++) {
+            table.exp_snr[i] = exp(-grid_snr(i) / b.second);
+        }
+        table.effective_snr = 0;
+    }
+}
+
+int ofdm_adaptive_frame_snr_eesm::update(int noutput_items, const gr_complex* input)
+{
+    return noutput_items;
+}
+
+void ofdm_adaptive_frame_snr_eesm::update_carriers(int n,
+                                                   const float* gain,
+                                                   const float* eq_re,
+                                                   const float* eq_im,
+                                                   const float* est_re,
+                                                   const float* est_im)
+{
+    size_t offset = d_gain.size();
+    d_gain.resize(offset + n);
+    memcpy(&d_gain[offset], gain, n * sizeof(float));
+
+    float error[LANES] = {};
+    float eq_error[LANES] = {};
+    int j = 0;
+    for (; j + LANES <= n; j += LANES) {
+        for (int l = 0; l < LANES; l++) {
+            float dr = eq_re[j + l] - est_re[j + l];
+            float di = eq_im[j + l] - est_im[j + l];
+            float e = dr * dr + di * di;
+            eq_error[l] += e;
+            error[l] += gain[j + l] * e;
+        }
+    }
+    for (; j < n; j++) {
+        float dr = eq_re[j] - est_re[j];
+        float di = eq_im[j] - est_im[j];
+        float e = dr * dr + di * di;
+        eq_error[0] += e;
+        error[0] += gain[j] * e;
+    }
+    for (int l = 0; l < LANES; l++) {
+        d_error += error[l];
+        d_eq_error += eq_error[l];
+    }
+    d_estimated = false;
+}
+
+void ofdm_adaptive_frame_snr_eesm::reset()
+{
+    // Keeps the capacity of the buffers
+    d_gain.clear();
+    d_error = 0;
+    d_eq_error = 0;
+    d_snr = 0;
+    d_estimated = true;
+    for (auto& table : d_tables) {
+        table.second.effective_snr = 0;
+    }
+}
+
+void ofdm_adaptive_frame_snr_eesm::estimate()
+{
+    d_estimated = true;
+    int n = d_gain.size();
+    if (n == 0) {
+        return;
+    }
+    double sigma2 = max(d_error / n, static_cast<double>(numeric_limits<float>::min()));
+    float inv_sigma2 = 1 / sigma2;
+
+    // SNR of the resource elements and their grid index
+    d_grid_idx.resize(n);
+    float snr_sum[LANES] = {};
+    int i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        for (int l = 0; l < LANES; l++) {
+            float snr = d_gain[i + l] * inv_sigma2;
+            uint32_t bits;
+            memcpy(&bits, &snr, sizeof(bits));
+            int idx = static_cast<int>(bits >> (23 - GRID_STEP_BITS)) - GRID_OFFSET;
+            d_grid_idx[i + l] = min(max(idx, 0), GRID_SIZE - 1);
+            snr_sum[l] += snr;
+        }
+    }
+    for (; i < n; i++) {
+        float snr = d_gain[i] * inv_sigma2;
+        uint32_t bits;
+        memcpy(&bits, &snr, sizeof(bits));
+        int idx = static_cast<int>(bits >> (23 - GRID_STEP_BITS)) - GRID_OFFSET;
+        d_grid_idx[i] = min(max(idx, 0), GRID_SIZE - 1);
+        snr_sum[0] += snr;
+    }
+    double mean_snr = 0;
+    for (int l = 0; l < LANES; l++) {
+        mean_snr += snr_sum[l];
+    }
+    d_snr = 10 * log10(max(mean_snr / n, numeric_limits<double>::min()));
+
+    for (auto& t : d_tables) {
+        eesm_table_t& table = t.second;
+        const double* exp_snr = table.exp_snr.data();
+        double sum[LANES] = {};
+        i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            for (int l = 0; l < LANES; l++) {
+                sum[l] += exp_snr[d_grid_idx[i + l]];
+            }
+        }
+        for (; i < n; i++) {
+            sum[0] += exp_snr[d_grid_idx[i]];
+        }
+        double mean = 0;
+        for (int l = 0; l < LANES; l++) {
+            mean += sum[l];
+        }
+        mean = max(mean / n, numeric_limits<double>::min());
+        double effective_snr = -table.beta * log(mean);
+        table.effective_snr =
+            10 * log10(max(effective_snr, numeric_limits<double>::min()));
+    }
+}
+
+double ofdm_adaptive_frame_snr_eesm::snr()
+{
+    if (!d_estimated) {
+        estimate();
+    }
+    return d_snr;
+}
+
+double ofdm_adaptive_frame_snr_eesm::noise()
+{
+    if (d_gain.empty()) {
+        return 0;
+    }
+    return 10 * log10(max(d_eq_error / d_gain.size(), numeric_limits<double>::min()));
+}
+
+double ofdm_adaptive_frame_snr_eesm::effective_snr(constellation_type_t constellation)
+{
+    if (!d_estimated) {
+        estimate();
+    }
+    auto it = d_tables.find(constellation);
+    if (it == d_tables.end()) {
+        return d_snr;
+    }
+    return it->second.effective_snr;
+}
+
+} // namespace dtl
+} // namespace gr
@@ -70,7 +70,8 @@ ofdm_adaptive_packet_header::ofdm_adaptive_packet_header(
       d_payload_syms(payload_syms),
       d_has_fec(has_fec),
       d_crc(16, 0x1021, 0xFFFF, 0, false, true),
-      d_crc_len(16)
+      d_crc_len(16),
+      d_header_channel(nullptr)
 {
 }
 
@@ -90,18 +91,24 @@ int ofdm_adaptive_packet_header::add_header_field(unsigned char* buf,
 }
 
 
-void ofdm_adaptive_packet_header::pack_crc(const unsigned char* header_bits, vector<unsigned char>& crc_buf)
+unsigned ofdm_adaptive_packet_header::header_crc(const unsigned char* header_bits) const
 {
-    int len = (d_header_len - d_crc_len) / 8;
-    if ((d_header_len - d_crc_len) % 8) {
-        ++len;
-    }
-    crc_buf.resize(len, 0);
-    for (int i=0; i<len; ++i) {
-        for (int j=0; j<8 && i*len+j < d_header_len; j++) {
-            crc_buf[i] = (crc_buf[i] << 1) | (header_bits[i*8+j] & 0x01);
-       }
+    // The CRC covers the header bits packed MSB first to ceil(n / 8) bytes, n the
+    // bits before the CRC, with byte i only taking bit j while i * nbytes + j is
+    // within the header: the last bytes of the FEC header are partially filled,
+    // right aligned. Kept bit exact with former releases, so the packing is
+    // replayed as a bit stream instead of building the bytes.
+    static const unsigned char zeros[8] = { 0 };
+    const int nbytes = (d_header_len - d_crc_len + 7) / 8;
+    const int nfull = min(nbytes, max(0, (d_header_len - 8) / nbytes + 1));
+
+    uint32_t rem = d_crc.update_bits(d_crc.start(), header_bits, 8 * nfull);
+    for (int i = nfull; i < nbytes; ++i) {
+        int m = min(8, max(0, d_header_len - i * nbytes));
+        rem = d_crc.update_bits(rem, zeros, 8 - m);
+        rem = d_crc.update_bits(rem, &header_bits[i * 8], m);
     }
+    return d_crc.finish(rem);
 }
 
 
@@ -181,9 +188,7 @@ bool ofdm_adaptive_packet_header::header_formatter(long packet_len,
 
     // Compute CRC and insert (Bit 32-47 (short header) / bit 88-103 (long header): 16
     // bits)
-    vector<unsigned char> buffer_crc;
-    pack_crc(out, buffer_crc);
-    unsigned crc = d_crc.compute(&buffer_crc[0], buffer_crc.size());
+    unsigned crc = header_crc(out);
     k = add_header_field(out, k, crc, 16);
 
     // Incement packet number
@@ -255,10 +260,7 @@ bool ofdm_adaptive_packet_header::header_parser(const unsigned char* in,
         k = parse_fec_header(in, k, tags);
     }
 
-    vector<unsigned char> buffer;
-    pack_crc(in, buffer);
-
-    unsigned crc_calcd = d_crc.compute(&buffer[0], buffer.size());
+    unsigned crc_calcd = header_crc(in);
     for (int i = 0; i < 16 && k < d_header_len; i += d_bits_per_byte, k++) {
         if ((((int)in[k]) & d_mask) != (((int)crc_calcd >> i) & d_mask)) {
             DTL_LOG_DEBUG("header_parser: crc=failed");
@@ -308,8 +310,23 @@ bool ofdm_adaptive_packet_header::header_parser(const unsigned char* in,
     tag.key = feedback_constellation_key();
     tag.value = pmt::from_long(feedback_cnst);
     tags.push_back(tag);
+
+    if (d_header_channel) {
+        int fec_idx = -1;
+        for (const auto& t : tags) {
+            if (pmt::eq(t.key, fec_feedback_key())) {
+                fec_idx = pmt::to_long(t.value);
+            }
+        }
+        d_header_channel->publish(static_cast<constellation_type_t>(feedback_cnst), fec_idx);
+    }
     return true;
 }
 
+void ofdm_adaptive_packet_header::set_header_channel(mcs_channel::sptr channel)
+{
+    d_header_channel = channel;
+}
+
 } /* namespace dtl */
 } /* namespace gr */
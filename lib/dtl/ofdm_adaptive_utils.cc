@@ -26,6 +26,8 @@ static const pmt::pmt_t ESTIMATED_SNR_TAG_KEY =
     pmt::string_to_symbol("estimated_snr_tag_key");
 static const pmt::pmt_t NOISE_TAG_KEY =
     pmt::string_to_symbol("noise_tag_key");
+static const pmt::pmt_t CARRIER_SNR_TAG_KEY =
+    pmt::string_to_symbol("carrier_snr_tag_key");
 static const pmt::pmt_t FEEDBACK_CONSTELLATION_KEY =
     pmt::string_to_symbol("feedback_constellation_key");
 static const pmt::pmt_t PAYLOAD_LENGTH_KEY = pmt::string_to_symbol("payload_length_key");
@@ -37,6 +39,9 @@ static const pmt::pmt_t FEC_OFFSET_KEY = pmt::string_to_symbol("fec_offset_key")
 static const pmt::pmt_t FEC_TB_PAYLOAD_KEY = pmt::string_to_symbol("fec_tb_payload_key");
 static const pmt::pmt_t FEC_TB_LEN_KEY = pmt::string_to_symbol("fec_tb_len_key");
 static const pmt::pmt_t FEC_TB_INDEX_KEY = pmt::string_to_symbol("fec_tb_index_key");
+static const pmt::pmt_t FRAME_INDEX_KEY = pmt::string_to_symbol("frame_index_key");
+// Burst time of the UHD sink
+static const pmt::pmt_t TX_TIME_KEY = pmt::string_to_symbol("tx_time");
 
 
 template <class T>
@@ -153,6 +158,8 @@ pmt::pmt_t DTL_API estimated_snr_tag_key() { return ESTIMATED_SNR_TAG_KEY; }
 
 pmt::pmt_t DTL_API noise_tag_key() { return NOISE_TAG_KEY; }
 
+pmt::pmt_t DTL_API carrier_snr_tag_key() { return CARRIER_SNR_TAG_KEY; }
+
 pmt::pmt_t DTL_API feedback_constellation_key() { return FEEDBACK_CONSTELLATION_KEY; }
 
 pmt::pmt_t DTL_API payload_length_key() { return PAYLOAD_LENGTH_KEY; }
@@ -165,6 +172,10 @@ pmt::pmt_t DTL_API fec_tb_key() { return FEC_TB_KEY; }
 
 pmt::pmt_t DTL_API fec_tb_index_key() { return FEC_TB_INDEX_KEY; }
 
+pmt::pmt_t DTL_API frame_index_key() { return FRAME_INDEX_KEY; }
+
+pmt::pmt_t DTL_API tx_time_key() { return TX_TIME_KEY; }
+
 pmt::pmt_t DTL_API fec_offset_key() { return FEC_OFFSET_KEY; }
 
 pmt::pmt_t DTL_API fec_tb_payload_key() { return FEC_TB_PAYLOAD_KEY; }
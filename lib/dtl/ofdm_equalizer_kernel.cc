@@ -0,0 +1,222 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ofdm_equalizer_kernel.h"
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DTL_EQ_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DTL_EQ_NEON 1
+#endif
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+namespace {
+
+const float MAX_DIST = numeric_limits<float>::max();
+
+void equalize_generic(const ofdm_equalizer_kernel::table_t& t,
+                      float alpha,
+                      const ofdm_equalizer_kernel::carriers_t& c,
+                      int begin,
+                      int end)
+{
+    int npoints = t.re.size();
+    for (int i = begin; i < end; ++i) {
+        float yr = c.y_re[i];
+        float yi = c.y_im[i];
+        float hr = c.h_re[i];
+        float hi = c.h_im[i];
+        float rg = 1.0f / (hr * hr + hi * hi);
+        float er = (yr * hr + yi * hi) * rg;
+        float ei = (yi * hr - yr * hi) * rg;
+
+        int best = 0;
+        float best_dist = MAX_DIST;
+        for (int p = 0; p < npoints; ++p) {
+            float dr = er - t.re[p];
+            float di = ei - t.im[p];
+            float d = dr * dr + di * di;
+            if (d < best_dist) {
+                best_dist = d;
+                best = p;
+            }
+        }
+
+        c.eq_re[i] = er;
+        c.eq_im[i] = ei;
+        c.est_re[i] = t.re[best];
+        c.est_im[i] = t.im[best];
+        float ir = t.inv_re[best];
+        float ii = t.inv_im[best];
+        c.h_re[i] = alpha * hr + (1 - alpha) * (yr * ir - yi * ii);
+        c.h_im[i] = alpha * hi + (1 - alpha) * (yr * ii + yi * ir);
+    }
+}
+
+#if DTL_EQ_X86
+
+__attribute__((target("avx2,fma"))) void
+equalize_avx2(const ofdm_equalizer_kernel::table_t& t,
+              float alpha,
+              const ofdm_equalizer_kernel::carriers_t& c,
+              int begin,
+              int end)
+{
+    const __m256 valpha = _mm256_set1_ps(alpha);
+    const __m256 vbeta = _mm256_set1_ps(1 - alpha);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    int npoints = t.re.size();
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 yr = _mm256_loadu_ps(c.y_re + i);
+        __m256 yi = _mm256_loadu_ps(c.y_im + i);
+        __m256 hr = _mm256_loadu_ps(c.h_re + i);
+        __m256 hi = _mm256_loadu_ps(c.h_im + i);
+        __m256 rg = _mm256_div_ps(one, _mm256_fmadd_ps(hr, hr, _mm256_mul_ps(hi, hi)));
+        __m256 er = _mm256_mul_ps(_mm256_fmadd_ps(yr, hr, _mm256_mul_ps(yi, hi)), rg);
+        __m256 ei = _mm256_mul_ps(_mm256_fmsub_ps(yi, hr, _mm256_mul_ps(yr, hi)), rg);
+
+        __m256 best_dist = _mm256_set1_ps(MAX_DIST);
+        __m256 sr = _mm256_setzero_ps();
+        __m256 si = sr;
+        __m256 ir = sr;
+        __m256 ii = sr;
+        for (int p = 0; p < npoints; ++p) {
+            __m256 dr = _mm256_sub_ps(er, _mm256_set1_ps(t.re[p]));
+            __m256 di = _mm256_sub_ps(ei, _mm256_set1_ps(t.im[p]));
+            __m256 d = _mm256_fmadd_ps(dr, dr, _mm256_mul_ps(di, di));
+            __m256 closer = _mm256_cmp_ps(d, best_dist, _CMP_LT_OQ);
+            best_dist = _mm256_blendv_ps(best_dist, d, closer);
+            sr = _mm256_blendv_ps(sr, _mm256_set1_ps(t.re[p]), closer);
+            si = _mm256_blendv_ps(si, _mm256_set1_ps(t.im[p]), closer);
+            ir = _mm256_blendv_ps(ir, _mm256_set1_ps(t.inv_re[p]), closer);
+            ii = _mm256_blendv_ps(ii, _mm256_set1_ps(t.inv_im[p]), closer);
+        }
+
+        // y / est
+        __m256 qr = _mm256_fmsub_ps(yr, ir, _mm256_mul_ps(yi, ii));
+        __m256 qi = _mm256_fmadd_ps(yr, ii, _mm256_mul_ps(yi, ir));
+        _mm256_storeu_ps(c.eq_re + i, er);
+        _mm256_storeu_ps(c.eq_im + i, ei);
+        _mm256_storeu_ps(c.est_re + i, sr);
+        _mm256_storeu_ps(c.est_im + i, si);
+        _mm256_storeu_ps(c.h_re + i,
+                         _mm256_fmadd_ps(valpha, hr, _mm256_mul_ps(vbeta, qr)));
+        _mm256_storeu_ps(c.h_im + i,
+                         _mm256_fmadd_ps(valpha, hi, _mm256_mul_ps(vbeta, qi)));
+    }
+    equalize_generic(t, alpha, c, i, end);
+}
+
+bool cpu_has_avx2()
+{
+    static const bool has_avx2 =
+        __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return has_avx2;
+}
+
+#endif // DTL_EQ_X86
+
+
+#if DTL_EQ_NEON
+
+void equalize_neon(const ofdm_equalizer_kernel::table_t& t,
+                   float alpha,
+                   const ofdm_equalizer_kernel::carriers_t& c,
+                   int begin,
+                   int end)
+{
+    int npoints = t.re.size();
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        float32x4_t yr = vld1q_f32(c.y_re + i);
+        float32x4_t yi = vld1q_f32(c.y_im + i);
+        float32x4_t hr = vld1q_f32(c.h_re + i);
+        float32x4_t hi = vld1q_f32(c.h_im + i);
+        float32x4_t rg = vdivq_f32(vdupq_n_f32(1.0f), vmlaq_f32(vmulq_f32(hr, hr), hi, hi));
+        float32x4_t er = vmulq_f32(vmlaq_f32(vmulq_f32(yr, hr), yi, hi), rg);
+        float32x4_t ei = vmulq_f32(vmlsq_f32(vmulq_f32(yi, hr), yr, hi), rg);
+
+        float32x4_t best_dist = vdupq_n_f32(MAX_DIST);
+        float32x4_t sr = vdupq_n_f32(0);
+        float32x4_t si = sr;
+        float32x4_t ir = sr;
+        float32x4_t ii = sr;
+        for (int p = 0; p < npoints; ++p) {
+            float32x4_t dr = vsubq_f32(er, vdupq_n_f32(t.re[p]));
+            float32x4_t di = vsubq_f32(ei, vdupq_n_f32(t.im[p]));
+            float32x4_t d = vmlaq_f32(vmulq_f32(dr, dr), di, di);
+            uint32x4_t closer = vcltq_f32(d, best_dist);
+            best_dist = vbslq_f32(closer, d, best_dist);
+            sr = vbslq_f32(closer, vdupq_n_f32(t.re[p]), sr);
+            si = vbslq_f32(closer, vdupq_n_f32(t.im[p]), si);
+            ir = vbslq_f32(closer, vdupq_n_f32(t.inv_re[p]), ir);
+            ii = vbslq_f32(closer, vdupq_n_f32(t.inv_im[p]), ii);
+        }
+
+        // y / est
+        float32x4_t qr = vmlsq_f32(vmulq_f32(yr, ir), yi, ii);
+        float32x4_t qi = vmlaq_f32(vmulq_f32(yr, ii), yi, ir);
+        vst1q_f32(c.eq_re + i, er);
+        vst1q_f32(c.eq_im + i, ei);
+        vst1q_f32(c.est_re + i, sr);
+        vst1q_f32(c.est_im + i, si);
+        vst1q_f32(c.h_re + i, vmlaq_n_f32(vmulq_n_f32(qr, 1 - alpha), hr, alpha));
+        vst1q_f32(c.h_im + i, vmlaq_n_f32(vmulq_n_f32(qi, 1 - alpha), hi, alpha));
+    }
+    equalize_generic(t, alpha, c, i, end);
+}
+
+#endif // DTL_EQ_NEON
+
+
+ofdm_equalizer_kernel::kernel_t get_equalizer_kernel()
+{
+#if DTL_EQ_X86
+    if (cpu_has_avx2()) {
+        return equalize_avx2;
+    }
+#elif DTL_EQ_NEON
+    return equalize_neon;
+#endif
+    return equalize_generic;
+}
+
+} // namespace
+
+ofdm_equalizer_kernel::ofdm_equalizer_kernel(
+    const digital::constellation_sptr& constellation)
+{
+    if (constellation->dimensionality() != 1) {
+        throw invalid_argument("ofdm_equalizer_kernel: unsupported constellation");
+    }
+    for (const gr_complex& point : constellation->points()) {
+        float energy = norm(point);
+        gr_complex inv = energy > 0 ? conj(point) / energy : gr_complex(0, 0);
+        d_table.re.push_back(point.real());
+        d_table.im.push_back(point.imag());
+        d_table.inv_re.push_back(inv.real());
+        d_table.inv_im.push_back(inv.imag());
+    }
+    d_kernel = get_equalizer_kernel();
+}
+
+void ofdm_equalizer_kernel::equalize(float alpha, const carriers_t& c, int n) const
+{
+    d_kernel(d_table, alpha, c, 0, n);
+}
+
+} // namespace dtl
+} // namespace gr
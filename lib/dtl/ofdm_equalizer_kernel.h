@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_OFDM_EQUALIZER_KERNEL_H
+#define INCLUDED_DTL_OFDM_EQUALIZER_KERNEL_H
+
+#include <gnuradio/digital/constellation.h>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Decision directed equalization of the data carriers of an OFDM symbol for a
+ * gr::digital constellation. For each carrier with received symbol y and
+ * channel tap h:
+ *
+ *   eq  = y / h
+ *   est = constellation point closest to eq
+ *   h   = alpha * h + (1 - alpha) * y / est
+ *
+ * which is what decision_maker() and map_to_points() give for the constellations
+ * of create_constellation(). The divisions are done with the reciprocals of h
+ * and of the points, and the slicer is a minimum distance search over the
+ * points, 8/4 carriers per AVX2/NEON vector.
+ *
+ * The carriers are passed as split real and imaginary arrays, gathered from the
+ * frame by the caller.
+ */
+class ofdm_equalizer_kernel
+{
+public:
+    struct table_t {
+        std::vector<float> re;
+        std::vector<float> im;
+        // Reciprocals of the points
+        std::vector<float> inv_re;
+        std::vector<float> inv_im;
+    };
+
+    struct carriers_t {
+        const float* y_re;
+        const float* y_im;
+        // Updated in place
+        float* h_re;
+        float* h_im;
+        float* eq_re;
+        float* eq_im;
+        float* est_re;
+        float* est_im;
+    };
+
+    typedef void (*kernel_t)(const table_t& table,
+                             float alpha,
+                             const carriers_t& c,
+                             int begin,
+                             int end);
+
+    explicit ofdm_equalizer_kernel(const digital::constellation_sptr& constellation);
+
+    void equalize(float alpha, const carriers_t& c, int n) const;
+
+private:
+    table_t d_table;
+    kernel_t d_kernel;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_OFDM_EQUALIZER_KERNEL_H */
@@ -0,0 +1,148 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pad_generator.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+namespace {
+
+// Longer than the padding of most frames, longer ones wrap around
+const size_t TABLE_LEN = 1 << 16;
+
+uint64_t splitmix64(uint64_t& x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+// Bytes of the PRBS31 sequence x^31 + x^28 + 1, LSB first
+const vector<unsigned char>& pad_table()
+{
+    static const vector<unsigned char> table = [] {
+        vector<unsigned char> t(TABLE_LEN);
+        uint32_t lfsr = 0x2545F491;
+        auto step = [&lfsr] {
+            uint32_t bit = ((lfsr >> 30) ^ (lfsr >> 27)) & 1;
+            lfsr = ((lfsr << 1) | bit) & 0x7FFFFFFF;
+            return bit;
+        };
+        // Past the first outputs, which repeat the seed
+        for (int i = 0; i < 1024; ++i) {
+            step();
+        }
+        for (auto& byte : t) {
+            for (int b = 0; b < 8; ++b) {
+                byte |= step() << b;
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+} // namespace
+
+pad_generator::pad_generator() : pad_generator(random_device{}()) {}
+
+pad_generator::pad_generator(uint64_t seed) : d_table(false), d_table_pos(0)
+{
+    this->seed(seed);
+}
+
+void pad_generator::seed(uint64_t seed)
+{
+    for (auto& s : d_state) {
+        s = splitmix64(seed);
+    }
+}
+
+void pad_generator::use_table(bool table)
+{
+    d_table = table;
+    d_table_pos = 0;
+}
+
+uint64_t pad_generator::next()
+{
+    // xoshiro256**
+    const uint64_t result = rotl(d_state[1] * 5, 7) * 9;
+    const uint64_t t = d_state[1] << 17;
+    d_state[2] ^= d_state[0];
+    d_state[3] ^= d_state[1];
+    d_state[1] ^= d_state[2];
+    d_state[0] ^= d_state[3];
+    d_state[2] ^= t;
+    d_state[3] = rotl(d_state[3], 45);
+    return result;
+}
+
+void pad_generator::fill_from_table(unsigned char* buf, size_t len, unsigned char mask)
+{
+    const unsigned char* table = pad_table().data();
+    while (len) {
+        size_t n = min(len, TABLE_LEN - d_table_pos);
+        const unsigned char* src = table + d_table_pos;
+        if (mask == 0xFF) {
+            memcpy(buf, src, n);
+        } else {
+            const uint64_t mask64 = 0x0101010101010101ull * mask;
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                uint64_t r;
+                memcpy(&r, src + i, 8);
+                r &= mask64;
+                memcpy(buf + i, &r, 8);
+            }
+            for (; i < n; ++i) {
+                buf[i] = src[i] & mask;
+            }
+        }
+        buf += n;
+        len -= n;
+        d_table_pos = (d_table_pos + n) % TABLE_LEN;
+    }
+}
+
+void pad_generator::fill(unsigned char* buf, size_t len)
+{
+    fill_symbols(buf, len, 8);
+}
+
+void pad_generator::fill_symbols(unsigned char* buf, size_t len, int bps)
+{
+    const unsigned char mask = (1u << bps) - 1;
+    if (d_table) {
+        fill_from_table(buf, len, mask);
+        return;
+    }
+    // Each byte of the 64 random bits, masked to bps
+    const uint64_t mask64 = 0x0101010101010101ull * mask;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t r = next() & mask64;
+        memcpy(buf + i, &r, 8);
+    }
+    if (i < len) {
+        uint64_t r = next() & mask64;
+        memcpy(buf + i, &r, len - i);
+    }
+}
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,59 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_PAD_GENERATOR_H
+#define INCLUDED_DTL_PAD_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Padding of the frames, random bytes or symbol values of bps random bits.
+ *
+ * By default the padding comes from a xoshiro256** generator seeded once,
+ * 64 bits per step. With use_table() it is copied from a fixed table of a
+ * PRBS31 LFSR sequence instead, read on from the last position so consecutive
+ * frames differ; after reset() the same calls give the same padding, for tests.
+ */
+class pad_generator
+{
+public:
+    // Seeded from std::random_device
+    pad_generator();
+    explicit pad_generator(uint64_t seed);
+
+    void seed(uint64_t seed);
+
+    // Padding from the fixed table instead of the generator
+    void use_table(bool table);
+    bool table() const { return d_table; }
+
+    // Back to the start of the table
+    void reset() { d_table_pos = 0; }
+
+    // len random bytes
+    void fill(unsigned char* buf, size_t len);
+
+    // len symbol values, one per byte, of bps random bits
+    void fill_symbols(unsigned char* buf, size_t len, int bps);
+
+private:
+    uint64_t next();
+    void fill_from_table(unsigned char* buf, size_t len, unsigned char mask);
+
+    uint64_t d_state[4];
+    bool d_table;
+    size_t d_table_pos;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_PAD_GENERATOR_H */
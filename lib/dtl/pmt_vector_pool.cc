@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pmt_vector_pool.h"
+#include <algorithm>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+pmt_vector_pool::pmt_vector_pool(size_t max_size) : d_max_size(max_size)
+{
+    d_vectors.reserve(max_size);
+}
+
+pmt::pmt_t* pmt_vector_pool::find_free(size_t len, bool (*is_type)(pmt::pmt_t))
+{
+    for (auto& v : d_vectors) {
+        if (v.use_count() == 1 && is_type(v) && pmt::length(v) == len) {
+            return &v;
+        }
+    }
+    return nullptr;
+}
+
+pmt::pmt_t pmt_vector_pool::c32vector(const vector<gr_complex>& v)
+{
+    pmt::pmt_t* pooled = find_free(v.size(), pmt::is_c32vector);
+    if (!pooled) {
+        pmt::pmt_t fresh = pmt::init_c32vector(v.size(), v);
+        if (d_vectors.size() < d_max_size) {
+            d_vectors.push_back(fresh);
+        }
+        return fresh;
+    }
+    size_t len = 0;
+    gr_complex* items = pmt::c32vector_writable_elements(*pooled, len);
+    copy(v.begin(), v.end(), items);
+    return *pooled;
+}
+
+pmt::pmt_t pmt_vector_pool::f32vector(const vector<float>& v)
+{
+    pmt::pmt_t* pooled = find_free(v.size(), pmt::is_f32vector);
+    if (!pooled) {
+        pmt::pmt_t fresh = pmt::init_f32vector(v.size(), v);
+        if (d_vectors.size() < d_max_size) {
+            d_vectors.push_back(fresh);
+        }
+        return fresh;
+    }
+    size_t len = 0;
+    float* items = pmt::f32vector_writable_elements(*pooled, len);
+    copy(v.begin(), v.end(), items);
+    return *pooled;
+}
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,48 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_PMT_VECTOR_POOL_H
+#define INCLUDED_DTL_PMT_VECTOR_POOL_H
+
+#include <gnuradio/gr_complex.h>
+#include <pmt/pmt.h>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Recycles the uniform PMT vectors of per-frame tags.
+ *
+ * A vector is overwritten and handed out again once the pool holds its only
+ * reference, i.e. every tag that carried it has been pruned from the buffers,
+ * so a block attaching a vector to each frame stops allocating once the pool
+ * covers the frames in flight. Beyond max_size vectors in use, fresh vectors
+ * are returned without being pooled.
+ *
+ * Not thread safe: each block owns its pools.
+ */
+class pmt_vector_pool
+{
+public:
+    explicit pmt_vector_pool(size_t max_size = 16);
+
+    pmt::pmt_t c32vector(const std::vector<gr_complex>& v);
+    pmt::pmt_t f32vector(const std::vector<float>& v);
+
+private:
+    size_t d_max_size;
+    std::vector<pmt::pmt_t> d_vectors;
+
+    // Free pooled vector of len items, nullptr if none
+    pmt::pmt_t* find_free(size_t len, bool (*is_type)(pmt::pmt_t));
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_PMT_VECTOR_POOL_H */
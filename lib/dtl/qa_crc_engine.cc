@@ -0,0 +1,92 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/digital/crc.h>
+#include <gnuradio/testbed/crc_engine.h>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+// crc_engine against gr::digital::crc over random buffers of every length up to
+// max_len, whole and split into several update() calls
+static void check_crc(unsigned num_bits,
+                      uint32_t poly,
+                      uint32_t initial_value,
+                      uint32_t final_xor,
+                      bool input_reflected,
+                      bool result_reflected,
+                      std::size_t max_len)
+{
+    gr::digital::crc ref(
+        num_bits, poly, initial_value, final_xor, input_reflected, result_reflected);
+    crc_engine crc(
+        num_bits, poly, initial_value, final_xor, input_reflected, result_reflected);
+    std::mt19937 rng(42);
+    for (std::size_t len = 0; len <= max_len; len++) {
+        std::vector<unsigned char> data(len);
+        for (auto& x : data) {
+            x = rng();
+        }
+        uint32_t expected = ref.compute(data.data(), len);
+        BOOST_REQUIRE_EQUAL(crc.compute(data.data(), len), expected);
+
+        std::size_t split = len ? rng() % len : 0;
+        uint32_t rem = crc.update(crc.start(), data.data(), split);
+        rem = crc.update(rem, &data[split], len - split);
+        BOOST_REQUIRE_EQUAL(crc.finish(rem), expected);
+
+        // One bit per byte, in the order the CRC consumes them
+        std::vector<unsigned char> bits(8 * len);
+        for (std::size_t i = 0; i < 8 * len; i++) {
+            int shift = input_reflected ? i % 8 : 7 - i % 8;
+            bits[i] = (data[i / 8] >> shift) & 1;
+        }
+        BOOST_REQUIRE_EQUAL(crc.compute_bits(bits.data(), bits.size()), expected);
+    }
+}
+
+// Frame and TB CRC of crc_util
+BOOST_AUTO_TEST_CASE(test_crc32_frame)
+{
+    check_crc(32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true, 300);
+}
+
+// header_crc of ofdm_adaptive_packet_header
+BOOST_AUTO_TEST_CASE(test_crc16_header)
+{
+    check_crc(16, 0x1021, 0xFFFF, 0, false, true, 100);
+}
+
+BOOST_AUTO_TEST_CASE(test_crc16_header_partial_bytes)
+{
+    // Bit streams that don't fill the last byte, as in header_crc
+    gr::digital::crc ref(16, 0x1021, 0xFFFF, 0, false, true);
+    crc_engine crc(16, 0x1021, 0xFFFF, 0, false, true);
+    std::mt19937 rng(7);
+    for (std::size_t nbits = 0; nbits <= 96; nbits++) {
+        std::vector<unsigned char> bits(nbits);
+        for (auto& b : bits) {
+            b = rng() & 1;
+        }
+        // Right aligned in the last byte, MSB first
+        std::vector<unsigned char> data((nbits + 7) / 8, 0);
+        std::size_t pad = 8 * data.size() - nbits;
+        for (std::size_t i = 0; i < nbits; i++) {
+            data[(pad + i) / 8] |= bits[i] << (7 - (pad + i) % 8);
+        }
+        static const unsigned char zeros[8] = { 0 };
+        uint32_t rem = crc.update_bits(crc.start(), zeros, pad);
+        rem = crc.update_bits(rem, bits.data(), nbits);
+        BOOST_REQUIRE_EQUAL(crc.finish(rem), ref.compute(data.data(), data.size()));
+    }
+}
+
+} /* namespace dtl */
+} /* namespace gr */
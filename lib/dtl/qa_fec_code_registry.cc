@@ -0,0 +1,135 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "fec_code_registry.h"
+#include <boost/test/unit_test.hpp>
+#include <unistd.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace gr {
+namespace dtl {
+
+static const std::string code_23 = DTL_TEST_CODES_DIR "/n_0100_k_0023_gap_10.alist";
+static const std::string code_27 = DTL_TEST_CODES_DIR "/n_0100_k_0027_gap_04.alist";
+
+// Copies of the alist files in a scratch directory, without the on-disk cache
+struct scratch_dir_fixture {
+    std::filesystem::path dir;
+
+    scratch_dir_fixture()
+        : dir(std::filesystem::temp_directory_path() /
+              ("dtl_qa_fec_code_registry_" + std::to_string(getpid())))
+    {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        setenv("DTL_LDPC_CACHE_DIR", "", 1);
+    }
+
+    ~scratch_dir_fixture()
+    {
+        unsetenv("DTL_LDPC_CACHE_DIR");
+        std::filesystem::remove_all(dir);
+    }
+
+    std::string copy(const std::string& alist_fname, const std::string& name) const
+    {
+        auto path = dir / name;
+        std::filesystem::copy_file(alist_fname,
+                                   path,
+                                   std::filesystem::copy_options::overwrite_existing);
+        return path.string();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(test_registry_lookup_by_path)
+{
+    scratch_dir_fixture scratch;
+    auto& registry = fec_code_registry::instance();
+    auto a = registry.get_ldpc_code(code_23);
+    BOOST_REQUIRE_EQUAL(a, registry.get_ldpc_code(code_23));
+    // Same file through another path
+    BOOST_REQUIRE_EQUAL(
+        a, registry.get_ldpc_code(DTL_TEST_CODES_DIR "/./n_0100_k_0023_gap_10.alist"));
+    BOOST_REQUIRE_EQUAL(a->k(), 23);
+
+    auto b = registry.get_ldpc_code(code_27);
+    BOOST_REQUIRE_NE(a, b);
+    BOOST_REQUIRE_EQUAL(b->k(), 27);
+}
+
+BOOST_AUTO_TEST_CASE(test_registry_lookup_by_content)
+{
+    scratch_dir_fixture scratch;
+    auto& registry = fec_code_registry::instance();
+    auto a = registry.get_ldpc_code(code_27);
+    auto copy = scratch.copy(code_27, "copy.alist");
+    BOOST_REQUIRE_EQUAL(a, registry.get_ldpc_code(copy));
+    BOOST_REQUIRE_EQUAL(a->hash(), ldpc_code::alist_hash(copy));
+
+    // A modified file is a different code
+    {
+        std::ofstream out(copy, std::ios::app);
+        out << "\n";
+    }
+    auto b = registry.get_ldpc_code(copy);
+    BOOST_REQUIRE_NE(a, b);
+    BOOST_REQUIRE_NE(a->hash(), b->hash());
+    BOOST_REQUIRE_EQUAL(b->k(), 27);
+}
+
+BOOST_AUTO_TEST_CASE(test_registry_release)
+{
+    // Entries don't keep the codes alive
+    scratch_dir_fixture scratch;
+    auto& registry = fec_code_registry::instance();
+    auto copy = scratch.copy(code_23, "release.alist");
+    auto code = registry.get_ldpc_code(copy);
+    auto layers = registry.get_ldpc_layers(code, 16);
+    std::weak_ptr<const ldpc_code> weak_code = code;
+    std::weak_ptr<const ldpc_layers> weak_layers = layers;
+    code.reset();
+    BOOST_REQUIRE(!weak_code.expired());
+    layers.reset();
+    BOOST_REQUIRE(weak_layers.expired());
+    BOOST_REQUIRE(weak_code.expired());
+
+    code = registry.get_ldpc_code(copy);
+    BOOST_REQUIRE_EQUAL(code->k(), 23);
+}
+
+BOOST_AUTO_TEST_CASE(test_registry_layers)
+{
+    scratch_dir_fixture scratch;
+    auto& registry = fec_code_registry::instance();
+    auto code = registry.get_ldpc_code(code_27);
+    auto layers = registry.get_ldpc_layers(code, 8);
+    BOOST_REQUIRE_EQUAL(layers, registry.get_ldpc_layers(code, 8));
+    auto copy = registry.get_ldpc_code(scratch.copy(code_27, "layers.alist"));
+    BOOST_REQUIRE_EQUAL(layers, registry.get_ldpc_layers(copy, 8));
+    BOOST_REQUIRE_NE(layers, registry.get_ldpc_layers(code, 16));
+    BOOST_REQUIRE_EQUAL(layers->code, code);
+    BOOST_REQUIRE_EQUAL(layers->align, 8);
+    for (int m = 0; m < code->nrows(); ++m) {
+        BOOST_REQUIRE_EQUAL(layers->row_offset[m] % 8, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_registry_unknown_code)
+{
+    scratch_dir_fixture scratch;
+    auto& registry = fec_code_registry::instance();
+    BOOST_REQUIRE_THROW(registry.get_ldpc_code((scratch.dir / "missing.alist").string()),
+                        std::runtime_error);
+    // Still usable after the failed lookup
+    BOOST_REQUIRE_EQUAL(registry.get_ldpc_code(code_23)->k(), 23);
+}
+
+} /* namespace dtl */
+} /* namespace gr */
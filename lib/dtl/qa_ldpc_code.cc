@@ -0,0 +1,177 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "fec_code_registry.h"
+#include "ldpc_code.h"
+#include <boost/test/unit_test.hpp>
+#include <unistd.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+static const std::string code_23 = DTL_TEST_CODES_DIR "/n_0100_k_0023_gap_10.alist";
+static const std::string code_27 = DTL_TEST_CODES_DIR "/n_0100_k_0027_gap_04.alist";
+
+// Codes compiled in a fresh cache directory, removed at the end of the test
+struct cache_dir_fixture {
+    std::filesystem::path dir;
+
+    cache_dir_fixture()
+        : dir(std::filesystem::temp_directory_path() /
+              ("dtl_qa_ldpc_code_" + std::to_string(getpid())))
+    {
+        std::filesystem::remove_all(dir);
+        setenv("DTL_LDPC_CACHE_DIR", dir.c_str(), 1);
+    }
+
+    ~cache_dir_fixture()
+    {
+        unsetenv("DTL_LDPC_CACHE_DIR");
+        std::filesystem::remove_all(dir);
+    }
+
+    std::filesystem::path cache_file(uint64_t hash) const
+    {
+        char name[32];
+        snprintf(
+            name, sizeof(name), "%016llx.ldpc", static_cast<unsigned long long>(hash));
+        return dir / name;
+    }
+};
+
+static ldpc_code::sptr load(const std::string& alist_fname)
+{
+    return ldpc_code::load(alist_fname, ldpc_code::alist_hash(alist_fname));
+}
+
+// Codewords built from gen() with random data satisfy every row of H
+static void check_code(const ldpc_code& code, int n, int k, int nrows)
+{
+    BOOST_REQUIRE_EQUAL(code.n(), n);
+    BOOST_REQUIRE_EQUAL(code.k(), k);
+    BOOST_REQUIRE_EQUAL(code.ncheck(), n - k);
+    BOOST_REQUIRE_EQUAL(code.nrows(), nrows);
+    BOOST_REQUIRE_EQUAL(code.gen_words() % 4, 0);
+    BOOST_REQUIRE_GE(64 * code.gen_words(), code.ncheck());
+
+    std::vector<bool> seen(n, false);
+    for (int i = 0; i < n; ++i) {
+        BOOST_REQUIRE(code.permute()[i] >= 0 && code.permute()[i] < n);
+        BOOST_REQUIRE(!seen[code.permute()[i]]);
+        seen[code.permute()[i]] = true;
+    }
+    BOOST_REQUIRE_EQUAL(code.row_ptr()[0], 0);
+    for (int i = 0; i < nrows; ++i) {
+        BOOST_REQUIRE_LT(code.row_ptr()[i], code.row_ptr()[i + 1]);
+    }
+    for (int e = 0; e < code.row_ptr()[nrows]; ++e) {
+        BOOST_REQUIRE(code.cols()[e] >= 0 && code.cols()[e] < n);
+    }
+
+    std::mt19937 rng(42);
+    for (int trial = 0; trial < 20; ++trial) {
+        // Check bits first, then data bits
+        std::vector<int> word(n, 0);
+        for (int j = 0; j < k; ++j) {
+            int bit = rng() & 1;
+            word[code.ncheck() + j] = bit;
+            if (!bit) {
+                continue;
+            }
+            const uint64_t* col = &code.gen()[j * code.gen_words()];
+            for (int i = 0; i < code.ncheck(); ++i) {
+                word[i] ^= (col[i / 64] >> (i % 64)) & 1;
+            }
+        }
+        for (int row = 0; row < nrows; ++row) {
+            int parity = 0;
+            for (int e = code.row_ptr()[row]; e < code.row_ptr()[row + 1]; ++e) {
+                parity ^= word[code.cols()[e]];
+            }
+            BOOST_REQUIRE_EQUAL(parity, 0);
+        }
+    }
+}
+
+static void check_same_code(const ldpc_code& a, const ldpc_code& b)
+{
+    BOOST_REQUIRE_EQUAL(a.hash(), b.hash());
+    BOOST_REQUIRE_EQUAL(a.n(), b.n());
+    BOOST_REQUIRE_EQUAL(a.k(), b.k());
+    BOOST_REQUIRE_EQUAL(a.nrows(), b.nrows());
+    BOOST_REQUIRE_EQUAL(a.gen_words(), b.gen_words());
+    int edges = a.row_ptr()[a.nrows()];
+    BOOST_REQUIRE(std::equal(a.permute(), a.permute() + a.n(), b.permute()));
+    BOOST_REQUIRE(std::equal(a.row_ptr(), a.row_ptr() + a.nrows() + 1, b.row_ptr()));
+    BOOST_REQUIRE(std::equal(a.cols(), a.cols() + edges, b.cols()));
+    BOOST_REQUIRE(std::equal(a.gen(), a.gen() + a.k() * a.gen_words(), b.gen()));
+}
+
+BOOST_AUTO_TEST_CASE(test_ldpc_code_compile)
+{
+    cache_dir_fixture cache;
+    check_code(*load(code_23), 100, 23, 77);
+    check_code(*load(code_27), 100, 27, 73);
+    BOOST_REQUIRE_NE(ldpc_code::alist_hash(code_23), ldpc_code::alist_hash(code_27));
+}
+
+BOOST_AUTO_TEST_CASE(test_ldpc_code_disk_cache)
+{
+    cache_dir_fixture cache;
+    uint64_t hash = ldpc_code::alist_hash(code_23);
+    auto compiled = load(code_23);
+    BOOST_REQUIRE(std::filesystem::exists(cache.cache_file(hash)));
+
+    // Mapped from the cache file
+    auto mapped = load(code_23);
+    check_same_code(*compiled, *mapped);
+    check_code(*mapped, 100, 23, 77);
+
+    // A corrupted cache file is compiled again and replaced
+    {
+        std::fstream f(cache.cache_file(hash),
+                       std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(std::filesystem::file_size(cache.cache_file(hash)) / 2);
+        f.put(0x55).put(0xaa).put(0x55).put(0xaa);
+    }
+    auto recompiled = load(code_23);
+    check_same_code(*compiled, *recompiled);
+    check_same_code(*compiled, *load(code_23));
+
+    // Empty directory disables the cache
+    std::filesystem::remove_all(cache.dir);
+    setenv("DTL_LDPC_CACHE_DIR", "", 1);
+    check_same_code(*compiled, *load(code_23));
+    BOOST_REQUIRE(!std::filesystem::exists(cache.dir));
+}
+
+BOOST_AUTO_TEST_CASE(test_ldpc_code_missing_alist)
+{
+    BOOST_REQUIRE_THROW(ldpc_code::alist_hash(DTL_TEST_CODES_DIR "/missing.alist"),
+                        std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_ldpc_code_shared_instance)
+{
+    // Same alist, same instance while it is in use
+    cache_dir_fixture cache;
+    auto& registry = fec_code_registry::instance();
+    auto a = registry.get_ldpc_code(code_27);
+    auto b = registry.get_ldpc_code(code_27);
+    BOOST_REQUIRE_EQUAL(a, b);
+    BOOST_REQUIRE_NE(a, registry.get_ldpc_code(code_23));
+    check_code(*a, 100, 27, 73);
+}
+
+} /* namespace dtl */
+} /* namespace gr */
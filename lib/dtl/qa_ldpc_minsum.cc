@@ -0,0 +1,217 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ldpc_enc.h"
+#include "ldpc_minsum_dec.h"
+#include "ldpc_minsum_kernels.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+static const std::string code_23 = DTL_TEST_CODES_DIR "/n_0100_k_0023_gap_10.alist";
+static const std::string code_27 = DTL_TEST_CODES_DIR "/n_0100_k_0027_gap_04.alist";
+
+// Parameters of make_ldpc_decoders()
+template <typename T>
+static minsum_params_t<T> decoder_params()
+{
+    return { 1, 1 };
+}
+
+template <>
+minsum_params_t<float> decoder_params<float>()
+{
+    return { 0.75, 0 };
+}
+
+/*
+ * Messages as the decoder feeds them to the kernels, within max_llr. Small
+ * magnitudes give ties on the two minimums and, for the quantized LLRs, zeros.
+ */
+template <typename T>
+static std::vector<T> random_messages(std::mt19937& rng, int n, bool small)
+{
+    std::vector<T> q(n);
+    if constexpr (std::is_floating_point<T>::value) {
+        std::normal_distribution<float> llr(0, small ? 1 : 20);
+        for (auto& x : q) {
+            x = small ? std::round(4 * llr(rng)) / 4 + 0.125f : llr(rng);
+        }
+    } else {
+        int max = small ? 4 : minsum_traits<T>::max_llr;
+        std::uniform_int_distribution<int> llr(-max, max);
+        for (auto& x : q) {
+            x = llr(rng);
+        }
+    }
+    return q;
+}
+
+template <typename T>
+static void require_same(const std::vector<T>& value, const std::vector<T>& expected)
+{
+    BOOST_REQUIRE_EQUAL(value.size(), expected.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(+value[i], +expected[i]);
+    }
+}
+
+// Row kernel of the CPU against the generic one, on padded rows of any degree
+template <typename T>
+static void check_row_kernel()
+{
+    std::mt19937 rng(42);
+    auto kernel = get_minsum_row_kernel<T>();
+    auto params = decoder_params<T>();
+    for (int deg = 1; deg <= 3 * MINSUM_ROW_ALIGN + 5; ++deg) {
+        for (bool small : { false, true }) {
+            int n = (deg + MINSUM_ROW_ALIGN - 1) / MINSUM_ROW_ALIGN * MINSUM_ROW_ALIGN;
+            auto q = random_messages<T>(rng, n, small);
+            std::fill(q.begin() + deg, q.end(), minsum_traits<T>::max_llr);
+
+            std::vector<T> r(n), l(n), r_generic(n), l_generic(n);
+            kernel(q.data(), r.data(), l.data(), n, params);
+            minsum_row_generic<T>(
+                q.data(), r_generic.data(), l_generic.data(), n, params);
+            require_same(r, r_generic);
+            require_same(l, l_generic);
+        }
+    }
+}
+
+// Batch kernel of the CPU against the generic one, degrees not a multiple of the
+// row alignment
+template <typename T>
+static void check_batch_kernel()
+{
+    constexpr int lanes = minsum_batch_lanes<T>();
+    std::mt19937 rng(42);
+    auto kernel = get_minsum_batch_kernel<T>();
+    auto params = decoder_params<T>();
+    for (int deg = 1; deg <= 2 * MINSUM_ROW_ALIGN + 3; ++deg) {
+        for (bool small : { false, true }) {
+            auto q = random_messages<T>(rng, deg * lanes, small);
+
+            std::vector<T> r(deg * lanes), l(deg * lanes);
+            std::vector<T> r_generic(deg * lanes), l_generic(deg * lanes);
+            kernel(q.data(), r.data(), l.data(), deg, params);
+            minsum_batch_generic<T>(
+                q.data(), r_generic.data(), l_generic.data(), deg, params);
+            require_same(r, r_generic);
+            require_same(l, l_generic);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ldpc_minsum_row_kernel)
+{
+    check_row_kernel<float>();
+    check_row_kernel<int16_t>();
+    check_row_kernel<int8_t>();
+}
+
+BOOST_AUTO_TEST_CASE(test_ldpc_minsum_batch_kernel)
+{
+    check_batch_kernel<float>();
+    check_batch_kernel<int16_t>();
+    check_batch_kernel<int8_t>();
+}
+
+/*
+ * Noisy BPSK codewords, LLRs positive for bit 1, each with at least one bit in
+ * error. Every other codeword is shortened: its last data bits are known zeros
+ * at SHORTENED_LLR.
+ */
+struct noisy_codewords {
+    std::vector<unsigned char> data;
+    std::vector<float> llrs;
+
+    noisy_codewords(const std::string& alist_fname, int ncws, std::mt19937& rng)
+    {
+        const float sigma = 0.6;
+        std::normal_distribution<float> noise(0, sigma);
+        ldpc_enc enc(alist_fname);
+        int n = enc.get_n();
+        int k = enc.get_k();
+        data.resize(ncws * k);
+        llrs.resize(ncws * n);
+        std::vector<unsigned char> cw(n);
+        for (int c = 0; c < ncws; ++c) {
+            int shortened = (c % 2) ? 1 + rng() % (k / 2) : 0;
+            unsigned char* bits = &data[c * k];
+            for (int i = 0; i < k - shortened; ++i) {
+                bits[i] = rng() & 1;
+            }
+            enc.encode(bits, k, cw.data());
+
+            float* llr = &llrs[c * n];
+            for (int i = 0; i < n; ++i) {
+                float y = (cw[i] ? 1 : -1) + noise(rng);
+                llr[i] = 2 * y / (sigma * sigma);
+            }
+            int error = rng() % (n - shortened);
+            llr[error] = (cw[error] ? -1 : 1) * std::abs(llr[error]);
+            std::fill(llr + n - shortened, llr + n, SHORTENED_LLR);
+        }
+    }
+};
+
+/*
+ * Codewords decoded one by one and in batches of 2 to lanes + 1 codewords, the
+ * partial batches included.
+ */
+template <typename T>
+static void check_decoder(const std::string& alist_fname)
+{
+    constexpr int lanes = minsum_batch_lanes<T>();
+    auto params = decoder_params<T>();
+    ldpc_minsum_dec<T> dec(alist_fname, 50, params.scale, params.offset);
+    int k = dec.get_k();
+    std::mt19937 rng(42);
+
+    noisy_codewords one(alist_fname, 2 * lanes, rng);
+    for (int c = 0; c < 2 * lanes; ++c) {
+        std::vector<unsigned char> out(k);
+        int nit = 0;
+        BOOST_REQUIRE_EQUAL(dec.decode(&one.llrs[c * dec.get_n()], &nit, out.data()), k);
+        BOOST_REQUIRE_GT(nit, 0);
+        BOOST_REQUIRE(std::equal(out.begin(), out.end(), &one.data[c * k]));
+    }
+
+    for (int ncws = 2; ncws <= lanes + 1; ++ncws) {
+        noisy_codewords batch(alist_fname, ncws, rng);
+        std::vector<unsigned char> out(ncws * k);
+        std::vector<int> nit(ncws, 0);
+        BOOST_REQUIRE_EQUAL(
+            dec.decode_batch(batch.llrs.data(), ncws, nit.data(), out.data()),
+            ncws * k);
+        for (int c = 0; c < ncws; ++c) {
+            BOOST_REQUIRE_GT(nit[c], 0);
+        }
+        require_same(out, batch.data);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ldpc_minsum_decode)
+{
+    for (auto& alist_fname : { code_23, code_27 }) {
+        check_decoder<float>(alist_fname);
+        check_decoder<int16_t>(alist_fname);
+        check_decoder<int8_t>(alist_fname);
+    }
+}
+
+} /* namespace dtl */
+} /* namespace gr */
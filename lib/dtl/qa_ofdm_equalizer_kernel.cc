@@ -0,0 +1,91 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ofdm_equalizer_kernel.h"
+#include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+static const constellation_type_t all_constellations[] = { constellation_type_t::BPSK,
+                                                            constellation_type_t::QPSK,
+                                                            constellation_type_t::PSK8,
+                                                            constellation_type_t::QAM16 };
+
+static void require_close(float value, float expected)
+{
+    BOOST_REQUIRE_SMALL(value - expected, 1e-4f * (1 + std::abs(expected)));
+}
+
+// Kernel against the per carrier equalizer it replaces, with complex divisions and
+// the decision_maker() and map_to_points() of the constellation
+BOOST_AUTO_TEST_CASE(test_ofdm_equalizer_kernel_scalar)
+{
+    const float alpha = 0.1;
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0, 0.15);
+    std::uniform_real_distribution<float> phase(-M_PI, M_PI);
+    std::uniform_real_distribution<float> gain(0.3, 2);
+
+    for (auto type : all_constellations) {
+        auto cnst = get_constellation(type);
+        ofdm_equalizer_kernel kernel(cnst);
+        auto points = cnst->points();
+
+        // Lengths around the vector widths, with tails for the generic loop
+        for (int n = 0; n <= 37; ++n) {
+            std::vector<gr_complex> y(n);
+            std::vector<gr_complex> h(n);
+            for (int i = 0; i < n; ++i) {
+                h[i] = std::polar(gain(rng), phase(rng));
+                y[i] = h[i] * (points[rng() % points.size()] +
+                               gr_complex(noise(rng), noise(rng)));
+            }
+
+            std::vector<float> buf(8 * n);
+            ofdm_equalizer_kernel::carriers_t c;
+            float* y_re = buf.data();
+            float* y_im = buf.data() + n;
+            c.y_re = y_re;
+            c.y_im = y_im;
+            c.h_re = buf.data() + 2 * n;
+            c.h_im = buf.data() + 3 * n;
+            c.eq_re = buf.data() + 4 * n;
+            c.eq_im = buf.data() + 5 * n;
+            c.est_re = buf.data() + 6 * n;
+            c.est_im = buf.data() + 7 * n;
+            for (int i = 0; i < n; ++i) {
+                y_re[i] = y[i].real();
+                y_im[i] = y[i].imag();
+                c.h_re[i] = h[i].real();
+                c.h_im[i] = h[i].imag();
+            }
+            kernel.equalize(alpha, c, n);
+
+            for (int i = 0; i < n; ++i) {
+                gr_complex eq = y[i] / h[i];
+                gr_complex est;
+                cnst->map_to_points(cnst->decision_maker(&eq), &est);
+                gr_complex tap = alpha * h[i] + (1 - alpha) * y[i] / est;
+
+                require_close(c.eq_re[i], eq.real());
+                require_close(c.eq_im[i], eq.imag());
+                BOOST_REQUIRE_EQUAL(c.est_re[i], est.real());
+                BOOST_REQUIRE_EQUAL(c.est_im[i], est.imag());
+                require_close(c.h_re[i], tap.real());
+                require_close(c.h_im[i], tap.imag());
+            }
+        }
+    }
+}
+
+} /* namespace dtl */
+} /* namespace gr */
@@ -0,0 +1,85 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pad_generator.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <bitset>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+BOOST_AUTO_TEST_CASE(pad_generator_seed)
+{
+    pad_generator a(1), b(1), c(2);
+    std::vector<unsigned char> x(1001), y(1001), z(1001);
+    a.fill(x.data(), x.size());
+    b.fill(y.data(), y.size());
+    c.fill(z.data(), z.size());
+    BOOST_REQUIRE(x == y);
+    BOOST_REQUIRE(x != z);
+
+    // About half of the bits set
+    size_t ones = 0;
+    for (auto v : x) {
+        ones += std::bitset<8>(v).count();
+    }
+    BOOST_REQUIRE(ones > x.size() * 8 * 45 / 100 && ones < x.size() * 8 * 55 / 100);
+}
+
+BOOST_AUTO_TEST_CASE(pad_generator_symbols)
+{
+    pad_generator gen(3);
+    for (bool table : { false, true }) {
+        gen.use_table(table);
+        for (int bps = 1; bps <= 8; bps++) {
+            // Lengths not multiple of the 8 bytes of a step
+            std::vector<unsigned char> x(4099);
+            gen.fill_symbols(x.data(), x.size(), bps);
+            std::vector<int> count(1 << bps);
+            for (auto v : x) {
+                BOOST_REQUIRE(v < (1 << bps));
+                count[v]++;
+            }
+            if (bps <= 4) {
+                for (auto n : count) {
+                    BOOST_REQUIRE(n > 0);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pad_generator_table)
+{
+    // Same padding after a reset, split into calls or not, past the table length
+    pad_generator a, b;
+    a.use_table(true);
+    b.use_table(true);
+    std::vector<unsigned char> x(200000), y(200000);
+    a.fill(x.data(), x.size());
+    size_t pos = 0;
+    for (size_t n = 1; pos < y.size(); n = n * 3 + 1) {
+        n = std::min(n, y.size() - pos);
+        b.fill(y.data() + pos, n);
+        pos += n;
+    }
+    BOOST_REQUIRE(x == y);
+
+    // Masked symbols are the low bits of the table bytes
+    a.reset();
+    std::vector<unsigned char> s(1000);
+    a.fill_symbols(s.data(), s.size(), 3);
+    for (size_t i = 0; i < s.size(); i++) {
+        BOOST_REQUIRE_EQUAL(s[i], x[i] & 7);
+    }
+    BOOST_REQUIRE(x[0] != x[1] || x[1] != x[2]);
+}
+
+} // namespace dtl
+} // namespace gr
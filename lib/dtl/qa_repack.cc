@@ -0,0 +1,105 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <gnuradio/testbed/fast_repack.h>
+#include <gnuradio/testbed/repack.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+// fast_repack against the reference repack over random inputs, split into several
+// calls to cover the state kept between calls
+static void check_repack(bool msb_first)
+{
+    std::mt19937 rng(42);
+    for (int bits_in = 1; bits_in <= 8; bits_in++) {
+        for (int bits_out = 1; bits_out <= 8; bits_out++) {
+            for (int trial = 0; trial < 50; trial++) {
+                repack ref(bits_in, bits_out);
+                fast_repack fast(bits_in, bits_out);
+                if (trial % 5 == 4) {
+                    int in_index = rng() % bits_in;
+                    int out_index = rng() % bits_out;
+                    ref.set_indexes(in_index, out_index);
+                    fast.set_indexes(in_index, out_index);
+                }
+                for (int call = 0; call < 4; call++) {
+                    size_t n_in = rng() % 300;
+                    bool full_output_symbols = rng() & 1;
+                    std::vector<unsigned char> in(n_in);
+                    for (auto& x : in) {
+                        x = rng();
+                    }
+                    // Same initial content, partially filled bytes are or-ed into it
+                    std::vector<unsigned char> out_ref(8 * n_in + 1);
+                    for (auto& x : out_ref) {
+                        x = rng();
+                    }
+                    std::vector<unsigned char> out_fast(out_ref);
+
+                    int n_ref, n_fast;
+                    if (msb_first) {
+                        n_ref = ref.repack_msb_first(
+                            in.data(), n_in, out_ref.data(), full_output_symbols);
+                        n_fast = fast.repack_msb_first(
+                            in.data(), n_in, out_fast.data(), full_output_symbols);
+                    } else {
+                        n_ref = ref.repack_lsb_first(
+                            in.data(), n_in, out_ref.data(), full_output_symbols);
+                        n_fast = fast.repack_lsb_first(
+                            in.data(), n_in, out_fast.data(), full_output_symbols);
+                    }
+                    BOOST_REQUIRE_EQUAL(n_ref, n_fast);
+                    BOOST_REQUIRE(std::equal(
+                        out_ref.begin(), out_ref.begin() + n_ref, out_fast.begin()));
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fast_repack_lsb_first) { check_repack(false); }
+
+BOOST_AUTO_TEST_CASE(fast_repack_msb_first) { check_repack(true); }
+
+// Bit ranges of packed bytes against the bits picked one by one
+BOOST_AUTO_TEST_CASE(fast_repack_range_lsb_first)
+{
+    std::mt19937 rng(42);
+    for (int bits_out = 1; bits_out <= 8; bits_out++) {
+        fast_repack fast(8, bits_out);
+        for (int trial = 0; trial < 200; trial++) {
+            int in_index = rng() % 8;
+            size_t n_bits = rng() % 300;
+            std::vector<unsigned char> in((in_index + n_bits + 7) / 8);
+            for (auto& x : in) {
+                x = rng();
+            }
+            std::vector<unsigned char> out(n_bits + 1);
+
+            int n_out =
+                fast.repack_range_lsb_first(in.data(), in_index, n_bits, out.data());
+            BOOST_REQUIRE_EQUAL(n_out, (int)((n_bits + bits_out - 1) / bits_out));
+            for (int i = 0; i < n_out; i++) {
+                unsigned char expected = 0;
+                size_t end = std::min<size_t>((i + 1) * bits_out, n_bits);
+                for (size_t b = i * bits_out; b < end; b++) {
+                    int bit = in_index + b;
+                    expected |= ((in[bit / 8] >> (bit % 8)) & 1) << (b - i * bits_out);
+                }
+                BOOST_REQUIRE_EQUAL(out[i], expected);
+            }
+        }
+    }
+}
+
+} // namespace dtl
+} // namespace gr
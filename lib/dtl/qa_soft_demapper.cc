@@ -0,0 +1,135 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "soft_demapper.h"
+#include <gnuradio/dtl/ofdm_adaptive_utils.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+static const constellation_type_t all_constellations[] = { constellation_type_t::BPSK,
+                                                            constellation_type_t::QPSK,
+                                                            constellation_type_t::PSK8,
+                                                            constellation_type_t::QAM16 };
+
+// Noisy symbols around random points, not a multiple of the vector width
+static std::vector<gr_complex> noisy_symbols(const digital::constellation_sptr& cnst,
+                                             float sigma,
+                                             std::vector<int>& sent)
+{
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0, sigma);
+    auto points = cnst->points();
+    std::vector<gr_complex> syms(1003);
+    sent.resize(syms.size());
+    for (std::size_t i = 0; i < syms.size(); ++i) {
+        sent[i] = rng() % points.size();
+        syms[i] = points[sent[i]] + gr_complex(noise(rng), noise(rng));
+    }
+    return syms;
+}
+
+static int label(const digital::constellation_sptr& cnst, int point)
+{
+    return cnst->apply_pre_diff_code() ? cnst->pre_diff_code()[point] : point;
+}
+
+// Max-log LLR of bit b, LSB first, positive for 1
+static float max_log_llr(const digital::constellation_sptr& cnst,
+                         gr_complex y,
+                         int b,
+                         float noise)
+{
+    auto points = cnst->points();
+    float min0 = INFINITY;
+    float min1 = INFINITY;
+    for (std::size_t p = 0; p < points.size(); ++p) {
+        float d = std::norm(y - points[p]);
+        if ((label(cnst, p) >> b) & 1) {
+            min1 = std::min(min1, d);
+        } else {
+            min0 = std::min(min0, d);
+        }
+    }
+    return (min0 - min1) / noise;
+}
+
+BOOST_AUTO_TEST_CASE(test_soft_demapper_max_log)
+{
+    for (auto type : all_constellations) {
+        auto cnst = get_constellation(type);
+        soft_demapper demapper(cnst);
+        int bps = demapper.bits_per_symbol();
+        BOOST_REQUIRE_EQUAL(bps, (int)cnst->bits_per_symbol());
+
+        std::vector<int> sent;
+        auto syms = noisy_symbols(cnst, 0.3, sent);
+        int nsyms = syms.size();
+        const float noise = 0.2;
+        std::vector<float> llrs(nsyms * bps);
+        demapper.demap(syms.data(), nsyms, noise, llrs.data());
+
+        // Per symbol SNR, as 1 / N0
+        std::vector<float> snr(nsyms);
+        for (int i = 0; i < nsyms; ++i) {
+            snr[i] = 0.5f + i % 7;
+        }
+        std::vector<float> weighted(nsyms * bps);
+        demapper.demap(syms.data(), nsyms, snr.data(), weighted.data());
+
+        for (int i = 0; i < nsyms; ++i) {
+            for (int b = 0; b < bps; ++b) {
+                float expected = max_log_llr(cnst, syms[i], b, noise);
+                BOOST_REQUIRE_SMALL(llrs[i * bps + b] - expected,
+                                    1e-4f * (1 + std::abs(expected)));
+                float expected_weighted = expected * noise * snr[i];
+                BOOST_REQUIRE_SMALL(weighted[i * bps + b] - expected_weighted,
+                                    1e-4f * (1 + std::abs(expected_weighted)));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_soft_demapper_calc_soft_dec)
+{
+    // Same bit order and sign as calc_soft_dec, which returns the LLRs of a symbol
+    // MSB first. Its metric is exact rather than max-log, so the values are only
+    // compared near the points, where both give the bits of the sent point.
+    for (auto type : all_constellations) {
+        auto cnst = get_constellation(type);
+        soft_demapper demapper(cnst);
+        int bps = demapper.bits_per_symbol();
+
+        std::vector<int> sent;
+        auto syms = noisy_symbols(cnst, 0.02, sent);
+        int nsyms = syms.size();
+        const float noise = 0.01;
+        std::vector<float> llrs(nsyms * bps);
+        demapper.demap(syms.data(), nsyms, noise, llrs.data());
+
+        for (int i = 0; i < nsyms; ++i) {
+            std::vector<float> ref = cnst->calc_soft_dec(syms[i], noise);
+            BOOST_REQUIRE_EQUAL((int)ref.size(), bps);
+            for (int b = 0; b < bps; ++b) {
+                float gr_llr = ref[bps - 1 - b];
+                float llr = llrs[i * bps + b];
+                bool bit = (label(cnst, sent[i]) >> b) & 1;
+                BOOST_REQUIRE(!std::isnan(gr_llr));
+                BOOST_REQUIRE_EQUAL(gr_llr > 0, bit);
+                BOOST_REQUIRE_EQUAL(llr > 0, bit);
+            }
+        }
+    }
+}
+
+} /* namespace dtl */
+} /* namespace gr */
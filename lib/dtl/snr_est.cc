@@ -0,0 +1,174 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/dtl/snr_est.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+static double to_db(double x)
+{
+    return 10 * log10(max(x, numeric_limits<double>::min()));
+}
+
+snr_est_base::snr_est_base(double alpha) : d_alpha(alpha), d_beta(1 - alpha)
+{
+    if (alpha <= 0 || alpha > 1) {
+        throw invalid_argument("SNR estimator alpha must be in (0, 1]");
+    }
+    d_beta_lanes = pow(d_beta, LANES);
+    for (int l = 0; l < LANES; l++) {
+        d_lane_weight[l] = pow(d_beta, LANES - 1 - l);
+    }
+}
+
+template <int M, class F>
+void snr_est_base::average(int n, double* y, F moments) const
+{
+    // Lane l of chunk c holds sample c * LANES + l, weighted by
+    // beta^(LANES * (n_chunks - 1 - c)) until the end of the chunks
+    float acc[M][LANES] = {};
+    int n_chunks = n / LANES;
+    for (int c = 0; c < n_chunks; c++) {
+        float x[M][LANES];
+        for (int l = 0; l < LANES; l++) {
+            moments(c * LANES + l, x, l);
+        }
+        for (int k = 0; k < M; k++) {
+            for (int l = 0; l < LANES; l++) {
+                acc[k][l] = acc[k][l] * d_beta_lanes + x[k][l];
+            }
+        }
+    }
+    float tail[M] = {};
+    for (int i = n_chunks * LANES; i < n; i++) {
+        float x[M][LANES];
+        moments(i, x, 0);
+        for (int k = 0; k < M; k++) {
+            tail[k] = tail[k] * d_beta + x[k][0];
+        }
+    }
+
+    double beta_tail = pow(d_beta, n - n_chunks * LANES);
+    double beta_n = pow(d_beta, n);
+    for (int k = 0; k < M; k++) {
+        double sum = 0;
+        for (int l = 0; l < LANES; l++) {
+            sum += d_lane_weight[l] * acc[k][l];
+        }
+        y[k] = beta_n * y[k] + d_alpha * (beta_tail * sum + tail[k]);
+    }
+}
+
+
+snr_est_simple::snr_est_simple(double alpha) : snr_est_base(alpha) { reset(); }
+
+void snr_est_simple::reset() { d_y[0] = d_y[1] = 0; }
+
+int snr_est_simple::update(int n, const gr_complex* input)
+{
+    average<2>(n, d_y, [input](int i, float(&x)[2][LANES], int l) {
+        float power = input[i].real() * input[i].real() + input[i].imag() * input[i].imag();
+        x[0][l] = sqrt(power);
+        x[1][l] = power;
+    });
+    return n;
+}
+
+double snr_est_simple::snr() const
+{
+    double signal = d_y[0] * d_y[0];
+    return 10 * log10(signal / (d_y[1] - signal));
+}
+
+double snr_est_simple::noise() const { return to_db(d_y[1] - d_y[0] * d_y[0]); }
+
+
+snr_est_m2m4::snr_est_m2m4(double alpha) : snr_est_base(alpha) { reset(); }
+
+void snr_est_m2m4::reset() { d_y[0] = d_y[1] = 0; }
+
+int snr_est_m2m4::update(int n, const gr_complex* input)
+{
+    average<2>(n, d_y, [input](int i, float(&x)[2][LANES], int l) {
+        float power = input[i].real() * input[i].real() + input[i].imag() * input[i].imag();
+        x[0][l] = power;
+        x[1][l] = power * power;
+    });
+    return n;
+}
+
+double snr_est_m2m4::snr() const
+{
+    double signal = sqrt(max(2 * d_y[0] * d_y[0] - d_y[1], 0.0));
+    return 10 * log10(signal / (d_y[0] - signal));
+}
+
+double snr_est_m2m4::noise() const
+{
+    return to_db(d_y[0] - sqrt(max(2 * d_y[0] * d_y[0] - d_y[1], 0.0)));
+}
+
+
+snr_est_svr::snr_est_svr(double alpha) : snr_est_base(alpha) { reset(); }
+
+void snr_est_svr::reset()
+{
+    d_y[0] = d_y[1] = d_y[2] = 0;
+    d_last_power = -1;
+}
+
+int snr_est_svr::update(int n, const gr_complex* input)
+{
+    if (n == 0) {
+        return 0;
+    }
+    auto power = [input](int i) {
+        return input[i].real() * input[i].real() + input[i].imag() * input[i].imag();
+    };
+    // The first sample is paired with the last one of the previous batch, and
+    // skipped after a reset
+    if (d_last_power >= 0) {
+        float last_power = d_last_power;
+        average<3>(1, d_y, [&](int, float(&x)[3][LANES], int l) {
+            float p = power(0);
+            x[0][l] = p;
+            x[1][l] = p * last_power;
+            x[2][l] = p * p;
+        });
+    }
+    average<3>(n - 1, d_y, [&](int i, float(&x)[3][LANES], int l) {
+        float p = power(i + 1);
+        x[0][l] = p;
+        x[1][l] = p * power(i);
+        x[2][l] = p * p;
+    });
+    d_last_power = power(n - 1);
+    return n;
+}
+
+double snr_est_svr::snr() const
+{
+    double x = d_y[1] / (d_y[2] - d_y[1]);
+    return 10 * log10(x - 1 + sqrt(x * (x - 1)));
+}
+
+double snr_est_svr::noise() const
+{
+    double x = d_y[1] / (d_y[2] - d_y[1]);
+    double snr = x - 1 + sqrt(x * (x - 1));
+    return to_db(d_y[0] / (1 + snr));
+}
+
+} // namespace dtl
+} // namespace gr
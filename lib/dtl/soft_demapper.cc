@@ -0,0 +1,252 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "soft_demapper.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DTL_DEMAP_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DTL_DEMAP_NEON 1
+#endif
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+namespace {
+
+// Largest constellation handled by the generic kernel
+const int MAX_BPS = 8;
+
+const float MAX_DIST = numeric_limits<float>::max();
+
+void demap_generic(const soft_demapper::table_t& t,
+                   const gr_complex* in,
+                   int nsyms,
+                   const float* scale,
+                   bool per_symbol,
+                   float* out)
+{
+    int npoints = t.re.size();
+    for (int i = 0; i < nsyms; ++i) {
+        float min0[MAX_BPS];
+        float min1[MAX_BPS];
+        fill(min0, min0 + t.bps, MAX_DIST);
+        fill(min1, min1 + t.bps, MAX_DIST);
+        for (int p = 0; p < npoints; ++p) {
+            float dr = in[i].real() - t.re[p];
+            float di = in[i].imag() - t.im[p];
+            float d = dr * dr + di * di;
+            for (int b = 0; b < t.bps; ++b) {
+                if ((t.labels[p] >> b) & 1) {
+                    min1[b] = min(min1[b], d);
+                } else {
+                    min0[b] = min(min0[b], d);
+                }
+            }
+        }
+        for (int b = 0; b < t.bps; ++b) {
+            out[i * t.bps + b] = (min0[b] - min1[b]) * scale[per_symbol ? i : 0];
+        }
+    }
+}
+
+#if DTL_DEMAP_X86
+
+template <int BPS>
+__attribute__((target("avx2"))) void demap_avx2(const soft_demapper::table_t& t,
+                                                const gr_complex* in,
+                                                int nsyms,
+                                                const float* scale,
+                                                bool per_symbol,
+                                                float* out)
+{
+    const float* x = reinterpret_cast<const float*>(in);
+    int npoints = t.re.size();
+    int i = 0;
+    for (; i + 8 <= nsyms; i += 8) {
+        // Deinterleave 8 complex samples
+        __m256 a = _mm256_loadu_ps(x + 2 * i);
+        __m256 b = _mm256_loadu_ps(x + 2 * i + 8);
+        __m256 re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 im = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        re = _mm256_castpd_ps(
+            _mm256_permute4x64_pd(_mm256_castps_pd(re), _MM_SHUFFLE(3, 1, 2, 0)));
+        im = _mm256_castpd_ps(
+            _mm256_permute4x64_pd(_mm256_castps_pd(im), _MM_SHUFFLE(3, 1, 2, 0)));
+
+        __m256 min0[BPS];
+        __m256 min1[BPS];
+        for (int j = 0; j < BPS; ++j) {
+            min0[j] = _mm256_set1_ps(MAX_DIST);
+            min1[j] = min0[j];
+        }
+        for (int p = 0; p < npoints; ++p) {
+            __m256 dr = _mm256_sub_ps(re, _mm256_set1_ps(t.re[p]));
+            __m256 di = _mm256_sub_ps(im, _mm256_set1_ps(t.im[p]));
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(dr, dr), _mm256_mul_ps(di, di));
+            for (int j = 0; j < BPS; ++j) {
+                if ((t.labels[p] >> j) & 1) {
+                    min1[j] = _mm256_min_ps(min1[j], d);
+                } else {
+                    min0[j] = _mm256_min_ps(min0[j], d);
+                }
+            }
+        }
+
+        __m256 vscale =
+            per_symbol ? _mm256_loadu_ps(scale + i) : _mm256_set1_ps(scale[0]);
+        float llr[BPS][8];
+        for (int j = 0; j < BPS; ++j) {
+            _mm256_storeu_ps(llr[j], _mm256_mul_ps(_mm256_sub_ps(min0[j], min1[j]), vscale));
+        }
+        for (int s = 0; s < 8; ++s) {
+            for (int j = 0; j < BPS; ++j) {
+                out[(i + s) * BPS + j] = llr[j][s];
+            }
+        }
+    }
+    demap_generic(
+        t, in + i, nsyms - i, per_symbol ? scale + i : scale, per_symbol, out + i * BPS);
+}
+
+bool cpu_has_avx2()
+{
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+#endif // DTL_DEMAP_X86
+
+
+#if DTL_DEMAP_NEON
+
+template <int BPS>
+void demap_neon(const soft_demapper::table_t& t,
+                const gr_complex* in,
+                int nsyms,
+                const float* scale,
+                bool per_symbol,
+                float* out)
+{
+    const float* x = reinterpret_cast<const float*>(in);
+    int npoints = t.re.size();
+    int i = 0;
+    for (; i + 4 <= nsyms; i += 4) {
+        float32x4x2_t y = vld2q_f32(x + 2 * i);
+
+        float32x4_t min0[BPS];
+        float32x4_t min1[BPS];
+        for (int j = 0; j < BPS; ++j) {
+            min0[j] = vdupq_n_f32(MAX_DIST);
+            min1[j] = min0[j];
+        }
+        for (int p = 0; p < npoints; ++p) {
+            float32x4_t dr = vsubq_f32(y.val[0], vdupq_n_f32(t.re[p]));
+            float32x4_t di = vsubq_f32(y.val[1], vdupq_n_f32(t.im[p]));
+            float32x4_t d = vmlaq_f32(vmulq_f32(dr, dr), di, di);
+            for (int j = 0; j < BPS; ++j) {
+                if ((t.labels[p] >> j) & 1) {
+                    min1[j] = vminq_f32(min1[j], d);
+                } else {
+                    min0[j] = vminq_f32(min0[j], d);
+                }
+            }
+        }
+
+        float32x4_t vscale = per_symbol ? vld1q_f32(scale + i) : vdupq_n_f32(scale[0]);
+        float llr[BPS][4];
+        for (int j = 0; j < BPS; ++j) {
+            vst1q_f32(llr[j], vmulq_f32(vsubq_f32(min0[j], min1[j]), vscale));
+        }
+        for (int s = 0; s < 4; ++s) {
+            for (int j = 0; j < BPS; ++j) {
+                out[(i + s) * BPS + j] = llr[j][s];
+            }
+        }
+    }
+    demap_generic(
+        t, in + i, nsyms - i, per_symbol ? scale + i : scale, per_symbol, out + i * BPS);
+}
+
+#endif // DTL_DEMAP_NEON
+
+
+soft_demapper::kernel_t get_demap_kernel(int bps)
+{
+#if DTL_DEMAP_X86
+    if (cpu_has_avx2()) {
+        switch (bps) {
+        case 1:
+            return demap_avx2<1>;
+        case 2:
+            return demap_avx2<2>;
+        case 3:
+            return demap_avx2<3>;
+        case 4:
+            return demap_avx2<4>;
+        }
+    }
+#elif DTL_DEMAP_NEON
+    switch (bps) {
+    case 1:
+        return demap_neon<1>;
+    case 2:
+        return demap_neon<2>;
+    case 3:
+        return demap_neon<3>;
+    case 4:
+        return demap_neon<4>;
+    }
+#endif
+    return demap_generic;
+}
+
+} // namespace
+
+soft_demapper::soft_demapper(const digital::constellation_sptr& constellation)
+{
+    vector<gr_complex> points(constellation->points());
+    vector<int> pre_diff_code(constellation->pre_diff_code());
+    int npoints = points.size();
+    d_table.bps = constellation->bits_per_symbol();
+    if (d_table.bps < 1 || d_table.bps > MAX_BPS || npoints > (1 << d_table.bps)) {
+        throw invalid_argument("soft_demapper: unsupported constellation");
+    }
+
+    for (int i = 0; i < npoints; ++i) {
+        d_table.re.push_back(points[i].real());
+        d_table.im.push_back(points[i].imag());
+        d_table.labels.push_back(constellation->apply_pre_diff_code() ? pre_diff_code[i]
+                                                                      : i);
+    }
+    d_kernel = get_demap_kernel(d_table.bps);
+}
+
+void soft_demapper::demap(const gr_complex* in, int nsyms, float noise, float* out) const
+{
+    float scale = 1.0f / noise;
+    d_kernel(d_table, in, nsyms, &scale, false, out);
+}
+
+void soft_demapper::demap(const gr_complex* in,
+                          int nsyms,
+                          const float* snr,
+                          float* out) const
+{
+    d_kernel(d_table, in, nsyms, snr, true, out);
+}
+
+} // namespace dtl
+} // namespace gr
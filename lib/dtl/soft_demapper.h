@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_SOFT_DEMAPPER_H
+#define INCLUDED_DTL_SOFT_DEMAPPER_H
+
+#include <gnuradio/digital/constellation.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Max-log LLR demapper for a gr::digital constellation.
+ *
+ * The points and bit labels (pre-differential code included) are taken from the
+ * constellation, so the LLRs match the mapping of create_constellation() for
+ * every constellation type. For each bit:
+ *
+ *   LLR = (min |y - s|^2 over s with bit 0 - min |y - s|^2 over s with bit 1) / N0
+ *
+ * i.e. positive for bit 1, as expected by the FEC decoders. The LLRs of a
+ * symbol are written LSB of the symbol value first.
+ *
+ * demap() processes a whole frame per call with AVX2/NEON kernels, 8/4
+ * symbols per vector, and never allocates.
+ */
+class soft_demapper
+{
+public:
+    struct table_t {
+        int bps;
+        std::vector<float> re;
+        std::vector<float> im;
+        std::vector<int> labels;
+    };
+
+    // LLRs scaled by scale[0], or by scale[i] for symbol i if per_symbol
+    typedef void (*kernel_t)(const table_t& table,
+                             const gr_complex* in,
+                             int nsyms,
+                             const float* scale,
+                             bool per_symbol,
+                             float* out);
+
+    explicit soft_demapper(const digital::constellation_sptr& constellation);
+
+    int bits_per_symbol() const { return d_table.bps; }
+
+    // nsyms * bits_per_symbol() LLRs for noise variance noise
+    void demap(const gr_complex* in, int nsyms, float noise, float* out) const;
+
+    // Same with an effective SNR 1 / N0 per symbol, e.g. |H_k|^2 / sigma^2 of
+    // the carrier a zero forcing equalized symbol was received on
+    void demap(const gr_complex* in, int nsyms, const float* snr, float* out) const;
+
+private:
+    table_t d_table;
+    kernel_t d_kernel;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_SOFT_DEMAPPER_H */
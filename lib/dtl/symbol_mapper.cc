@@ -0,0 +1,172 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "symbol_mapper.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DTL_MAP_X86 1
+#endif
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+namespace {
+
+// Largest constellation of the tables
+const int MAX_BPS = 8;
+
+void map_generic(const symbol_mapper::table_t& t,
+                 const unsigned char* in,
+                 int nsyms,
+                 gr_complex* out)
+{
+    for (int i = 0; i < nsyms; ++i) {
+        out[i] = t.points[in[i]];
+    }
+}
+
+void map_packed_generic(const symbol_mapper::table_t& t,
+                        const unsigned char* in,
+                        int nsyms,
+                        gr_complex* out)
+{
+    for (int i = 0; i < nsyms; ++i) {
+        int bit = i * t.bps;
+        int shift = bit & 7;
+        unsigned int value = in[bit >> 3] >> shift;
+        if (shift + t.bps > 8) {
+            value |= in[(bit >> 3) + 1] << (8 - shift);
+        }
+        out[i] = t.points[value & t.mask];
+    }
+}
+
+#if DTL_MAP_X86
+
+/*
+ * Points of the 8 symbol values of idx, by permutes of the real and imaginary
+ * tables. permutevar8x32 uses the 3 low bits of the index, bit 3 selects the
+ * upper half of the 16 point tables.
+ */
+template <int BPS>
+__attribute__((target("avx2"))) inline void
+store_points(const symbol_mapper::table_t& t, __m256i idx, gr_complex* out)
+{
+    __m256 re = _mm256_permutevar8x32_ps(_mm256_load_ps(t.re), idx);
+    __m256 im = _mm256_permutevar8x32_ps(_mm256_load_ps(t.im), idx);
+    if (BPS == 4) {
+        __m256 upper = _mm256_castsi256_ps(_mm256_slli_epi32(idx, 28));
+        re = _mm256_blendv_ps(
+            re, _mm256_permutevar8x32_ps(_mm256_load_ps(t.re + 8), idx), upper);
+        im = _mm256_blendv_ps(
+            im, _mm256_permutevar8x32_ps(_mm256_load_ps(t.im + 8), idx), upper);
+    }
+    // Interleave to (re, im) pairs of symbols 0-3 and 4-7
+    __m256 lo = _mm256_unpacklo_ps(re, im);
+    __m256 hi = _mm256_unpackhi_ps(re, im);
+    float* x = reinterpret_cast<float*>(out);
+    _mm256_storeu_ps(x, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(x + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+template <int BPS>
+__attribute__((target("avx2"))) void map_avx2(const symbol_mapper::table_t& t,
+                                              const unsigned char* in,
+                                              int nsyms,
+                                              gr_complex* out)
+{
+    const __m256i mask = _mm256_set1_epi32(t.mask);
+    int i = 0;
+    for (; i + 8 <= nsyms; i += 8) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+        __m256i idx = _mm256_and_si256(_mm256_cvtepu8_epi32(bytes), mask);
+        store_points<BPS>(t, idx, out + i);
+    }
+    map_generic(t, in + i, nsyms - i, out + i);
+}
+
+template <int BPS>
+__attribute__((target("avx2"))) void map_packed_avx2(const symbol_mapper::table_t& t,
+                                                     const unsigned char* in,
+                                                     int nsyms,
+                                                     gr_complex* out)
+{
+    // 8 symbols are the BPS bytes at in + i * BPS / 8
+    const __m256i shifts = _mm256_setr_epi32(
+        0, BPS, 2 * BPS, 3 * BPS, 4 * BPS, 5 * BPS, 6 * BPS, 7 * BPS);
+    const __m256i mask = _mm256_set1_epi32(t.mask);
+    int i = 0;
+    for (; i + 8 <= nsyms; i += 8) {
+        uint32_t word = 0;
+        memcpy(&word, in + i * BPS / 8, BPS);
+        __m256i idx = _mm256_and_si256(
+            _mm256_srlv_epi32(_mm256_set1_epi32(word), shifts), mask);
+        store_points<BPS>(t, idx, out + i);
+    }
+    map_packed_generic(t, in + i * BPS / 8, nsyms - i, out + i);
+}
+
+bool cpu_has_avx2()
+{
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+#endif // DTL_MAP_X86
+
+
+symbol_mapper::kernel_t get_map_kernel(int bps, bool packed)
+{
+#if DTL_MAP_X86
+    if (cpu_has_avx2()) {
+        switch (bps) {
+        case 1:
+            return packed ? map_packed_avx2<1> : map_avx2<1>;
+        case 2:
+            return packed ? map_packed_avx2<2> : map_avx2<2>;
+        case 3:
+            return packed ? map_packed_avx2<3> : map_avx2<3>;
+        case 4:
+            return packed ? map_packed_avx2<4> : map_avx2<4>;
+        }
+    }
+#endif
+    return packed ? map_packed_generic : map_generic;
+}
+
+} // namespace
+
+symbol_mapper::symbol_mapper(const digital::constellation_sptr& constellation)
+{
+    vector<gr_complex> points(constellation->points());
+    int npoints = points.size();
+    d_table.bps = constellation->bits_per_symbol();
+    if (d_table.bps < 1 || d_table.bps > MAX_BPS || npoints != (1 << d_table.bps) ||
+        constellation->dimensionality() != 1) {
+        throw invalid_argument("symbol_mapper: unsupported constellation");
+    }
+    d_table.mask = npoints - 1;
+
+    for (int v = 0; v < 256; ++v) {
+        d_table.points[v] = points[v & d_table.mask];
+    }
+    for (int v = 0; v < 16; ++v) {
+        d_table.re[v] = d_table.points[v].real();
+        d_table.im[v] = d_table.points[v].imag();
+    }
+    d_kernel = get_map_kernel(d_table.bps, false);
+    d_packed_kernel = get_map_kernel(d_table.bps, true);
+}
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_SYMBOL_MAPPER_H
+#define INCLUDED_DTL_SYMBOL_MAPPER_H
+
+#include <gnuradio/digital/constellation.h>
+#include <gnuradio/gr_complex.h>
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Table driven mapper of symbol values to the points of a gr::digital constellation.
+ *
+ * Symbol value v is mapped to points()[v & (2^bps - 1)], the point of
+ * constellation->map_to_points() for every valid value. map() takes one symbol
+ * value per byte; map_packed() takes the symbols packed LSB first, as
+ * fast_repack(8, bps).repack_lsb_first() would unpack them, so the repack can be
+ * skipped.
+ *
+ * The points of the 256 byte values are a flat table. Constellations of up to
+ * 16 points are also looked up with AVX2 register permutes, 8 symbols per
+ * vector. The permutes use the real and imaginary parts as two 8 or 16 entry
+ * tables. Neither call allocates.
+ */
+class symbol_mapper
+{
+public:
+    struct table_t {
+        int bps;
+        unsigned int mask;
+        // Point of every byte value
+        alignas(64) gr_complex points[256];
+        // Real and imaginary parts of the first 16 byte values
+        alignas(32) float re[16];
+        alignas(32) float im[16];
+    };
+
+    typedef void (*kernel_t)(const table_t& table,
+                             const unsigned char* in,
+                             int nsyms,
+                             gr_complex* out);
+
+    explicit symbol_mapper(const digital::constellation_sptr& constellation);
+
+    int bits_per_symbol() const { return d_table.bps; }
+
+    // nsyms symbols of one value per byte
+    void map(const unsigned char* in, int nsyms, gr_complex* out) const
+    {
+        d_kernel(d_table, in, nsyms, out);
+    }
+
+    // nsyms symbols from ceil(nsyms * bits_per_symbol() / 8) packed bytes
+    void map_packed(const unsigned char* in, int nsyms, gr_complex* out) const
+    {
+        d_packed_kernel(d_table, in, nsyms, out);
+    }
+
+private:
+    table_t d_table;
+    kernel_t d_kernel;
+    kernel_t d_packed_kernel;
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /* INCLUDED_DTL_SYMBOL_MAPPER_H */
@@ -9,6 +9,7 @@
 
 #include "fec_utils.h"
 #include <gnuradio/testbed/logger.h>
+#include <algorithm>
 #include <cstring>
 
 namespace gr {
@@ -18,15 +19,34 @@ using namespace std;
 
 INIT_DTL_LOGGER("tb_decoder");
 
-tb_decoder::tb_decoder(int max_tb_len)
-    : d_payload(0), d_tb_number(-1), d_buf_idx(0), d_fec_info(nullptr)
+tb_decoder::tb_decoder(int max_tb_len, int nthreads, int max_in_flight, bool incremental)
+    : d_payload(0),
+      d_tb_payload_len(0),
+      d_tb_number(-1),
+      d_buf_idx(0),
+      d_tb_len(0),
+      d_fec_info(nullptr),
+      d_n(0),
+      d_ncheck(0),
+      d_layout_valid(false),
+      d_cw_idx(0),
+      d_cw_pos(0),
+      d_receiving(false),
+      d_incremental(incremental && nthreads <= 0),
+      d_decoded_cws(0)
 {
-    DTL_LOG_DEBUG("max_tb_len={}", max_tb_len);
-    d_tb_buffers.resize(2);
-    d_tb_buffers[RCV_BUF].reserve(2 * max_tb_len);
-    d_tb_buffers[FULL_BUF].reserve(2 * max_tb_len);
+    DTL_LOG_DEBUG("max_tb_len={}, nthreads={}, incremental={}",
+                  max_tb_len,
+                  nthreads,
+                  d_incremental);
+    if (nthreads > 0) {
+        d_pool = make_unique<tb_decoder_pool>(nthreads, max_in_flight, 2 * max_tb_len);
+    }
+    d_cw_buf.reserve(2 * max_tb_len);
+    d_cw_payload.reserve(2 * max_tb_len);
     d_data_buffer.reserve(2 * max_tb_len);
-    d_tb_buffers[RCV_BUF].clear();
+    d_decoded_buffer.reserve(2 * max_tb_len);
+    d_n_iterations.reserve(2 * max_tb_len);
 }
 
 bool tb_decoder::process_frame(
@@ -34,7 +54,7 @@ bool tb_decoder::process_frame(
     int frame_len,
     int bps,
     fec_info_t::sptr fec_info,
-    function<void(const vector<unsigned char>&, fec_info_t::sptr, int)> on_data_ready)
+    on_data_ready_t on_data_ready)
 {
 
     if (!fec_info) {
@@ -43,7 +63,6 @@ bool tb_decoder::process_frame(
     }
 
     int frame_payload_len = fec_info->d_frame_payload;
-    int avg_it = 0;
 
     DTL_LOG_DEBUG("process_frame: current_no={}, rcvd_no={}, rcvd_offset={}, "
                   "frame_len={}, frame_payload={}",
@@ -55,59 +74,29 @@ bool tb_decoder::process_frame(
 
     // If frame is part of the current TB
     if (fec_info->d_tb_number == d_tb_number) {
-        if (d_buf_idx + frame_payload_len > d_tb_buffers[RCV_BUF].capacity()) {
-            throw runtime_error("rcv buffer does not have enough capacity!");
-        }
-        copy(in, in + frame_payload_len, back_inserter(d_tb_buffers[RCV_BUF]));
-        d_buf_idx += frame_payload_len;
-        int ncws = compute_tb_len(d_fec_info->get_n(), frame_len);
-
-        if (d_tb_buffers[RCV_BUF].size() >= expected_tb_len(fec_info, ncws)) {
-            decode(ncws, avg_it);
-            d_buf_idx = 0;
-            d_tb_buffers[RCV_BUF].clear();
-            on_data_ready(d_data_buffer, fec_info, avg_it);
+        if (d_receiving) {
+            receive(in, frame_payload_len);
+            if (tb_complete()) {
+                decode_tb(fec_info, on_data_ready);
+            }
         }
         // If frame is part of a new TB
     } else {
 
         // Small TB exclusively transported by the frame
-        if (d_tb_buffers[RCV_BUF].size() == 0 &&
-            fec_info->d_tb_offset == frame_payload_len) {
-            // Start new TB buffer
-            d_fec_info = fec_info;
-            d_tb_number = d_fec_info->d_tb_number;
-            d_tb_payload_len = d_fec_info->d_tb_payload_len;
-            d_buf_idx = 0;
-            d_tb_buffers[RCV_BUF].clear();
-
-            copy(in, in + fec_info->d_tb_offset, back_inserter(d_tb_buffers[RCV_BUF]));
-
-            int tb_len = compute_tb_len(d_fec_info->get_n(), frame_len);
-            decode(tb_len, avg_it);
-            d_tb_buffers[RCV_BUF].clear();
-            on_data_ready(d_data_buffer, fec_info, avg_it);
+        if (!d_receiving && fec_info->d_tb_offset == frame_payload_len) {
+            start_tb(fec_info, compute_tb_len(fec_info->get_n(), frame_len));
+            receive(in, fec_info->d_tb_offset);
+            decode_tb(fec_info, on_data_ready);
         } else {
 
-            // Fill current TB buffer and decode current TB
-            if (fec_info->d_tb_offset > 0) {
-                copy(
-                    in, in + fec_info->d_tb_offset, back_inserter(d_tb_buffers[RCV_BUF]));
+            // Fill current TB and decode it
+            if (d_receiving) {
+                receive(in, fec_info->d_tb_offset);
+                decode_tb(d_fec_info, on_data_ready);
             }
 
-            // Decode
-            if (d_tb_buffers[RCV_BUF].size() > 0 && d_fec_info) {
-                int tb_len = compute_tb_len(d_fec_info->get_n(), frame_len);
-                decode(tb_len, avg_it);
-                on_data_ready(d_data_buffer, d_fec_info, avg_it);
-            }
-
-            // Start new TB buffer
-            d_fec_info = fec_info;
-            d_tb_number = d_fec_info->d_tb_number;
-            d_tb_payload_len = d_fec_info->d_tb_payload_len;
-            d_buf_idx = 0;
-            d_tb_buffers[RCV_BUF].clear();
+            start_tb(fec_info, compute_tb_len(fec_info->get_n(), frame_len));
 
             // align offset to symbols
             int extra_bits = 0;
@@ -118,86 +107,232 @@ bool tb_decoder::process_frame(
             if (fec_info->d_tb_offset) {
                 new_tb_offset = fec_info->d_tb_offset + extra_bits;
             }
-            copy(in + new_tb_offset,
-                 in + frame_payload_len + extra_bits,
-                 back_inserter(d_tb_buffers[RCV_BUF]));
-            d_buf_idx += frame_payload_len - fec_info->d_tb_offset;
-
-            int tb_len = compute_tb_len(d_fec_info->get_n(), frame_len);
-            int tb_size = 8 * align_bits_to_bytes(tb_len * fec_info->d_ncheck + fec_info->d_tb_payload_len);
-            if (frame_payload_len - fec_info->d_tb_offset == tb_size) {
-                decode(tb_len, avg_it);
-                on_data_ready(d_data_buffer, d_fec_info, avg_it);
-                d_buf_idx = 0;
-                d_tb_buffers[RCV_BUF].clear();
+            receive(in + new_tb_offset, frame_payload_len + extra_bits - new_tb_offset);
+
+            // Decode as soon as the TB is in, instead of on the next frame
+            if (tb_complete()) {
+                decode_tb(d_fec_info, on_data_ready);
             }
 
             DTL_LOG_DEBUG("rcv_buf_size={}, append={}",
-                          d_tb_buffers[RCV_BUF].size(),
+                          d_buf_idx,
                           frame_payload_len + extra_bits - new_tb_offset);
         }
     }
     return true;
 }
 
-int tb_decoder::decode(int tb_len, int& avg_it)
+void tb_decoder::start_tb(fec_info_t::sptr fec_info, int tb_len)
 {
-    static const float SHORTENED_VALUE = -15;
-
-    int payload_len = d_fec_info->d_tb_payload_len;
-    int n = d_fec_info->get_n();
-    int k = d_fec_info->get_k();
-    int ncheck = n - k;
-    int n_iterations = 0;
-    avg_it = 0;
+    int n = fec_info->get_n();
+    int k = fec_info->get_k();
+    int payload_len = fec_info->d_tb_payload_len;
+
+    // The shortened slots only depend on the TB geometry
+    if (!d_layout_valid || tb_len != d_tb_len || n != d_n || n - k != d_ncheck ||
+        payload_len != d_tb_payload_len) {
+        d_cw_buf.resize(tb_len * n);
+        d_cw_payload.resize(tb_len);
+        for (int i = 0; i < tb_len; ++i) {
+            int k_ = payload_len / (tb_len - i);
+            if (payload_len % (tb_len - i)) {
+                ++k_;
+            }
+            payload_len -= k_;
+            d_cw_payload[i] = k_;
+            auto cw = d_cw_buf.begin() + i * n;
+            fill(cw + n - k + k_, cw + n, SHORTENED_LLR);
+        }
+        d_tb_len = tb_len;
+        d_n = n;
+        d_ncheck = n - k;
+        d_layout_valid = true;
+    }
 
-    DTL_LOG_DEBUG("decode: ncws={}, n_it={}, sz={}, tb_payload_len={}, n={}",
+    DTL_LOG_DEBUG("start_tb: ncws={}, tb_payload_len={}, n={}",
                   tb_len,
-                  n_iterations,
-                  d_tb_buffers[FULL_BUF].size(),
-                  payload_len,
+                  fec_info->d_tb_payload_len,
                   n);
 
-    d_data_buffer.resize(d_fec_info->d_tb_payload_len);
-    d_tb_buffers[FULL_BUF].clear();
-    fill(
-        &d_tb_buffers[FULL_BUF][0], &d_tb_buffers[FULL_BUF][tb_len * n], SHORTENED_VALUE);
+    d_fec_info = fec_info;
+    d_tb_number = fec_info->d_tb_number;
+    d_tb_payload_len = fec_info->d_tb_payload_len;
+    d_buf_idx = 0;
+    d_cw_idx = 0;
+    d_cw_pos = 0;
+    d_receiving = true;
+
+    if (!d_pool) {
+        d_decoded_buffer.resize(tb_len * align_bits_to_bytes(k));
+        d_n_iterations.resize(tb_len);
+        d_decoded_cws = 0;
+    }
+}
 
-    int rcv_idx = 0;
+void tb_decoder::receive(const float* in, int len)
+{
+    d_buf_idx += len;
+    while (len > 0 && d_cw_idx < d_tb_len) {
+        int cw_len = d_ncheck + d_cw_payload[d_cw_idx];
+        int m = min(len, cw_len - d_cw_pos);
+        memcpy(&d_cw_buf[d_cw_idx * d_n + d_cw_pos], in, m * sizeof(float));
+        in += m;
+        len -= m;
+        d_cw_pos += m;
+        if (d_cw_pos == cw_len) {
+            ++d_cw_idx;
+            d_cw_pos = 0;
+        }
+    }
+
+    if (d_incremental && d_cw_idx > d_decoded_cws) {
+        decode_received_cws();
+    }
+}
+
+void tb_decoder::decode_received_cws()
+{
+    int kbytes = align_bits_to_bytes(d_fec_info->get_k());
+    int ncws = d_cw_idx - d_decoded_cws;
+
+    DTL_LOG_DEBUG("decode_cws: first={}, ncws={}", d_decoded_cws, ncws);
+    d_fec_info->d_dec->decode_batch_packed(&d_cw_buf[d_decoded_cws * d_n],
+                                           ncws,
+                                           &d_n_iterations[d_decoded_cws],
+                                           &d_decoded_buffer[d_decoded_cws * kbytes]);
+    d_decoded_cws = d_cw_idx;
+}
+
+int tb_decoder::collect_tb(fec_info_t::sptr tb_fec_info,
+                           int tb_len,
+                           const unsigned char* decoded,
+                           const int* n_iterations,
+                           const int* cw_payload)
+{
+    int kbytes = align_bits_to_bytes(tb_fec_info->get_k());
+    int avg_it = 0;
+
+    d_data_buffer.resize(align_bits_to_bytes(tb_fec_info->d_tb_payload_len));
     for (int i = 0, d_idx = 0; i < tb_len; ++i) {
-        int k_ = payload_len / (tb_len - i);
-        if (payload_len % (tb_len - i)) {
-            ++k_;
+        copy_bits(&decoded[i * kbytes], 0, &d_data_buffer[0], d_idx, cw_payload[i]);
+        d_idx += cw_payload[i];
+
+        DTL_LOG_DEBUG("decode: n_it={}, k_={}", n_iterations[i], cw_payload[i]);
+        avg_it += n_iterations[i];
+    }
+    return avg_it / tb_len;
+}
+
+void tb_decoder::decode_tb(fec_info_t::sptr fec_info,
+                           const on_data_ready_t& on_data_ready)
+{
+    int tb_len = d_tb_len;
+    d_receiving = false;
+
+    // LLRs of a truncated TB are unknown, decode them as erasures
+    while (!tb_complete()) {
+        auto cw = d_cw_buf.begin() + d_cw_idx * d_n;
+        fill(cw + d_cw_pos, cw + d_ncheck + d_cw_payload[d_cw_idx], 0);
+        ++d_cw_idx;
+        d_cw_pos = 0;
+    }
+
+    DTL_LOG_DEBUG("decode: ncws={}, rcvd={}, tb_payload_len={}",
+                  tb_len,
+                  d_buf_idx,
+                  d_fec_info->d_tb_payload_len);
+
+    if (!d_pool) {
+        // Decode the codewords left, the whole TB unless incremental
+        if (d_decoded_cws < tb_len) {
+            decode_received_cws();
         }
-        payload_len -= k_;
-
-        // copy check bits
-        copy(&d_tb_buffers[RCV_BUF][rcv_idx],
-             &d_tb_buffers[RCV_BUF][rcv_idx + ncheck],
-             d_tb_buffers[FULL_BUF].begin() + i * n);
-        rcv_idx += ncheck;
-        // copy systematic bits
-        copy(&d_tb_buffers[RCV_BUF][rcv_idx],
-             &d_tb_buffers[RCV_BUF][rcv_idx + k_],
-             d_tb_buffers[FULL_BUF].begin() + i * n + ncheck);
-        rcv_idx += k_;
-
-        d_fec_info->d_dec->decode(
-            &d_tb_buffers[FULL_BUF][i * n], &n_iterations, &d_data_buffer[d_idx]);
-        d_idx += k_;
-
-        DTL_LOG_DEBUG("decode: n_it={}, k_={}", n_iterations, k_);
-        avg_it += n_iterations;
+
+        int avg_it = collect_tb(
+            d_fec_info, tb_len, &d_decoded_buffer[0], &d_n_iterations[0], &d_cw_payload[0]);
+        on_data_ready(d_data_buffer, fec_info, avg_it);
+        return;
     }
-    avg_it /= tb_len;
 
-    return tb_len * ncheck + d_fec_info->d_tb_payload_len;
+    // Make room for the TB: the oldest one is handed over whatever its size, the
+    // caller leaves room for it in the output (see free_slots())
+    if (d_pool->pending() == d_pool->capacity()) {
+        deliver_front(*d_pool->front(true), on_data_ready);
+    }
+
+    // Hand the arena over to the job, the job's buffers become the next arena
+    auto& job = d_pool->next_job();
+    job.tb_fec_info = d_fec_info;
+    job.fec_info = fec_info;
+    job.tb_len = tb_len;
+    job.llrs.swap(d_cw_buf);
+    job.cw_payload.swap(d_cw_payload);
+    d_layout_valid = false;
+    d_pool->submit();
+}
+
+int tb_decoder::deliver_front(tb_decoder_pool::tb_job_t& job,
+                              const on_data_ready_t& on_data_ready)
+{
+    int avg_it = 0;
+    if (job.failed) {
+        DTL_LOG_ERROR("tb_failed: tb_no={}", job.fec_info->d_tb_number);
+        d_data_buffer.clear();
+    } else {
+        avg_it = collect_tb(job.tb_fec_info,
+                            job.tb_len,
+                            &job.decoded[0],
+                            &job.n_iterations[0],
+                            &job.cw_payload[0]);
+    }
+    on_data_ready(d_data_buffer, job.fec_info, avg_it);
+    d_pool->pop();
+    return d_data_buffer.size();
 }
 
-std::size_t tb_decoder::expected_tb_len(fec_info_t::sptr fec_info, int ncws)
+int tb_decoder::deliver(std::size_t max_pending,
+                        int space,
+                        const on_data_ready_t& on_data_ready)
+{
+    int delivered = 0;
+    if (!d_pool) {
+        return delivered;
+    }
+    while (auto job = d_pool->front(d_pool->pending() > max_pending)) {
+        int nbytes = job->failed
+                         ? 0
+                         : align_bits_to_bytes(job->tb_fec_info->d_tb_payload_len);
+        if (delivered + nbytes > space) {
+            DTL_LOG_DEBUG("deliver: tb_no={} waits for output space, space={}",
+                          job->fec_info->d_tb_number,
+                          space - delivered);
+            break;
+        }
+        delivered += deliver_front(*job, on_data_ready);
+    }
+    return delivered;
+}
+
+int tb_decoder::poll(int space, const on_data_ready_t& on_data_ready, bool wait_oldest)
+{
+    if (d_pool && d_pool->pending()) {
+        return deliver(wait_oldest ? d_pool->pending() - 1 : d_pool->capacity(),
+                       space,
+                       on_data_ready);
+    }
+    return 0;
+}
+
+int tb_decoder::flush(int space, const on_data_ready_t& on_data_ready)
+{
+    return deliver(0, space, on_data_ready);
+}
+
+std::size_t tb_decoder::pending() const { return d_pool ? d_pool->pending() : 0; }
+
+std::size_t tb_decoder::free_slots() const
 {
-    int total_check = (fec_info->get_n() - fec_info->get_k()) * ncws;
-    return total_check + fec_info->d_tb_payload_len;
+    return d_pool ? d_pool->capacity() - d_pool->pending() : 0;
 }
 
 } // namespace dtl
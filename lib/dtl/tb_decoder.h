@@ -9,24 +9,40 @@
 #define INCLUDED_DTL_TB_DECODER_H
 
 #include "fec_utils.h"
+#include "tb_decoder_pool.h"
 #include <gnuradio/dtl/fec.h>
 #include <functional>
+#include <memory>
 
 
 namespace gr {
 namespace dtl {
 
+/*!
+ * Transport block decoder.
+ *
+ * Codewords are decoded to packed hard decisions, and on_data_ready() gets the
+ * TB payload (data and CRC) as packed bytes, LSB first. A TB the worker pool
+ * failed to decode is handed over with an empty payload.
+ */
 class tb_decoder
 {
 
-private:
-    enum buffers_id_t {
-        RCV_BUF = 0,
-        FULL_BUF,
-    };
+public:
+    typedef std::function<void(const std::vector<unsigned char>&, fec_info_t::sptr, int)>
+        on_data_ready_t;
 
-    std::vector<std::vector<float>> d_tb_buffers;
+private:
+    /*
+     * Receive arena: the codewords of the TB being received, ncws * n LLRs.
+     * Frames are scattered straight to the check and systematic slots of each
+     * codeword, the shortened slots keep SHORTENED_LLR from start_tb().
+     */
+    std::vector<float> d_cw_buf;
     std::vector<unsigned char> d_data_buffer;
+    std::vector<unsigned char> d_decoded_buffer;
+    std::vector<int> d_n_iterations;
+    std::vector<int> d_cw_payload;
 
     int d_payload;
     int d_tb_payload_len;
@@ -34,26 +50,94 @@ private:
     std::size_t d_buf_idx;
     int d_tb_len;
     fec_info_t::sptr d_fec_info;
+    std::unique_ptr<tb_decoder_pool> d_pool;
+
+    // TB geometry the shortened slots of d_cw_buf are laid out for
+    int d_n;
+    int d_ncheck;
+    bool d_layout_valid;
+    // Next LLR slot: codeword and position in its check and systematic bits
+    int d_cw_idx;
+    int d_cw_pos;
+    bool d_receiving;
+    // Decode codewords as they complete, d_decoded_cws of the TB are done
+    bool d_incremental;
+    int d_decoded_cws;
+
+    void start_tb(fec_info_t::sptr fec_info, int tb_len);
+
+    // Scatters the next len LLRs of the TB, the ones past its end are dropped
+    void receive(const float* in, int len);
+
+    bool tb_complete() const { return d_cw_idx == d_tb_len; }
 
-    int decode(int tb_len, int& avg_it);
+    // Decodes the received codewords not decoded yet, without the worker pool
+    void decode_received_cws();
 
-    std::size_t expected_tb_len(fec_info_t::sptr fec_info, int ncws);
+    int collect_tb(fec_info_t::sptr tb_fec_info,
+                   int tb_len,
+                   const unsigned char* decoded,
+                   const int* n_iterations,
+                   const int* cw_payload);
+
+    void decode_tb(fec_info_t::sptr fec_info, const on_data_ready_t& on_data_ready);
+
+    // Hands over the oldest TB of the worker pool, returns its payload bytes
+    int deliver_front(tb_decoder_pool::tb_job_t& job,
+                      const on_data_ready_t& on_data_ready);
+
+    /*
+     * Hand over decoded TBs in order, waiting until at most max_pending remain,
+     * while their payloads fit in space bytes. Returns the bytes handed over.
+     */
+    int deliver(std::size_t max_pending, int space, const on_data_ready_t& on_data_ready);
 
 public:
     typedef std::shared_ptr<tb_decoder> sptr;
 
+    /*!
+     * Hands over the TBs the frame completes: up to two without the worker
+     * pool, and with it up to two TBs already decoded if the pool is full, see
+     * free_slots().
+     */
     bool process_frame(const float* in,
                        int frame_len,
                        int bps,
                        fec_info_t::sptr fec_info,
-                       std::function<void(const std::vector<unsigned char>&,
-                                          fec_info_t::sptr, int)> on_data_ready);
+                       on_data_ready_t on_data_ready);
 
-    int get_current_tb_payload() { return d_fec_info->d_tb_payload_len; };
+    /*!
+     * Hand over the TBs the worker pool has finished, in order, without waiting
+     * unless wait_oldest is set, then the oldest one is waited for. Stops before
+     * the first TB whose payload does not fit in the space bytes left, it stays
+     * pending. Returns the bytes handed over.
+     */
+    int poll(int space, const on_data_ready_t& on_data_ready, bool wait_oldest = false);
 
-    bool receive_buffer_empty() { return d_tb_buffers[RCV_BUF].size() == 0; }
+    // Hand over the TBs still decoding in the worker pool that fit in space bytes
+    int flush(int space, const on_data_ready_t& on_data_ready);
+
+    // TBs submitted to the worker pool and not handed over yet
+    std::size_t pending() const;
+
+    // TBs that can be submitted to the worker pool without handing one over
+    std::size_t free_slots() const;
+
+    int get_current_tb_payload() { return d_fec_info->d_tb_payload_len; };
 
-    explicit tb_decoder(int max_tb_len);
+    bool receive_buffer_empty() { return !d_receiving; }
+
+    /*!
+     * nthreads > 0 decodes TBs in a pool of nthreads workers with at most
+     * max_in_flight TBs pending; decoded TBs are still handed over in order.
+     * Otherwise the codewords of a TB are decoded in batches once it is
+     * received, unless incremental decodes each codeword as soon as it is
+     * received.
+     */
+    explicit tb_decoder(int max_tb_len,
+                        int nthreads = 0,
+                        int max_in_flight = DEFAULT_MAX_TB_IN_FLIGHT,
+                        bool incremental = false);
 };
 
 } // namespace dtl
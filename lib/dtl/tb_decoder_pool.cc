@@ -0,0 +1,170 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "tb_decoder_pool.h"
+#include <gnuradio/testbed/logger.h>
+#include <exception>
+
+namespace gr {
+namespace dtl {
+
+using namespace std;
+
+INIT_DTL_LOGGER("tb_decoder_pool");
+
+tb_decoder_pool::tb_decoder_pool(int nthreads, int max_in_flight, int max_tb_len)
+    : d_jobs(max_in_flight), d_head(0), d_count(0), d_nthreads(nthreads), d_stop(false)
+{
+    DTL_LOG_DEBUG("nthreads={}, max_in_flight={}, max_tb_len={}",
+                  nthreads,
+                  max_in_flight,
+                  max_tb_len);
+    if (nthreads < 1 || max_in_flight < 1) {
+        throw invalid_argument("tb_decoder_pool: invalid configuration");
+    }
+    for (auto& job : d_jobs) {
+        job.llrs.reserve(max_tb_len);
+        job.decoded.reserve(max_tb_len);
+        job.n_iterations.reserve(max_tb_len);
+        job.cw_payload.reserve(max_tb_len);
+        job.pending = 0;
+        job.failed = false;
+    }
+    for (int i = 0; i < nthreads; ++i) {
+        d_workers.emplace_back(&tb_decoder_pool::run, this);
+    }
+}
+
+tb_decoder_pool::~tb_decoder_pool()
+{
+    {
+        lock_guard<mutex> lock(d_mutex);
+        d_stop = true;
+    }
+    d_task_cv.notify_all();
+    for (auto& worker : d_workers) {
+        worker.join();
+    }
+}
+
+tb_decoder_pool::tb_job_t& tb_decoder_pool::next_job()
+{
+    return d_jobs[(d_head + d_count) % d_jobs.size()];
+}
+
+void tb_decoder_pool::submit()
+{
+    tb_job_t& job = next_job();
+    int kbytes = align_bits_to_bytes(job.tb_fec_info->get_k());
+    job.decoded.resize(job.tb_len * kbytes);
+    job.n_iterations.resize(job.tb_len);
+
+    // Spread the codewords evenly over the workers
+    int chunk = (job.tb_len + d_nthreads - 1) / d_nthreads;
+    {
+        lock_guard<mutex> lock(d_mutex);
+        job.pending = 0;
+        job.failed = false;
+        for (int first = 0; first < job.tb_len; first += chunk) {
+            d_tasks.push_back({ &job, first, min(chunk, job.tb_len - first) });
+            ++job.pending;
+        }
+    }
+    ++d_count;
+    d_task_cv.notify_all();
+}
+
+tb_decoder_pool::tb_job_t* tb_decoder_pool::front(bool wait)
+{
+    if (d_count == 0) {
+        return nullptr;
+    }
+    tb_job_t& job = d_jobs[d_head];
+    unique_lock<mutex> lock(d_mutex);
+    if (wait) {
+        d_done_cv.wait(lock, [&job] { return job.pending == 0; });
+    }
+    return (job.pending == 0) ? &job : nullptr;
+}
+
+void tb_decoder_pool::pop()
+{
+    d_head = (d_head + 1) % d_jobs.size();
+    --d_count;
+}
+
+void tb_decoder_pool::decode(map<fec_dec*, fec_dec::sptr>& decoders,
+                             const task_t& task)
+{
+    tb_job_t& job = *task.job;
+    fec_dec* dec = job.tb_fec_info->d_dec.get();
+    auto it = decoders.find(dec);
+    if (it == decoders.end()) {
+        it = decoders.emplace(dec, dec->clone()).first;
+    }
+    int n = dec->get_n();
+    int kbytes = align_bits_to_bytes(dec->get_k());
+    if (it->second) {
+        it->second->decode_batch_packed(&job.llrs[task.first_cw * n],
+                                        task.ncws,
+                                        &job.n_iterations[task.first_cw],
+                                        &job.decoded[task.first_cw * kbytes]);
+    } else {
+        // Decoder can't be cloned: serialize the access to the shared instance
+        lock_guard<mutex> lock(d_serial_mutex);
+        dec->decode_batch_packed(&job.llrs[task.first_cw * n],
+                                 task.ncws,
+                                 &job.n_iterations[task.first_cw],
+                                 &job.decoded[task.first_cw * kbytes]);
+    }
+}
+
+void tb_decoder_pool::run()
+{
+    // Decoders keep internal buffers: each worker decodes with its own copies.
+    map<fec_dec*, fec_dec::sptr> decoders;
+
+    while (true) {
+        task_t task;
+        {
+            unique_lock<mutex> lock(d_mutex);
+            d_task_cv.wait(lock, [this] { return d_stop || !d_tasks.empty(); });
+            if (d_stop) {
+                return;
+            }
+            task = d_tasks.front();
+            d_tasks.pop_front();
+        }
+
+        tb_job_t& job = *task.job;
+        bool failed = false;
+        try {
+            decode(decoders, task);
+        } catch (const exception& e) {
+            DTL_LOG_ERROR("decode failed: tb_len={}, first_cw={}, error={}",
+                          job.tb_len,
+                          task.first_cw,
+                          e.what());
+            failed = true;
+        } catch (...) {
+            DTL_LOG_ERROR("decode failed: tb_len={}, first_cw={}",
+                          job.tb_len,
+                          task.first_cw);
+            failed = true;
+        }
+
+        {
+            lock_guard<mutex> lock(d_mutex);
+            job.failed |= failed;
+            --job.pending;
+        }
+        d_done_cv.notify_all();
+    }
+}
+
+} // namespace dtl
+} // namespace gr
@@ -0,0 +1,102 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_DTL_TB_DECODER_POOL_H
+#define INCLUDED_DTL_TB_DECODER_POOL_H
+
+#include "fec_utils.h"
+#include <gnuradio/dtl/fec.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace gr {
+namespace dtl {
+
+/*!
+ * Fixed pool of worker threads decoding transport blocks.
+ *
+ * TBs are kept in a ring of max_in_flight job slots in submission order, so
+ * they are handed back in order even if workers finish them out of order.
+ * Each TB is split in chunks of codewords decoded in parallel, every worker
+ * uses its own clone of the FEC decoders. An exception thrown while decoding
+ * does not leave the worker, the TB is marked failed instead.
+ *
+ * next_job(), submit(), front() and pop() must be called from a single thread.
+ */
+class tb_decoder_pool
+{
+public:
+    struct tb_job_t {
+        // TB state used for decoding
+        fec_info_t::sptr tb_fec_info;
+        // FEC info handed over with the decoded data
+        fec_info_t::sptr fec_info;
+        int tb_len;
+        std::vector<float> llrs;
+        // Packed data bits, (k + 7) / 8 bytes per codeword
+        std::vector<unsigned char> decoded;
+        std::vector<int> n_iterations;
+        std::vector<int> cw_payload;
+        int pending;
+        // Set if a worker failed to decode a chunk of the TB
+        bool failed;
+    };
+
+    tb_decoder_pool(int nthreads, int max_in_flight, int max_tb_len);
+    ~tb_decoder_pool();
+
+    std::size_t capacity() const { return d_jobs.size(); }
+
+    std::size_t pending() const { return d_count; }
+
+    // Free slot for the next TB, valid only if pending() < capacity()
+    tb_job_t& next_job();
+
+    // Start decoding the TB prepared in next_job()
+    void submit();
+
+    // Oldest TB if decoded (or once decoded if wait is set), nullptr otherwise
+    tb_job_t* front(bool wait);
+
+    // Release the oldest TB slot
+    void pop();
+
+private:
+    struct task_t {
+        tb_job_t* job;
+        int first_cw;
+        int ncws;
+    };
+
+    std::vector<tb_job_t> d_jobs;
+    std::size_t d_head;
+    std::size_t d_count;
+    int d_nthreads;
+
+    std::deque<task_t> d_tasks;
+    std::vector<std::thread> d_workers;
+    std::mutex d_mutex;
+    std::mutex d_serial_mutex;
+    std::condition_variable d_task_cv;
+    std::condition_variable d_done_cv;
+    bool d_stop;
+
+    // Decodes the codewords of task with the worker's decoders
+    void decode(std::map<fec_dec*, fec_dec::sptr>& decoders, const task_t& task);
+
+    void run();
+};
+
+} // namespace dtl
+} // namespace gr
+
+#endif /*INCLUDED_DTL_TB_DECODER_POOL_H*/
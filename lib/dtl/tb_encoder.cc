@@ -7,8 +7,8 @@
 
 #include "tb_encoder.h"
 
+#include "fec_utils.h"
 #include <gnuradio/testbed/logger.h>
-#include <gnuradio/testbed/repack.h>
 #include <cstring>
 
 namespace gr {
@@ -19,13 +19,12 @@ using namespace std;
 INIT_DTL_LOGGER("tb_encoder");
 
 tb_encoder::tb_encoder(int max_tb_len, int max_cw_len)
-    : d_cw_buffers(2), d_payload(0)
+    : d_tb_len(0), d_payload(0), d_buf_idx(0), d_repack(8, 1)
 {
-    d_cw_buffers[0].resize(max_cw_len);
-    d_cw_buffers[1].resize(max_cw_len);
-    d_tb_buffers.resize(2);
-    d_tb_buffers[0].reserve(max_tb_len);
-    d_tb_buffers[1].reserve(max_tb_len);
+    d_cw_data.resize(align_bits_to_bytes(max_cw_len));
+    d_cw.resize(align_bits_to_bytes(max_cw_len));
+    // Codewords starting on a byte are encoded in place, shortened bits included
+    d_tb.resize(align_bits_to_bytes(max_tb_len + max_cw_len));
 }
 
 
@@ -36,12 +35,14 @@ int tb_encoder::encode(const unsigned char* in,
 {
 
     int read_index = 0;
+    int n = enc->get_n();
+    int k = enc->get_k();
+    int ncheck = n - k;
 
-    d_tb_buffers[0].clear();
-    d_tb_buffers[1].clear();
+    d_tb_len = current_tb_len * ncheck + len;
     d_payload = 0;
     d_buf_idx = 0;
-    int ncheck = enc->get_n() - enc->get_k();
+    int tb_idx = 0;
 
     DTL_LOG_DEBUG("encode: ncws={}", current_tb_len);
 
@@ -52,47 +53,50 @@ int tb_encoder::encode(const unsigned char* in,
         }
         d_payload += k_new;
 
-        // copy K' bits from input into the buffer
-        memset(&d_cw_buffers[0][0], 0, enc->get_n());
-        memcpy(&d_cw_buffers[0][0], &in[read_index], k_new);
-
-        // calculate the codeword
-        enc->encode(&d_cw_buffers[0][0], enc->get_k(), &d_cw_buffers[1][0]);
-
+        // Unshortened codewords on a byte boundary are encoded from the input,
+        // the others from a copy of K' bits followed by zero shortened bits
+        const unsigned char* cw_data = &in[read_index / 8];
+        if (k_new != k || read_index % 8) {
+            copy_bits(in, read_index, &d_cw_data[0], 0, k_new);
+            int k_new_bytes = align_bits_to_bytes(k_new);
+            memset(&d_cw_data[k_new_bytes], 0, align_bits_to_bytes(k) - k_new_bytes);
+            cw_data = &d_cw_data[0];
+        }
         read_index += k_new;
 
-        // Move cw to the TB buffer
-        copy(&d_cw_buffers[1][0],
-             &d_cw_buffers[1][ncheck],
-             back_inserter(d_tb_buffers[0]));
-        copy(&d_cw_buffers[1][ncheck],
-             &d_cw_buffers[1][ncheck + k_new],
-             back_inserter(d_tb_buffers[0]));
+        // Calculate the codeword straight into the TB if it starts on a byte: the
+        // shortened bits past the check and K' data bits are overwritten by the
+        // next codeword. Otherwise move it from the codeword buffer.
+        if (tb_idx % 8 == 0) {
+            enc->encode_packed(cw_data, &d_tb[tb_idx / 8]);
+        } else {
+            enc->encode_packed(cw_data, &d_cw[0]);
+            copy_bits(&d_cw[0], 0, &d_tb[0], tb_idx, ncheck + k_new);
+        }
+        tb_idx += ncheck + k_new;
     }
 
-    return d_tb_buffers[0].size();
+    return d_tb_len;
 }
 
 bool tb_encoder::ready() const
 {
-    return d_tb_buffers[0].size() == 0 || d_tb_buffers[0].size() == d_buf_idx;
+    return d_tb_len == 0 || static_cast<size_t>(d_tb_len) == d_buf_idx;
 }
 
-int tb_encoder::remaining_buf_size()
-{
-    return static_cast<int>(d_tb_buffers[0].size() - d_buf_idx);
-}
+int tb_encoder::remaining_buf_size() { return static_cast<int>(d_tb_len - d_buf_idx); }
 
-int tb_encoder::size() { return static_cast<int>(d_tb_buffers[0].size()); }
+int tb_encoder::size() { return d_tb_len; }
 
 int tb_encoder::buf_out(unsigned char* out, int len, int bps)
 {
-    repack repacker(1, bps);
-    int syms = repacker.repack_lsb_first(&d_tb_buffers[0][d_buf_idx], len, out);
+    d_repack.set_bits_per_byte(8, bps);
+    int syms =
+        d_repack.repack_range_lsb_first(&d_tb[d_buf_idx / 8], d_buf_idx % 8, len, out);
     d_buf_idx += len;
     DTL_LOG_DEBUG("buf_out: idx={}, size={}, n_syms={}, len={}",
                   d_buf_idx,
-                  d_tb_buffers[0].size(),
+                  d_tb_len,
                   syms,
                   len);
     return syms;
@@ -101,4 +105,4 @@ int tb_encoder::buf_out(unsigned char* out, int len, int bps)
 int tb_encoder::buf_payload() { return d_payload; }
 
 } // namespace dtl
-} // namespace gr
\ No newline at end of file
+} // namespace gr
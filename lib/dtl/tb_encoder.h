@@ -9,18 +9,29 @@
 #define INCLUDED_DTL_TB_ENCODER_H
 
 #include <gnuradio/dtl/fec.h>
+#include <gnuradio/testbed/fast_repack.h>
 
 
 namespace gr {
 namespace dtl {
 
+/*!
+ * Transport block encoder.
+ *
+ * Data, codewords and the encoded TB are kept packed, LSB first: lengths and
+ * indexes are in bits but every buffer holds 8 bits per byte, and buf_out()
+ * cuts the constellation symbols straight from the packed TB.
+ */
 class tb_encoder
 {
 private:
-    std::vector<std::vector<unsigned char>> d_cw_buffers;
-    std::vector<std::vector<unsigned char>> d_tb_buffers;
+    std::vector<unsigned char> d_cw_data;
+    std::vector<unsigned char> d_cw;
+    std::vector<unsigned char> d_tb;
+    int d_tb_len;
     int d_payload;
     std::size_t d_buf_idx;
+    fast_repack d_repack;
 
 public:
 
@@ -28,6 +39,7 @@ public:
 
     tb_encoder(int max_tb_len, int max_cw_len);
 
+    // Encodes the first len bits of the packed bytes in
     int encode(const unsigned char* in, int len, fec_enc::sptr enc, int current_tb_len);
 
     int buf_out(unsigned char* out, int len, int bps);
@@ -0,0 +1,394 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/testbed/crc_engine.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DTL_CRC_X86 1
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#include <arm_neon.h>
+#define DTL_CRC_PMULL 1
+#endif
+
+namespace gr {
+namespace dtl {
+
+namespace {
+
+const uint32_t CRC32_POLY = 0x04C11DB7;
+// Shortest input worth folding: the 4 x 16 byte accumulators have to be filled
+const std::size_t FOLD_MIN_LEN = 64;
+
+inline uint64_t load_le64(const unsigned char* p)
+{
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+
+inline uint32_t load_be32(const unsigned char* p)
+{
+    uint32_t x;
+    memcpy(&x, p, sizeof(x));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    x = __builtin_bswap32(x);
+#endif
+    return x;
+}
+
+uint32_t reflect(uint32_t v, unsigned num_bits)
+{
+    uint32_t r = 0;
+    for (unsigned i = 0; i < num_bits; ++i) {
+        r = (r << 1) | ((v >> i) & 1);
+    }
+    return r;
+}
+
+/*
+ * Folding constants of the reflected CRC-32, from "Fast CRC Computation for
+ * Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009): x^(4*128+32),
+ * x^(4*128-32) mod P for the 64 byte folds, x^(128+32), x^(128-32) mod P for the
+ * 16 byte ones, x^64 mod P, then P and floor(x^64 / P) for the Barrett reduction,
+ * all bit reflected.
+ */
+const uint64_t K1 = 0x0154442bd4;
+const uint64_t K2 = 0x01c6e41596;
+const uint64_t K3 = 0x01751997d0;
+const uint64_t K4 = 0x00ccaa009e;
+const uint64_t K5 = 0x0163cd6124;
+const uint64_t P_X = 0x01db710641;
+const uint64_t U_PRIME = 0x01f7011641;
+
+#if DTL_CRC_X86
+
+// Lambdas don't inherit the target attribute, helpers need their own
+__attribute__((target("pclmul,sse4.1"))) inline __m128i
+fold16_pclmul(__m128i x, __m128i k, __m128i next)
+{
+    __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+// len is a multiple of 16 of at least FOLD_MIN_LEN
+__attribute__((target("pclmul,sse4.1"))) uint32_t
+crc32_fold_pclmul(const unsigned char* data, std::size_t len, uint32_t rem)
+{
+    auto load = [](const unsigned char* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    };
+
+    __m128i x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(rem));
+    __m128i x2 = load(data + 16);
+    __m128i x3 = load(data + 32);
+    __m128i x4 = load(data + 48);
+    data += 64;
+    len -= 64;
+
+    // Fold 64 bytes per step in 4 independent accumulators
+    __m128i k = _mm_set_epi64x(K2, K1);
+    while (len >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), load(data));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), load(data + 16));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), load(data + 32));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), load(data + 48));
+        data += 64;
+        len -= 64;
+    }
+
+    // Fold the accumulators into one, then 16 bytes per step
+    k = _mm_set_epi64x(K4, K3);
+    x1 = fold16_pclmul(x1, k, x2);
+    x1 = fold16_pclmul(x1, k, x3);
+    x1 = fold16_pclmul(x1, k, x4);
+    while (len >= 16) {
+        x1 = fold16_pclmul(x1, k, load(data));
+        data += 16;
+        len -= 16;
+    }
+
+    // 128 to 64 bits
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, _mm_set_epi64x(0, K5), 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_set_epi64x(U_PRIME, P_X);
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return _mm_extract_epi32(x1, 1);
+}
+
+#endif // DTL_CRC_X86
+
+
+#if DTL_CRC_PMULL
+
+// Low (or high) 64 bits of a times those of b, as _mm_clmulepi64_si128
+inline uint64x2_t clmul(uint64x2_t a, int a_hi, uint64x2_t b, int b_hi)
+{
+    poly64_t pa = a_hi ? vgetq_lane_u64(a, 1) : vgetq_lane_u64(a, 0);
+    poly64_t pb = b_hi ? vgetq_lane_u64(b, 1) : vgetq_lane_u64(b, 0);
+    return vreinterpretq_u64_p128(vmull_p64(pa, pb));
+}
+
+// Shift right by n bytes, as _mm_srli_si128
+template <int N>
+inline uint64x2_t shift_bytes(uint64x2_t x)
+{
+    return vreinterpretq_u64_u8(
+        vextq_u8(vreinterpretq_u8_u64(x), vdupq_n_u8(0), N));
+}
+
+uint32_t crc32_fold_pmull(const unsigned char* data, std::size_t len, uint32_t rem)
+{
+    auto load = [](const unsigned char* p) {
+        return vreinterpretq_u64_u8(vld1q_u8(p));
+    };
+    auto make = [](uint64_t lo, uint64_t hi) {
+        return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+    };
+
+    uint64x2_t x1 = veorq_u64(load(data), make(rem, 0));
+    uint64x2_t x2 = load(data + 16);
+    uint64x2_t x3 = load(data + 32);
+    uint64x2_t x4 = load(data + 48);
+    data += 64;
+    len -= 64;
+
+    // Fold 64 bytes per step in 4 independent accumulators
+    uint64x2_t k = make(K1, K2);
+    auto fold16 = [&k](uint64x2_t x, uint64x2_t next) {
+        return veorq_u64(veorq_u64(clmul(x, 1, k, 1), clmul(x, 0, k, 0)), next);
+    };
+    while (len >= 64) {
+        x1 = fold16(x1, load(data));
+        x2 = fold16(x2, load(data + 16));
+        x3 = fold16(x3, load(data + 32));
+        x4 = fold16(x4, load(data + 48));
+        data += 64;
+        len -= 64;
+    }
+
+    // Fold the accumulators into one, then 16 bytes per step
+    k = make(K3, K4);
+    x1 = fold16(x1, x2);
+    x1 = fold16(x1, x3);
+    x1 = fold16(x1, x4);
+    while (len >= 16) {
+        x1 = fold16(x1, load(data));
+        data += 16;
+        len -= 16;
+    }
+
+    // 128 to 64 bits
+    const uint64x2_t mask32 = make(0xFFFFFFFF, 0xFFFFFFFF);
+    x2 = clmul(x1, 0, k, 1);
+    x1 = veorq_u64(shift_bytes<8>(x1), x2);
+    x2 = shift_bytes<4>(x1);
+    x1 = vandq_u64(x1, mask32);
+    x1 = clmul(x1, 0, make(K5, 0), 0);
+    x1 = veorq_u64(x1, x2);
+
+    // Barrett reduction to 32 bits
+    k = make(P_X, U_PRIME);
+    x2 = vandq_u64(x1, mask32);
+    x2 = clmul(x2, 0, k, 1);
+    x2 = vandq_u64(x2, mask32);
+    x2 = clmul(x2, 0, k, 0);
+    x1 = veorq_u64(x1, x2);
+    return vgetq_lane_u32(vreinterpretq_u32_u64(x1), 1);
+}
+
+#endif // DTL_CRC_PMULL
+
+crc_engine::fold_t get_crc32_fold()
+{
+#if DTL_CRC_X86
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+        return crc32_fold_pclmul;
+    }
+#elif DTL_CRC_PMULL
+    return crc32_fold_pmull;
+#endif
+    return nullptr;
+}
+
+} // namespace
+
+crc_engine::crc_engine(unsigned num_bits,
+                       uint32_t poly,
+                       uint32_t initial_value,
+                       uint32_t final_xor,
+                       bool input_reflected,
+                       bool result_reflected)
+    : d_num_bits(num_bits),
+      d_mask(num_bits < 32 ? (1u << num_bits) - 1 : 0xFFFFFFFF),
+      d_final_xor(final_xor & d_mask),
+      d_input_reflected(input_reflected),
+      d_result_reflected(result_reflected),
+      d_tables(8 * 256),
+      d_fold(nullptr)
+{
+    if (num_bits == 0 || num_bits > 32) {
+        throw std::invalid_argument("crc_engine: CRC width must be 1 to 32 bits");
+    }
+    poly &= d_mask;
+    initial_value &= d_mask;
+
+    // Reflected CRCs shift right, the others are kept in the upper bits of the
+    // register so both shift whole bytes out
+    if (input_reflected) {
+        d_poly = reflect(poly, num_bits);
+        d_initial_value = reflect(initial_value, num_bits);
+    } else {
+        d_poly = poly << (32 - num_bits);
+        d_initial_value = initial_value << (32 - num_bits);
+    }
+
+    uint32_t* t = d_tables.data();
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t r = input_reflected ? i : i << 24;
+        for (int b = 0; b < 8; ++b) {
+            if (input_reflected) {
+                r = (r & 1) ? (r >> 1) ^ d_poly : r >> 1;
+            } else {
+                r = (r & 0x80000000) ? (r << 1) ^ d_poly : r << 1;
+            }
+        }
+        t[i] = r;
+    }
+    for (int k = 1; k < 8; ++k) {
+        for (int i = 0; i < 256; ++i) {
+            uint32_t r = t[(k - 1) * 256 + i];
+            if (input_reflected) {
+                t[k * 256 + i] = (r >> 8) ^ t[r & 0xFF];
+            } else {
+                t[k * 256 + i] = (r << 8) ^ t[r >> 24];
+            }
+        }
+    }
+
+    if (num_bits == 32 && poly == CRC32_POLY && input_reflected) {
+        d_fold = get_crc32_fold();
+    }
+}
+
+uint32_t crc_engine::update(uint32_t rem, const unsigned char* data, std::size_t len) const
+{
+    if (d_fold && len >= FOLD_MIN_LEN) {
+        std::size_t n = len & ~static_cast<std::size_t>(15);
+        rem = d_fold(data, n, rem);
+        data += n;
+        len -= n;
+    }
+    if (d_input_reflected) {
+        return update_reflected(rem, data, len);
+    }
+    return update_normal(rem, data, len);
+}
+
+uint32_t
+crc_engine::update_reflected(uint32_t rem, const unsigned char* data, std::size_t len) const
+{
+    const uint32_t* t = d_tables.data();
+    for (; len >= 8; data += 8, len -= 8) {
+        uint64_t x = load_le64(data) ^ rem;
+        rem = t[7 * 256 + (x & 0xFF)] ^ t[6 * 256 + ((x >> 8) & 0xFF)] ^
+              t[5 * 256 + ((x >> 16) & 0xFF)] ^ t[4 * 256 + ((x >> 24) & 0xFF)] ^
+              t[3 * 256 + ((x >> 32) & 0xFF)] ^ t[2 * 256 + ((x >> 40) & 0xFF)] ^
+              t[1 * 256 + ((x >> 48) & 0xFF)] ^ t[x >> 56];
+    }
+    for (; len; ++data, --len) {
+        rem = t[(rem ^ *data) & 0xFF] ^ (rem >> 8);
+    }
+    return rem;
+}
+
+uint32_t
+crc_engine::update_normal(uint32_t rem, const unsigned char* data, std::size_t len) const
+{
+    const uint32_t* t = d_tables.data();
+    for (; len >= 8; data += 8, len -= 8) {
+        uint32_t a = rem ^ load_be32(data);
+        uint32_t b = load_be32(data + 4);
+        rem = t[7 * 256 + (a >> 24)] ^ t[6 * 256 + ((a >> 16) & 0xFF)] ^
+              t[5 * 256 + ((a >> 8) & 0xFF)] ^ t[4 * 256 + (a & 0xFF)] ^
+              t[3 * 256 + (b >> 24)] ^ t[2 * 256 + ((b >> 16) & 0xFF)] ^
+              t[1 * 256 + ((b >> 8) & 0xFF)] ^ t[b & 0xFF];
+    }
+    for (; len; ++data, --len) {
+        rem = (rem << 8) ^ t[(rem >> 24) ^ *data];
+    }
+    return rem;
+}
+
+uint32_t
+crc_engine::update_bits(uint32_t rem, const unsigned char* bits, std::size_t nbits) const
+{
+    // Bytes of 8 bits, first bit at the end shifted out first
+    unsigned char buf[64];
+    while (nbits >= 8) {
+        std::size_t nbytes = std::min(nbits / 8, sizeof(buf));
+        for (std::size_t i = 0; i < nbytes; ++i) {
+            uint64_t x = load_le64(bits + 8 * i) & 0x0101010101010101ULL;
+            buf[i] = d_input_reflected ? (x * 0x0102040810204080ULL) >> 56
+                                       : (x * 0x8040201008040201ULL) >> 56;
+        }
+        rem = update(rem, buf, nbytes);
+        bits += 8 * nbytes;
+        nbits -= 8 * nbytes;
+    }
+
+    for (; nbits; ++bits, --nbits) {
+        if (d_input_reflected) {
+            rem ^= *bits & 1;
+            rem = (rem & 1) ? (rem >> 1) ^ d_poly : rem >> 1;
+        } else {
+            rem ^= static_cast<uint32_t>(*bits & 1) << 31;
+            rem = (rem & 0x80000000) ? (rem << 1) ^ d_poly : rem << 1;
+        }
+    }
+    return rem;
+}
+
+uint32_t crc_engine::finish(uint32_t rem) const
+{
+    if (!d_input_reflected) {
+        rem >>= 32 - d_num_bits;
+    }
+    if (d_input_reflected != d_result_reflected) {
+        rem = reflect(rem, d_num_bits);
+    }
+    return (rem ^ d_final_xor) & d_mask;
+}
+
+} /* namespace dtl */
+} /* namespace gr */
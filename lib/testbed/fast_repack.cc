@@ -0,0 +1,298 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2023 DTL.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gnuradio/testbed/fast_repack.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+namespace dtl {
+
+namespace {
+
+inline uint64_t load_le64(const unsigned char* p)
+{
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+
+inline void store_le64(unsigned char* p, uint64_t x)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    memcpy(p, &x, sizeof(x));
+}
+
+// Bit 0 of 8 bytes to a byte, first byte to bit 0 (or to bit 7 if MSB first)
+template <bool MSB>
+inline uint64_t pack8(uint64_t x)
+{
+    x &= 0x0101010101010101ULL;
+    return MSB ? (x * 0x8040201008040201ULL) >> 56 : (x * 0x0102040810204080ULL) >> 56;
+}
+
+// Bits of a byte to 8 bytes, bit 0 (or bit 7 if MSB first) to the first byte
+template <bool MSB>
+inline uint64_t unpack8(uint64_t x)
+{
+    x = (x | (x << 28)) & 0x0000000F0000000FULL;
+    x = (x | (x << 14)) & 0x0003000300030003ULL;
+    x = (x | (x << 7)) & 0x0101010101010101ULL;
+    return MSB ? __builtin_bswap64(x) : x;
+}
+
+/*
+ * Bit stream kernel. Input symbols are appended to a bit accumulator and output
+ * symbols taken from it: LSB first the oldest bit is bit 0 of acc, MSB first it
+ * is bit n_acc - 1. BI/BO of 0 take the widths from the arguments.
+ */
+template <int BI, int BO, bool MSB>
+size_t repack_kernel(const unsigned char* in,
+                     unsigned char* out,
+                     size_t n_bits,
+                     int in_index,
+                     int bits_in,
+                     int bits_out)
+{
+    const int bi = BI ? BI : bits_in;
+    const int bo = BO ? BO : bits_out;
+    const uint64_t mask_in = (1u << bi) - 1;
+    const uint64_t mask_out = (1u << bo) - 1;
+    const size_t n_full = n_bits / bo;
+    const int n_rem = n_bits % bo;
+    // Input symbols holding the n_bits bits
+    const size_t n_in = (in_index + n_bits + bi - 1) / bi;
+
+    uint64_t acc = 0;
+    int n_acc = 0;
+    size_t n_read = 0;
+    size_t n_out = 0;
+
+    auto push = [&](uint64_t v, int n) {
+        if (MSB) {
+            acc = (acc << n) | v;
+        } else {
+            acc |= v << n_acc;
+        }
+        n_acc += n;
+    };
+    auto pop = [&](int n) {
+        uint64_t v;
+        if (MSB) {
+            v = (acc >> (n_acc - n)) & ((1u << n) - 1);
+        } else {
+            v = acc & ((1u << n) - 1);
+            acc >>= n;
+        }
+        n_acc -= n;
+        return v;
+    };
+
+    // Rest of a partially consumed input symbol
+    if (in_index && n_bits) {
+        uint64_t v = in[n_read++] & mask_in;
+        push(MSB ? v & ((1u << (bi - in_index)) - 1) : v >> in_index, bi - in_index);
+    }
+
+    while (true) {
+        // Drain the accumulator first: it may already hold the last symbols
+        if (BO == 1) {
+            while (n_acc >= 8 && n_out + 8 <= n_full) {
+                store_le64(out + n_out, unpack8<MSB>(pop(8)));
+                n_out += 8;
+            }
+        }
+        while (n_acc >= bo && n_out < n_full) {
+            out[n_out++] = pop(bo) & mask_out;
+        }
+        if (n_out == n_full) {
+            break;
+        }
+
+        if (BI == 1 && BO == 8 && n_acc == 0) {
+            // 64 bits per step
+            while (n_read + 64 <= n_in && n_out + 8 <= n_full) {
+                uint64_t w = 0;
+                for (int j = 0; j < 8; ++j) {
+                    w |= pack8<MSB>(load_le64(in + n_read + 8 * j)) << (8 * j);
+                }
+                store_le64(out + n_out, w);
+                n_read += 64;
+                n_out += 8;
+            }
+            if (n_out == n_full) {
+                break;
+            }
+        }
+
+        if (BI == 1 && n_read + 8 <= n_in) {
+            push(pack8<MSB>(load_le64(in + n_read)), 8);
+            n_read += 8;
+        } else {
+            push(in[n_read++] & mask_in, bi);
+        }
+    }
+
+    // Last output symbol, partially filled from the end of the input
+    if (n_rem) {
+        while (n_read < n_in) {
+            push(in[n_read++] & mask_in, bi);
+        }
+        uint64_t v = pop(n_rem);
+        out[n_out++] = MSB ? v << (bo - n_rem) : v;
+    }
+    return n_out;
+}
+
+template <int BI, int BO>
+void select_kernels(fast_repack::kernel_t& lsb, fast_repack::kernel_t& msb)
+{
+    lsb = repack_kernel<BI, BO, false>;
+    msb = repack_kernel<BI, BO, true>;
+}
+
+} // namespace
+
+fast_repack::fast_repack(unsigned char bits_in_byte, unsigned char bits_out_byte)
+    : d_out_index(0), d_in_index(0)
+{
+    set_bits_per_byte(bits_in_byte, bits_out_byte);
+}
+
+void fast_repack::set_bits_per_byte(unsigned char bits_in_byte,
+                                    unsigned char bits_out_byte)
+{
+    if (bits_in_byte > 8 || bits_out_byte > 8) {
+        throw std::invalid_argument("fast_repack: more than 8 bits per byte");
+    }
+    d_bits_in_byte = bits_in_byte;
+    d_bits_out_byte = bits_out_byte;
+
+    switch (bits_in_byte * 16 + bits_out_byte) {
+    case 0x12:
+        select_kernels<1, 2>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x13:
+        select_kernels<1, 3>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x14:
+        select_kernels<1, 4>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x18:
+        select_kernels<1, 8>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x28:
+        select_kernels<2, 8>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x38:
+        select_kernels<3, 8>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x48:
+        select_kernels<4, 8>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x81:
+        select_kernels<8, 1>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x82:
+        select_kernels<8, 2>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x83:
+        select_kernels<8, 3>(d_lsb_kernel, d_msb_kernel);
+        break;
+    case 0x84:
+        select_kernels<8, 4>(d_lsb_kernel, d_msb_kernel);
+        break;
+    default:
+        select_kernels<0, 0>(d_lsb_kernel, d_msb_kernel);
+    }
+}
+
+int fast_repack::repack_lsb_first(unsigned char const* in,
+                                  size_t n_in,
+                                  unsigned char* out,
+                                  bool full_output_symbols)
+{
+    return repack_bits(in, n_in, out, full_output_symbols, false);
+}
+
+int fast_repack::repack_msb_first(unsigned char const* in,
+                                  size_t n_in,
+                                  unsigned char* out,
+                                  bool full_output_symbols)
+{
+    return repack_bits(in, n_in, out, full_output_symbols, true);
+}
+
+int fast_repack::repack_bits(unsigned char const* in,
+                             size_t n_in,
+                             unsigned char* out,
+                             bool full_output_symbols,
+                             bool msb_first)
+{
+    const int bi = d_bits_in_byte;
+    const int bo = d_bits_out_byte;
+
+    size_t bytes_to_write = n_in * bi / bo;
+    if (((n_in * bi) % bo) != 0) {
+        bytes_to_write += static_cast<int>(!full_output_symbols);
+    }
+
+    size_t n_read = 0;
+    size_t n_written = 0;
+
+    // Complete an output byte left open by set_indexes() bit by bit, like repack
+    while (d_out_index && n_written < bytes_to_write && n_read < n_in) {
+        int in_shift = msb_first ? bi - 1 - d_in_index : d_in_index;
+        int out_shift = msb_first ? bo - 1 - d_out_index : d_out_index;
+        out[n_written] |= ((in[n_read] >> in_shift) & 0x01) << out_shift;
+
+        d_in_index = (d_in_index + 1) % bi;
+        d_out_index = (d_out_index + 1) % bo;
+        if (d_in_index == 0) {
+            n_read++;
+        }
+        if (d_out_index == 0) {
+            n_written++;
+        }
+    }
+    if (d_out_index) {
+        d_out_index = 0;
+        return n_written + 1;
+    }
+
+    size_t n_avail = n_read < n_in ? (n_in - n_read) * bi - d_in_index : 0;
+    size_t n_bits = std::min((bytes_to_write - n_written) * bo, n_avail);
+    kernel_t kernel = msb_first ? d_msb_kernel : d_lsb_kernel;
+    n_written += kernel(in + n_read, out + n_written, n_bits, d_in_index, bi, bo);
+    d_in_index = (d_in_index + n_bits) % bi;
+
+    return n_written;
+}
+
+int fast_repack::repack_range_lsb_first(unsigned char const* in,
+                                        int in_index,
+                                        size_t n_bits,
+                                        unsigned char* out)
+{
+    return d_lsb_kernel(in, out, n_bits, in_index, d_bits_in_byte, d_bits_out_byte);
+}
+
+void fast_repack::set_indexes(unsigned char in_index, unsigned char out_index)
+{
+    d_out_index = out_index;
+    d_in_index = in_index;
+}
+
+} /* namespace dtl */
+} /* namespace gr */
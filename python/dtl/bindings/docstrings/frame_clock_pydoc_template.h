@@ -0,0 +1,55 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, dtl, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+
+static const char* __doc_gr_dtl_frame_clock = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_frame_clock = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_make = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_start = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_wait = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_advance = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_frame_index = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_frame_duration = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_virtual_time = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_set_time_tags = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_time_tags = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_frame_time = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_clock_tx_time = R"doc()doc";
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, dtl, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_dtl_mcs_t = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_mcs_channel = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_mcs_channel_mcs_channel = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_mcs_channel_make = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_mcs_channel_publish = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_mcs_channel_read = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_mcs_channel_version = R"doc()doc";
@@ -31,9 +31,16 @@ static const char*
 static const char* __doc_gr_dtl_ofdm_adaptive_equalizer_base_get_snr = R"doc()doc";
 
 
+static const char* __doc_gr_dtl_ofdm_adaptive_equalizer_base_get_effective_snr =
+    R"doc()doc";
+
+
 static const char* __doc_gr_dtl_ofdm_adaptive_equalizer_base_get_noise = R"doc()doc";
 
 
+static const char* __doc_gr_dtl_ofdm_adaptive_equalizer_base_get_carrier_snr = R"doc()doc";
+
+
 static const char* __doc_gr_dtl_ofdm_adaptive_equalizer_base_equalize_0 = R"doc()doc";
 
 
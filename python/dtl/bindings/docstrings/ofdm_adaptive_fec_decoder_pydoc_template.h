@@ -23,3 +23,7 @@ static const char* __doc_gr_dtl_ofdm_adaptive_fec_decoder_ofdm_adaptive_fec_deco
 
 
 static const char* __doc_gr_dtl_ofdm_adaptive_fec_decoder_make = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_fec_decoder_set_link_adaptation =
+    R"doc()doc";
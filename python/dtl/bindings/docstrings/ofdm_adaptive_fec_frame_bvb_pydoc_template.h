@@ -31,3 +31,19 @@ static const char* __doc_gr_dtl_ofdm_adaptive_fec_frame_bvb_make = R"doc()doc";
 
 static const char* __doc_gr_dtl_ofdm_adaptive_fec_frame_bvb_process_feedback =
     R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_fec_frame_bvb_set_feedback_channel =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_fec_frame_bvb_set_header_channel =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_fec_frame_bvb_set_frame_clock =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_fec_frame_bvb_set_burst_frames =
+    R"doc()doc";
@@ -28,7 +28,15 @@ static const char*
         R"doc()doc";
 
 
-static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_base_get_feedback =
+static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_base_get_feedback_0 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_base_get_feedback_1 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_base_report_tb =
     R"doc()doc";
 
 
@@ -48,5 +56,38 @@ static const char*
 static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_make = R"doc()doc";
 
 
-static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_get_feedback =
+static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_get_feedback_0 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_feedback_decision_get_feedback_1 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_link_adaptation = R"doc()doc";
+
+
+static const char*
+    __doc_gr_dtl_ofdm_adaptive_link_adaptation_ofdm_adaptive_link_adaptation =
+        R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_link_adaptation_make = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_link_adaptation_get_feedback_0 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_link_adaptation_get_feedback_1 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_link_adaptation_report_tb = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_link_adaptation_get_bler = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_link_adaptation_get_olla_offset =
     R"doc()doc";
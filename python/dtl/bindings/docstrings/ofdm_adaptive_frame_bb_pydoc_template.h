@@ -30,3 +30,15 @@ static const char* __doc_gr_dtl_ofdm_adaptive_frame_bb_make = R"doc()doc";
 
 
 static const char* __doc_gr_dtl_ofdm_adaptive_frame_bb_set_constellation = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bb_set_feedback_channel = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bb_set_header_channel = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bb_set_frame_clock = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bb_set_padding_table = R"doc()doc";
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr, dtl, __VA_ARGS__)
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_ofdm_adaptive_frame_bc_0 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_ofdm_adaptive_frame_bc_1 =
+    R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_make = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_set_constellation = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_set_feedback_channel = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_set_header_channel = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_set_frame_clock = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_bc_set_padding_table = R"doc()doc";
@@ -24,3 +24,7 @@ static const char*
 
 
 static const char* __doc_gr_dtl_ofdm_adaptive_frame_equalizer_vcvc_make = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_frame_equalizer_vcvc_set_feedback_channel =
+    R"doc()doc";
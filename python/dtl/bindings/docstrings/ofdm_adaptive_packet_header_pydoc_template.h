@@ -34,3 +34,7 @@ static const char* __doc_gr_dtl_ofdm_adaptive_packet_header_header_formatter =
 
 
 static const char* __doc_gr_dtl_ofdm_adaptive_packet_header_header_parser = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_ofdm_adaptive_packet_header_set_header_channel =
+    R"doc()doc";
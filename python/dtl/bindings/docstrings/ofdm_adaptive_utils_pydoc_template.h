@@ -48,6 +48,9 @@ static const char* __doc_gr_dtl_estimated_snr_tag_key = R"doc()doc";
 static const char* __doc_gr_dtl_noise_tag_key = R"doc()doc";
 
 
+static const char* __doc_gr_dtl_carrier_snr_tag_key = R"doc()doc";
+
+
 static const char* __doc_gr_dtl_feedback_constellation_key = R"doc()doc";
 
 
@@ -73,3 +76,9 @@ static const char* __doc_gr_dtl_fec_tb_len_key = R"doc()doc";
 
 
 static const char* __doc_gr_dtl_fec_tb_index_key = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_frame_index_key = R"doc()doc";
+
+
+static const char* __doc_gr_dtl_tx_time_key = R"doc()doc";
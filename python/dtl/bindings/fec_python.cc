@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(fec.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(98cc92635ceba81ef38016d58fbd1b36)                     */
+/* BINDTOOL_HEADER_FILE_HASH(c8d5c88041fcb0cbdeb07da06aec1e68)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -84,8 +84,20 @@ void bind_fec(py::module& m)
           D(make_ldpc_encoders));
 
 
+    py::enum_<::gr::dtl::ldpc_decoder_type_t>(m, "ldpc_decoder_type_t")
+        .value("BP", ::gr::dtl::ldpc_decoder_type_t::BP)                     // 0
+        .value("MINSUM", ::gr::dtl::ldpc_decoder_type_t::MINSUM)             // 1
+        .value("MINSUM_INT16", ::gr::dtl::ldpc_decoder_type_t::MINSUM_INT16) // 2
+        .value("MINSUM_INT8", ::gr::dtl::ldpc_decoder_type_t::MINSUM_INT8)   // 3
+        .export_values();
+
+    py::implicitly_convertible<int, ::gr::dtl::ldpc_decoder_type_t>();
+
+
     m.def("make_ldpc_decoders",
           &::gr::dtl::make_ldpc_decoders,
           py::arg("alist_fnames"),
+          py::arg("type") = ::gr::dtl::ldpc_decoder_type_t::BP,
+          py::arg("max_it") = 15,
           D(make_ldpc_decoders));
 }
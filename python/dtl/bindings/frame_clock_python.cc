@@ -0,0 +1,88 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(frame_clock.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(07090958219f5ec4d56b728cd0dce916)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/dtl/frame_clock.h>
+// pydoc.h is automatically generated in the build directory
+#include <frame_clock_pydoc.h>
+
+void bind_frame_clock(py::module& m)
+{
+
+    using frame_clock = ::gr::dtl::frame_clock;
+
+
+    py::class_<frame_clock, std::shared_ptr<frame_clock>>(
+        m, "frame_clock", D(frame_clock))
+
+        .def(py::init(&frame_clock::make),
+             py::arg("frame_rate"),
+             py::arg("virtual_time") = true,
+             D(frame_clock, make))
+
+
+        .def("start", &frame_clock::start, D(frame_clock, start))
+
+
+        .def("wait",
+             &frame_clock::wait,
+             py::arg("max_frames"),
+             py::call_guard<py::gil_scoped_release>(),
+             D(frame_clock, wait))
+
+
+        .def("advance", &frame_clock::advance, py::arg("n"), D(frame_clock, advance))
+
+
+        .def("frame_index", &frame_clock::frame_index, D(frame_clock, frame_index))
+
+
+        .def("frame_duration",
+             &frame_clock::frame_duration,
+             D(frame_clock, frame_duration))
+
+
+        .def("virtual_time", &frame_clock::virtual_time, D(frame_clock, virtual_time))
+
+
+        .def("set_time_tags",
+             &frame_clock::set_time_tags,
+             py::arg("enable"),
+             py::arg("time_origin") = 0,
+             D(frame_clock, set_time_tags))
+
+
+        .def("time_tags", &frame_clock::time_tags, D(frame_clock, time_tags))
+
+
+        .def("frame_time",
+             &frame_clock::frame_time,
+             py::arg("index"),
+             D(frame_clock, frame_time))
+
+
+        .def("tx_time", &frame_clock::tx_time, py::arg("index"), D(frame_clock, tx_time))
+
+        ;
+}
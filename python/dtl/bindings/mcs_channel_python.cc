@@ -0,0 +1,79 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(mcs_channel.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(458d9d5fcad447f3c753c39a5fbaad36)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/dtl/mcs_channel.h>
+// pydoc.h is automatically generated in the build directory
+#include <mcs_channel_pydoc.h>
+
+void bind_mcs_channel(py::module& m)
+{
+
+    using mcs_t = ::gr::dtl::mcs_t;
+    using mcs_channel = ::gr::dtl::mcs_channel;
+
+
+    py::class_<mcs_t>(m, "mcs_t", D(mcs_t))
+
+        .def(py::init<>())
+        .def_readwrite("constellation", &mcs_t::constellation)
+        .def_readwrite("fec_idx", &mcs_t::fec_idx)
+        .def_readwrite("snr", &mcs_t::snr)
+        .def_readwrite("timestamp", &mcs_t::timestamp)
+
+        ;
+
+
+    py::class_<mcs_channel, std::shared_ptr<mcs_channel>>(
+        m, "mcs_channel", D(mcs_channel))
+
+        .def(py::init(&mcs_channel::make), D(mcs_channel, make))
+
+
+        .def("publish",
+             &mcs_channel::publish,
+             py::arg("constellation"),
+             py::arg("fec_idx"),
+             py::arg("snr") = 0,
+             D(mcs_channel, publish))
+
+
+        // Returns (mcs, seq), mcs is None if nothing was published after seq
+        .def(
+            "read",
+            [](const mcs_channel& self, uint64_t seq) {
+                mcs_t mcs;
+                if (!self.read(mcs, seq)) {
+                    return py::make_tuple(py::none(), seq);
+                }
+                return py::make_tuple(mcs, seq);
+            },
+            py::arg("seq"),
+            D(mcs_channel, read))
+
+
+        .def("version", &mcs_channel::version, D(mcs_channel, version))
+
+        ;
+}
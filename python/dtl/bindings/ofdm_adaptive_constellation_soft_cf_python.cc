@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_constellation_soft_cf.h) */
-/* BINDTOOL_HEADER_FILE_HASH(956b698056cde3df741e606a646fa3d0)                     */
+/* BINDTOOL_HEADER_FILE_HASH(50b0a8371eb22114b3d9531597fe6beb)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -43,6 +43,9 @@ void bind_ofdm_adaptive_constellation_soft_cf(py::module& m)
         .def(py::init(&ofdm_adaptive_constellation_soft_cf::make),
              py::arg("constellations"),
              py::arg("len_key"),
+             py::arg("fft_len") = 0,
+             py::arg("occupied_carriers") = std::vector<std::vector<int>>(),
+             py::arg("symbols_skipped") = 0,
              D(ofdm_adaptive_constellation_soft_cf, make))
 
 
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_equalizer.h) */
-/* BINDTOOL_HEADER_FILE_HASH(5c2f5bfd42e956c9f12e2a7f1f7c89e0)                     */
+/* BINDTOOL_HEADER_FILE_HASH(7583ea19c28ba384b5bd9287a68deb1e)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -67,11 +67,23 @@ void bind_ofdm_adaptive_equalizer(py::module& m)
              D(ofdm_adaptive_equalizer_base, get_snr))
 
 
+        .def("get_effective_snr",
+             &ofdm_adaptive_equalizer_base::get_effective_snr,
+             py::arg("constellation"),
+             D(ofdm_adaptive_equalizer_base, get_effective_snr))
+
+
         .def("get_noise",
              &ofdm_adaptive_equalizer_base::get_noise,
              D(ofdm_adaptive_equalizer_base, get_noise))
 
 
+        .def("get_carrier_snr",
+             &ofdm_adaptive_equalizer_base::get_carrier_snr,
+             py::arg("snr"),
+             D(ofdm_adaptive_equalizer_base, get_carrier_snr))
+
+
         .def("equalize",
              (void(ofdm_adaptive_equalizer_base::*)(
                  gr_complex*,
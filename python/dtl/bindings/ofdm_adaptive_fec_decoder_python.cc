@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_fec_decoder.h) */
-/* BINDTOOL_HEADER_FILE_HASH(cebba9ce537949bf2ce2848fc1ffe863)                     */
+/* BINDTOOL_HEADER_FILE_HASH(629807096f0946b3818cfe7a4c3f9586)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -44,8 +44,17 @@ void bind_ofdm_adaptive_fec_decoder(py::module& m)
              py::arg("frame_capacity"),
              py::arg("max_bps"),
              py::arg("len_key"),
+             py::arg("nthreads") = 0,
+             py::arg("max_tb_in_flight") = DEFAULT_MAX_TB_IN_FLIGHT,
+             py::arg("incremental") = false,
              D(ofdm_adaptive_fec_decoder, make))
 
 
+        .def("set_link_adaptation",
+             &ofdm_adaptive_fec_decoder::set_link_adaptation,
+             py::arg("link_adaptation"),
+             D(ofdm_adaptive_fec_decoder, set_link_adaptation))
+
+
         ;
 }
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_fec_frame_bvb.h) */
-/* BINDTOOL_HEADER_FILE_HASH(02015b4165d9de8b0efb577b1897bd2f)                     */
+/* BINDTOOL_HEADER_FILE_HASH(4d0f14b6c96e33885350133959cf63f8)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -54,5 +54,29 @@ void bind_ofdm_adaptive_fec_frame_bvb(py::module& m)
              py::arg("feedback"),
              D(ofdm_adaptive_fec_frame_bvb, process_feedback))
 
+
+        .def("set_feedback_channel",
+             &ofdm_adaptive_fec_frame_bvb::set_feedback_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_fec_frame_bvb, set_feedback_channel))
+
+
+        .def("set_header_channel",
+             &ofdm_adaptive_fec_frame_bvb::set_header_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_fec_frame_bvb, set_header_channel))
+
+
+        .def("set_frame_clock",
+             &ofdm_adaptive_fec_frame_bvb::set_frame_clock,
+             py::arg("clock"),
+             D(ofdm_adaptive_fec_frame_bvb, set_frame_clock))
+
+
+        .def("set_burst_frames",
+             &ofdm_adaptive_fec_frame_bvb::set_burst_frames,
+             py::arg("nframes"),
+             D(ofdm_adaptive_fec_frame_bvb, set_burst_frames))
+
         ;
 }
@@ -14,10 +14,11 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_feedback_decision.h) */
-/* BINDTOOL_HEADER_FILE_HASH(286b3219885658a9f337caba1a3df48f)                     */
+/* BINDTOOL_HEADER_FILE_HASH(8e2e8f6d78fc35496c694d3c3bfeea9d)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
+#include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -33,6 +34,7 @@ void bind_ofdm_adaptive_feedback_decision(py::module& m)
     using ofdm_adaptive_feedback_decision_base =
         ::gr::dtl::ofdm_adaptive_feedback_decision_base;
     using ofdm_adaptive_feedback_decision = ::gr::dtl::ofdm_adaptive_feedback_decision;
+    using ofdm_adaptive_link_adaptation = ::gr::dtl::ofdm_adaptive_link_adaptation;
 
 
     py::class_<
@@ -55,9 +57,26 @@ void bind_ofdm_adaptive_feedback_decision(py::module& m)
 
 
         .def("get_feedback",
-             &ofdm_adaptive_feedback_decision_base::get_feedback,
+             (gr::dtl::ofdm_adaptive_feedback_t(ofdm_adaptive_feedback_decision_base::*)(double)) &
+                 ofdm_adaptive_feedback_decision_base::get_feedback,
              py::arg("estimated_snr"),
-             D(ofdm_adaptive_feedback_decision_base, get_feedback))
+             D(ofdm_adaptive_feedback_decision_base, get_feedback, 0))
+
+
+        .def("get_feedback",
+             (gr::dtl::ofdm_adaptive_feedback_t(ofdm_adaptive_feedback_decision_base::*)(
+                 const gr::dtl::effective_snr_t&)) &
+                 ofdm_adaptive_feedback_decision_base::get_feedback,
+             py::arg("effective_snr"),
+             D(ofdm_adaptive_feedback_decision_base, get_feedback, 1))
+
+
+        .def("report_tb",
+             &ofdm_adaptive_feedback_decision_base::report_tb,
+             py::arg("mcs"),
+             py::arg("snr"),
+             py::arg("crc_ok"),
+             D(ofdm_adaptive_feedback_decision_base, report_tb))
 
         ;
 
@@ -76,9 +95,69 @@ void bind_ofdm_adaptive_feedback_decision(py::module& m)
 
 
         .def("get_feedback",
-             &ofdm_adaptive_feedback_decision::get_feedback,
+             (gr::dtl::ofdm_adaptive_feedback_t(ofdm_adaptive_feedback_decision::*)(double)) &
+                 ofdm_adaptive_feedback_decision::get_feedback,
              py::arg("estimated_snr"),
-             D(ofdm_adaptive_feedback_decision, get_feedback))
+             D(ofdm_adaptive_feedback_decision, get_feedback, 0))
+
+
+        .def("get_feedback",
+             (gr::dtl::ofdm_adaptive_feedback_t(ofdm_adaptive_feedback_decision::*)(
+                 const gr::dtl::effective_snr_t&)) &
+                 ofdm_adaptive_feedback_decision::get_feedback,
+             py::arg("effective_snr"),
+             D(ofdm_adaptive_feedback_decision, get_feedback, 1))
+
+        ;
+
+
+    py::class_<ofdm_adaptive_link_adaptation,
+               gr::dtl::ofdm_adaptive_feedback_decision_base,
+               std::shared_ptr<ofdm_adaptive_link_adaptation>>(
+        m, "ofdm_adaptive_link_adaptation", D(ofdm_adaptive_link_adaptation))
+
+        .def(py::init(&ofdm_adaptive_link_adaptation::make),
+             py::arg("lut"),
+             py::arg("efficiency") = std::vector<double>(),
+             py::arg("target_bler") = 0.1,
+             py::arg("olla_step") = 0.5,
+             py::arg("initial_mcs") = 0,
+             D(ofdm_adaptive_link_adaptation, make))
+
+
+        .def("get_feedback",
+             (gr::dtl::ofdm_adaptive_feedback_t(ofdm_adaptive_link_adaptation::*)(double)) &
+                 ofdm_adaptive_link_adaptation::get_feedback,
+             py::arg("estimated_snr"),
+             D(ofdm_adaptive_link_adaptation, get_feedback, 0))
+
+
+        .def("get_feedback",
+             (gr::dtl::ofdm_adaptive_feedback_t(ofdm_adaptive_link_adaptation::*)(
+                 const gr::dtl::effective_snr_t&)) &
+                 ofdm_adaptive_link_adaptation::get_feedback,
+             py::arg("effective_snr"),
+             D(ofdm_adaptive_link_adaptation, get_feedback, 1))
+
+
+        .def("report_tb",
+             &ofdm_adaptive_link_adaptation::report_tb,
+             py::arg("mcs"),
+             py::arg("snr"),
+             py::arg("crc_ok"),
+             D(ofdm_adaptive_link_adaptation, report_tb))
+
+
+        .def("get_bler",
+             &ofdm_adaptive_link_adaptation::get_bler,
+             py::arg("mcs_id"),
+             py::arg("snr"),
+             D(ofdm_adaptive_link_adaptation, get_bler))
+
+
+        .def("get_olla_offset",
+             &ofdm_adaptive_link_adaptation::get_olla_offset,
+             D(ofdm_adaptive_link_adaptation, get_olla_offset))
 
         ;
 }
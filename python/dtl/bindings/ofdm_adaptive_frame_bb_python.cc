@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_frame_bb.h) */
-/* BINDTOOL_HEADER_FILE_HASH(35940feb5b49084fd389f12469c919ed)                     */
+/* BINDTOOL_HEADER_FILE_HASH(ff6608facb590711af8c58e4f42b62bf)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -55,5 +55,29 @@ void bind_ofdm_adaptive_frame_bb(py::module& m)
              py::arg("constellation"),
              D(ofdm_adaptive_frame_bb, set_constellation))
 
+
+        .def("set_feedback_channel",
+             &ofdm_adaptive_frame_bb::set_feedback_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_frame_bb, set_feedback_channel))
+
+
+        .def("set_header_channel",
+             &ofdm_adaptive_frame_bb::set_header_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_frame_bb, set_header_channel))
+
+
+        .def("set_frame_clock",
+             &ofdm_adaptive_frame_bb::set_frame_clock,
+             py::arg("clock"),
+             D(ofdm_adaptive_frame_bb, set_frame_clock))
+
+
+        .def("set_padding_table",
+             &ofdm_adaptive_frame_bb::set_padding_table,
+             py::arg("table"),
+             D(ofdm_adaptive_frame_bb, set_padding_table))
+
         ;
 }
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2023 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(ofdm_adaptive_frame_bc.h) */
+/* BINDTOOL_HEADER_FILE_HASH(63075cdd9aefbdd3d6dee44b50806e33)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/dtl/ofdm_adaptive_frame_bc.h>
+// pydoc.h is automatically generated in the build directory
+#include <ofdm_adaptive_frame_bc_pydoc.h>
+
+void bind_ofdm_adaptive_frame_bc(py::module& m)
+{
+
+    using ofdm_adaptive_frame_bc = ::gr::dtl::ofdm_adaptive_frame_bc;
+
+
+    py::class_<ofdm_adaptive_frame_bc,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<ofdm_adaptive_frame_bc>>(
+        m, "ofdm_adaptive_frame_bc", D(ofdm_adaptive_frame_bc))
+
+        .def(py::init(&ofdm_adaptive_frame_bc::make),
+             py::arg("len_tag_key"),
+             py::arg("constellations"),
+             py::arg("frame_len"),
+             py::arg("frame_rate"),
+             py::arg("n_payload_carriers"),
+             py::arg("frames_fname") = "",
+             py::arg("max_empty_frames") = -1,
+             D(ofdm_adaptive_frame_bc, make))
+
+
+        .def("set_constellation",
+             &ofdm_adaptive_frame_bc::set_constellation,
+             py::arg("constellation"),
+             D(ofdm_adaptive_frame_bc, set_constellation))
+
+
+        .def("set_feedback_channel",
+             &ofdm_adaptive_frame_bc::set_feedback_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_frame_bc, set_feedback_channel))
+
+
+        .def("set_header_channel",
+             &ofdm_adaptive_frame_bc::set_header_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_frame_bc, set_header_channel))
+
+
+        .def("set_frame_clock",
+             &ofdm_adaptive_frame_bc::set_frame_clock,
+             py::arg("clock"),
+             D(ofdm_adaptive_frame_bc, set_frame_clock))
+
+
+        .def("set_padding_table",
+             &ofdm_adaptive_frame_bc::set_padding_table,
+             py::arg("table"),
+             D(ofdm_adaptive_frame_bc, set_padding_table))
+
+        ;
+}
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_frame_equalizer_vcvc.h) */
-/* BINDTOOL_HEADER_FILE_HASH(5ccbecd7abfb311913ab841998faa3f5)                     */
+/* BINDTOOL_HEADER_FILE_HASH(63b5c9dbc8a3e9884a4f23f726f2c64e)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -52,5 +52,11 @@ void bind_ofdm_adaptive_frame_equalizer_vcvc(py::module& m)
              D(ofdm_adaptive_frame_equalizer_vcvc, make))
 
 
+        .def("set_feedback_channel",
+             &ofdm_adaptive_frame_equalizer_vcvc::set_feedback_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_frame_equalizer_vcvc, set_feedback_channel))
+
+
         ;
 }
@@ -14,7 +14,6 @@
 
 namespace py = pybind11;
 
-#include <gnuradio/digital/mpsk_snr_est.h>
 #include <gnuradio/dtl/ofdm_adaptive_frame_snr.h>
 // pydoc.h is automatically generated in the build directory
 #include <ofdm_adaptive_frame_snr_pydoc.h>
@@ -34,7 +33,12 @@ void bind_ofdm_adaptive_frame_snr_template(py::module& m, const char* classname)
           .def(py::init<double>(),
                py::arg("alpha"))
         .def("update",
-             &frame_snr::update,
+             [](frame_snr& self,
+                int noutput_items,
+                const std::vector<gr_complex>& input) {
+                 noutput_items = std::min<int>(noutput_items, input.size());
+                 return self.update(noutput_items, input.data());
+             },
              py::arg("noutput_items"),
              py::arg("input"))
         .def("reset",
@@ -80,8 +84,46 @@ void bind_ofdm_adaptive_frame_snr(py::module& m)
         .def("noise",
              &ofdm_adaptive_frame_snr_base::snr)
 
+        .def("effective_snr",
+             &ofdm_adaptive_frame_snr_base::effective_snr,
+             py::arg("constellation"))
+
         ;
 
-     bind_ofdm_adaptive_frame_snr_template<gr::digital::mpsk_snr_est_simple>(m, "ofdm_adaptive_frame_snr_simple");
+     bind_ofdm_adaptive_frame_snr_template<gr::dtl::snr_est_simple>(m, "ofdm_adaptive_frame_snr_simple");
+     bind_ofdm_adaptive_frame_snr_template<gr::dtl::snr_est_m2m4>(m, "ofdm_adaptive_frame_snr_m2m4");
+     bind_ofdm_adaptive_frame_snr_template<gr::dtl::snr_est_svr>(m, "ofdm_adaptive_frame_snr_svr");
+
+    using ofdm_adaptive_frame_snr_eesm = ::gr::dtl::ofdm_adaptive_frame_snr_eesm;
+
+    py::class_<ofdm_adaptive_frame_snr_eesm,
+               ofdm_adaptive_frame_snr_base,
+               std::shared_ptr<ofdm_adaptive_frame_snr_eesm>>(
+        m, "ofdm_adaptive_frame_snr_eesm")
+
+        .def(py::init(&ofdm_adaptive_frame_snr_eesm::make),
+             py::arg("beta") = std::map<gr::dtl::constellation_type_t, double>())
+
+        .def("update_carriers",
+             [](ofdm_adaptive_frame_snr_eesm& self,
+                const std::vector<float>& gain,
+                const std::vector<float>& eq_re,
+                const std::vector<float>& eq_im,
+                const std::vector<float>& est_re,
+                const std::vector<float>& est_im) {
+                 self.update_carriers(gain.size(),
+                                      gain.data(),
+                                      eq_re.data(),
+                                      eq_im.data(),
+                                      est_re.data(),
+                                      est_im.data());
+             },
+             py::arg("gain"),
+             py::arg("eq_re"),
+             py::arg("eq_im"),
+             py::arg("est_re"),
+             py::arg("est_im"))
+
+        ;
 
 }
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_packet_header.h) */
-/* BINDTOOL_HEADER_FILE_HASH(90009265d05d6faec0540c3ab3978a08)                     */
+/* BINDTOOL_HEADER_FILE_HASH(564e26fa69d4a10735264b3f8c323e61)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -65,5 +65,11 @@ void bind_ofdm_adaptive_packet_header(py::module& m)
              py::arg("tags"),
              D(ofdm_adaptive_packet_header, header_parser))
 
+
+        .def("set_header_channel",
+             &ofdm_adaptive_packet_header::set_header_channel,
+             py::arg("channel"),
+             D(ofdm_adaptive_packet_header, set_header_channel))
+
         ;
 }
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ofdm_adaptive_utils.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(92ecda33719f9757d90244f05db9215a)                     */
+/* BINDTOOL_HEADER_FILE_HASH(c9a3c9b4e8bf9d25e1025c9214e04530)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -97,6 +97,9 @@ void bind_ofdm_adaptive_utils(py::module& m)
     m.def("noise_tag_key", &::gr::dtl::noise_tag_key, D(noise_tag_key));
 
 
+    m.def("carrier_snr_tag_key", &::gr::dtl::carrier_snr_tag_key, D(carrier_snr_tag_key));
+
+
     m.def("feedback_constellation_key",
           &::gr::dtl::feedback_constellation_key,
           D(feedback_constellation_key));
@@ -124,4 +127,10 @@ void bind_ofdm_adaptive_utils(py::module& m)
 
 
     m.def("fec_tb_index_key", &::gr::dtl::fec_tb_index_key, D(fec_tb_index_key));
+
+
+    m.def("frame_index_key", &::gr::dtl::frame_index_key, D(frame_index_key));
+
+
+    m.def("tx_time_key", &::gr::dtl::tx_time_key, D(tx_time_key));
 }
@@ -25,6 +25,8 @@ namespace py = pybind11;
     void bind_ofdm_adaptive_frame_equalizer_vcvc(py::module& m);
     void bind_ofdm_adaptive_packet_header(py::module& m);
     void bind_ofdm_adaptive_utils(py::module& m);
+    void bind_mcs_channel(py::module& m);
+    void bind_frame_clock(py::module& m);
     void bind_ofdm_adaptive_frame_pack_bb(py::module& m);
     void bind_ofdm_adaptive_chunks_to_symbols_bc(py::module& m);
     void bind_ofdm_adaptive_constellation_decoder_cb(py::module& m);
@@ -32,6 +34,7 @@ namespace py = pybind11;
     void bind_ofdm_adaptive_feedback_decision(py::module& m);
     void bind_ofdm_adaptive_feedback_format(py::module& m);
     void bind_ofdm_adaptive_frame_bb(py::module& m);
+    void bind_ofdm_adaptive_frame_bc(py::module& m);
     void bind_ofdm_adaptive_frame_detect_bb(py::module& m);
     void bind_ofdm_adaptive_constellation_metric_vcvf(py::module& m);
     void bind_ofdm_adaptive_fec_frame_bvb(py::module& m);
@@ -39,7 +42,6 @@ namespace py = pybind11;
     void bind_fec(py::module& m);
     void bind_ofdm_adaptive_frame_to_stream_vbb(py::module& m);
     void bind_ofdm_adaptive_constellation_soft_cf(py::module& m);
-    void bind_ofdm_adaptive_fec_pack_bb(py::module& m);
 // ) END BINDING_FUNCTION_PROTOTYPES
 
 
@@ -72,6 +74,8 @@ PYBIND11_MODULE(dtl_python, m)
     bind_ofdm_adaptive_frame_equalizer_vcvc(m);
     bind_ofdm_adaptive_packet_header(m);
     bind_ofdm_adaptive_utils(m);
+    bind_mcs_channel(m);
+    bind_frame_clock(m);
     bind_ofdm_adaptive_frame_pack_bb(m);
     bind_ofdm_adaptive_chunks_to_symbols_bc(m);
     bind_ofdm_adaptive_constellation_decoder_cb(m);
@@ -79,6 +83,7 @@ PYBIND11_MODULE(dtl_python, m)
     bind_ofdm_adaptive_feedback_decision(m);
     bind_ofdm_adaptive_feedback_format(m);
     bind_ofdm_adaptive_frame_bb(m);
+    bind_ofdm_adaptive_frame_bc(m);
     bind_ofdm_adaptive_frame_detect_bb(m);
     bind_ofdm_adaptive_constellation_metric_vcvf(m);
     bind_ofdm_adaptive_fec_frame_bvb(m);
@@ -86,6 +91,5 @@ PYBIND11_MODULE(dtl_python, m)
     bind_fec(m);
     bind_ofdm_adaptive_frame_to_stream_vbb(m);
     bind_ofdm_adaptive_constellation_soft_cf(m);
-    bind_ofdm_adaptive_fec_pack_bb(m);
     // ) END BINDING_FUNCTION_CALLS
 }
\ No newline at end of file
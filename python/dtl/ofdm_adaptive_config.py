@@ -43,12 +43,23 @@ class ofdm_adaptive_config:
     mcs: t.Tuple[t.Tuple[float, t.Tuple[dtl.constellation_type_t, str]]] = ((sys.float_info.min, (dtl.constellation_type_t.BPSK, "no_fec")), (
         13, (dtl.constellation_type_t.QPSK, "no_fec")), (18, (dtl.constellation_type_t.PSK8, "no_fec")), (23, (dtl.constellation_type_t.QAM16, "no_fec")),)
     initial_mcs_id: int = 0
+    # Learn BLER curves from the TB CRC outcomes instead of the SNR thresholds with hysteresis
+    link_adaptation: bool = False
+    # Decide the MCS on the EESM effective SNR of each constellation instead of the mean SNR
+    effective_snr: bool = False
 
 
 @dc.dataclass
 class ofdm_adaptive_tx_config(ofdm_adaptive_config):
     max_empty_frames: int = -1
     sample_rate: int = 700000
+    # Without FEC, frame and map the payload to symbols in one block
+    fused_payload_mod: bool = False
+    # Pace the samples in real time with a throttle, for sinks without a sample
+    # clock. The frames are otherwise paced by the sink.
+    throttle: bool = False
+    # With FEC, frames encoded ahead of their slots
+    burst_frames: int = 0
 
 
 @dc.dataclass
@@ -63,6 +74,9 @@ class ofdm_adaptive_full_duplex_config(ofdm_adaptive_config):
     use_sync_correct: bool = True
     max_empty_frames: int = -1
     sample_rate: int = 700000
+    fused_payload_mod: bool = False
+    throttle: bool = False
+    burst_frames: int = 0
 
 
 def _make_config(cfg, json_dict, parser):
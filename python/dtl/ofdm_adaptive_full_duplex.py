@@ -37,8 +37,10 @@ class ofdm_adaptive_full_duplex(gr.hier_block2):
         self.connect((self.rx, 1), blocks.null_sink(gr.sizeof_char))
         self.connect((self.rx, 3), blocks.null_sink(gr.sizeof_gr_complex * config.fft_len))
 
-        self.msg_connect(self.rx, "header", self.tx, "header")
-        self.msg_connect(self.rx, "feedback", self.tx, "feedback")
+        self.feedback_channel = dtl.mcs_channel()
+        self.header_channel = dtl.mcs_channel()
+        self.rx.set_mcs_channels(self.feedback_channel, self.header_channel)
+        self.tx.set_mcs_channels(self.feedback_channel, self.header_channel)
 
         self.msg_connect(self.rx, "monitor", self, "monitor")
 
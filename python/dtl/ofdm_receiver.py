@@ -19,6 +19,7 @@ class ofdm_receiver(gr.hier_block2):
 
         self.message_port_register_hier_out("monitor")
         self.message_port_register_hier_out("feedback")
+        self.message_port_register_hier_out("feedback_pdu")
         self.message_port_register_hier_out("header")
 
         self.name = name
@@ -47,6 +48,8 @@ class ofdm_receiver(gr.hier_block2):
             self.codes_id = { name: id+1 for (id, name) in enumerate(list(zip(*config.fec_codes))[0]) }
         self.mcs = [(snr_th, (cnst, self.codes_id.get(code_name, 0))) for (snr_th, (cnst, code_name)) in config.mcs]
         self.initial_mcs_id = config.initial_mcs_id
+        self.link_adaptation = config.link_adaptation
+        self.effective_snr = config.effective_snr
 
         if [self.fft_len, self.fft_len] != [len(config.sync_word1), len(config.sync_word2)]:
             raise ValueError(
@@ -126,7 +129,7 @@ class ofdm_receiver(gr.hier_block2):
         header_demod = digital.constellation_decoder_cb(
             header_constellation.base())
 
-        header_formatter = dtl.ofdm_adaptive_packet_header(
+        self.header_formatter = header_formatter = dtl.ofdm_adaptive_packet_header(
             [self.occupied_carriers[0] for _ in range(header_len)], header_len, self.frame_length,
             self.packet_length_tag_key,
             self.frame_length_tag_key,
@@ -152,19 +155,32 @@ class ofdm_receiver(gr.hier_block2):
         # Payload path
         payload_fft = fft.fft_vcc(self.fft_len, True, (), True)
 
+        if self.effective_snr:
+            payload_snr = dtl.ofdm_adaptive_frame_snr_eesm()
+        else:
+            payload_snr = dtl.ofdm_adaptive_frame_snr_simple(0.1)
         payload_equalizer = dtl.ofdm_adaptive_payload_equalizer(
             self.fft_len,
             self.constellations,
-            dtl.ofdm_adaptive_frame_snr_simple(0.1),
+            payload_snr,
             self.occupied_carriers,
             self.pilot_carriers,
             self.pilot_symbols,
             symbols_skipped=header_len,  # already in the header
             alpha=0.1,
         )
+        # Built once, for the code rates of the link adaptation and the decoder
+        ldpc_decs = dtl.make_ldpc_decoders(self.codes_alist) if self.fec else None
+        if self.link_adaptation:
+            self.feedback_decision = dtl.ofdm_adaptive_link_adaptation(
+                self.mcs, self._mcs_efficiency(ldpc_decs),
+                initial_mcs=self.initial_mcs_id)
+        else:
+            self.feedback_decision = dtl.ofdm_adaptive_feedback_decision(
+                1, 5, self.mcs, self.initial_mcs_id)
         self.payload_eq = dtl.ofdm_adaptive_frame_equalizer_vcvc(
             payload_equalizer.base(),
-            dtl.ofdm_adaptive_feedback_decision(1, 5, self.mcs, self.initial_mcs_id),
+            self.feedback_decision,
             self.cp_len,
             self.frame_length_tag_key,
             self.frame_no_tag_key,
@@ -190,22 +206,26 @@ class ofdm_receiver(gr.hier_block2):
         )
 
         if self.fec:
-            ldpc_decs = dtl.make_ldpc_decoders(self.codes_alist)
-
-            payload_demod = dtl.ofdm_adaptive_constellation_soft_cf(self.constellations, self.packet_length_tag_key)
+            payload_demod = dtl.ofdm_adaptive_constellation_soft_cf(
+                self.constellations,
+                self.packet_length_tag_key,
+                self.fft_len,
+                self.occupied_carriers,
+                1  # Same carrier allocation as payload_serializer
+            )
             fec_dec = dtl.ofdm_adaptive_fec_decoder(
                 ldpc_decs,
                 dtl.ofdm_adaptive.frame_capacity(self.frame_length, self.occupied_carriers),
                 dtl.ofdm_adaptive.max_bps(self.constellations),
                 self.packet_length_tag_key
             )
-            fec_pack =dtl.ofdm_adaptive_fec_pack_bb(self.packet_length_tag_key)
+            if self.link_adaptation:
+                fec_dec.set_link_adaptation(self.feedback_decision)
             self.connect(payload_demod, blocks.tag_debug(gr.sizeof_float, "payload_demod"))
             self.connect(
                 payload_serializer,
                 payload_demod,
                 fec_dec,
-                fec_pack,
                 # self.payload_descrambler,
                 (self, 0)
             )
@@ -243,6 +263,19 @@ class ofdm_receiver(gr.hier_block2):
         self.connect((self.sync_detect, 0), (self, 5))
         self.msg_connect(self.payload_eq, "monitor", self, "monitor")
         self.msg_connect(self.payload_eq, "feedback_port", self, "feedback")
+        self.msg_connect(self.payload_eq, "feedback_pdu", self, "feedback_pdu")
         self.msg_connect(header_parser, "header_data", self, "header")
 
+    def _mcs_efficiency(self, ldpc_decs):
+        """Information bits per symbol of each MCS, uncoded without ldpc_decs."""
+        if not ldpc_decs:
+            return [dtl.get_bits_per_symbol(cnst) for (_, (cnst, _)) in self.mcs]
+        rates = [1] + [dec.get_k() / dec.get_n() for dec in ldpc_decs[1:]]
+        return [dtl.get_bits_per_symbol(cnst) * rates[fec_idx]
+                for (_, (cnst, fec_idx)) in self.mcs]
 
+    def set_mcs_channels(self, feedback, header):
+        """Publishes the feedback decision and the parsed headers to mcs_channels,
+        to be read by a transmitter in the same process."""
+        self.payload_eq.set_feedback_channel(feedback)
+        self.header_formatter.set_header_channel(header)
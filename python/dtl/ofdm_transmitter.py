@@ -52,6 +52,9 @@ class ofdm_transmitter(gr.hier_block2):
         else:
             self.scramble_seed = 0x00  # We deactivate the scrambler by init'ing it with zeros
         self.max_empty_frames = config.max_empty_frames
+        self.fused_payload_mod = config.fused_payload_mod
+        self.throttle = config.throttle
+        self.burst_frames = config.burst_frames
 
         self.message_port_register_hier_out("monitor")
         self.message_port_register_hier_in("feedback")
@@ -73,6 +76,9 @@ class ofdm_transmitter(gr.hier_block2):
         frame_capacity = dtl.ofdm_adaptive.frame_capacity(
                 self.frame_length, self.occupied_carriers)
         frame_rate = self.sample_rate / ((self.frame_length + header_len + len(self.sync_words)) * (self.fft_len + self.cp_len))
+        # Timing of the frames, tx_time tags can be enabled on it. The frames are
+        # paced by the sink, or by the throttle.
+        self.frame_clock = dtl.frame_clock(frame_rate, True)
         header = dtl.ofdm_adaptive_packet_header(
             [self.occupied_carriers[0]
                 for _ in range(header_len)], header_len, self.frame_length,
@@ -141,6 +147,23 @@ class ofdm_transmitter(gr.hier_block2):
                 header_mod,
                 (header_payload_mux, 0)
             )
+        elif self.fused_payload_mod:
+            # Frames, CRC, padding and symbol mapping in one block, its second output
+            # only carries the frame tags to the header generator
+            repack = blocks.repack_bits_bb(8, 8)
+            self.frame_unpack = dtl.ofdm_adaptive_frame_bc(
+                self.packet_length_tag_key,
+                self.constellations, self.frame_length, frame_rate,
+                len(self.occupied_carriers[0]), self.frame_store_fname, self.max_empty_frames)
+            self.set_feedback(self.initial_mcs[0])
+            self.connect(
+                (self.frame_unpack, 1),
+                header_gen,
+                header_mod,
+                (header_payload_mux, 0)
+            )
+            self.connect((self, 0), repack, self.frame_unpack)
+            self.connect((self.frame_unpack, 0), (header_payload_mux, 1))
         else:
             # HACK: Adding a repack just before frame builder improves scheduler performance (not sure why)
             repack = blocks.repack_bits_bb(8, 8)
@@ -185,16 +208,24 @@ class ofdm_transmitter(gr.hier_block2):
             self.rolloff,
             self.packet_length_tag_key
         )
-        self.connect(header_payload_mux, allocator,
-                     ffter, cyclic_prefixer, self)
+        self.connect(header_payload_mux, allocator, ffter, cyclic_prefixer)
+        if self.throttle:
+            # Single real time pacing stage, the frames fill the sample stream
+            throttle = blocks.throttle(gr.sizeof_gr_complex, self.sample_rate)
+            self.connect(cyclic_prefixer, throttle, self)
+        else:
+            self.connect(cyclic_prefixer, self)
 
         if self.fec:
+            self.fec_frame.set_frame_clock(self.frame_clock)
+            self.fec_frame.set_burst_frames(self.burst_frames)
             self.msg_connect(self, "feedback",
                              self.fec_frame, "feedback")
             self.msg_connect(self, "header",
                              self.fec_frame, "header")
             self.msg_connect(self.fec_frame, "monitor", self, "monitor")
         else:
+            self.frame_unpack.set_frame_clock(self.frame_clock)
             self.msg_connect(self, "feedback",
                              self.frame_unpack, "feedback")
             self.msg_connect(self, "header",
@@ -212,3 +243,12 @@ class ofdm_transmitter(gr.hier_block2):
             feedback = pmt.dict_add(feedback, dtl.feedback_constellation_key(), pmt.from_long(int(constellation)))
             self.fec_frame.process_feedback(feedback)
 
+    def set_mcs_channels(self, feedback, header):
+        """Reads the feedback and header MCS from mcs_channels instead of the
+        message ports."""
+        if self.fec:
+            self.fec_frame.set_feedback_channel(feedback)
+            self.fec_frame.set_header_channel(header)
+        else:
+            self.frame_unpack.set_feedback_channel(feedback)
+            self.frame_unpack.set_header_channel(header)
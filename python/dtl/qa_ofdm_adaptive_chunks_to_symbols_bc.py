@@ -62,5 +62,30 @@ class qa_ofdm_adaptive_chunks_to_symbols_bc(gr_unittest.TestCase):
         actual_result = dst.data()
         self.assertEqual(src_data, actual_result)
 
+    def test_bc_002_all_constellations(self):
+        # Lengths not multiple of the 8 symbols of the vector kernels
+        for (cnst, bps) in ((constellation_type_t.BPSK, 1), (constellation_type_t.QPSK, 2),
+                            (constellation_type_t.PSK8, 3), (constellation_type_t.QAM16, 4)):
+            src_data = [(7 * i + i // 3) % (1 << bps) for i in range(37)]
+
+            cnst_tag = gr.tag_t()
+            cnst_tag.offset = 0
+            cnst_tag.key = get_constellation_tag_key()
+            cnst_tag.value = pmt.from_long(cnst)
+            len_tag = gr.tag_t()
+            len_tag.offset = 0
+            len_tag.key = pmt.string_to_symbol("len_tag")
+            len_tag.value = pmt.from_long(len(src_data))
+
+            tb = gr.top_block()
+            src = blocks.vector_source_b(src_data, False, 1, [cnst_tag, len_tag])
+            mod = ofdm_adaptive_chunks_to_symbols_bc([cnst], "len_tag")
+            demod = ofdm_adaptive_constellation_decoder_cb([cnst], "len_tag")
+            dst = blocks.vector_sink_b()
+            tb.connect(src, mod, demod, dst)
+            tb.run()
+
+            self.assertEqual(src_data, dst.data())
+
 if __name__ == '__main__':
     gr_unittest.run(qa_ofdm_adaptive_chunks_to_symbols_bc)
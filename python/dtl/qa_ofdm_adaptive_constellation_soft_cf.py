@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2023 DTL.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+import random
+
+try:
+    from gnuradio.dtl import (
+        carrier_snr_tag_key,
+        constellation_type_t,
+        get_constellation,
+        get_constellation_tag_key,
+        noise_tag_key,
+        ofdm_adaptive_constellation_soft_cf,
+    )
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio.dtl import (
+        carrier_snr_tag_key,
+        constellation_type_t,
+        get_constellation,
+        get_constellation_tag_key,
+        noise_tag_key,
+        ofdm_adaptive_constellation_soft_cf,
+    )
+
+class qa_ofdm_adaptive_constellation_soft_cf(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        self.fft_len = 8
+        # FFT bins of the occupied carriers, in the order of the symbols
+        self.occupied_carriers = ((-3, -2, 2, 3),)
+        self.carriers = [1, 2, 6, 7]
+        self.noise = 0.5
+        self.constellations = [constellation_type_t.QPSK, constellation_type_t.QAM16]
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_tags(self, cnst, nsyms, carrier_snr):
+        values = [(get_constellation_tag_key(), pmt.from_long(int(cnst))),
+                  (pmt.intern("len_key"), pmt.from_long(nsyms)),
+                  (noise_tag_key(), pmt.from_double(self.noise))]
+        if carrier_snr is not None:
+            values.append((carrier_snr_tag_key(), pmt.init_f32vector(len(carrier_snr),
+                                                                      carrier_snr)))
+        tags = []
+        for (key, value) in values:
+            tag = gr.tag_t()
+            tag.offset = 0
+            tag.key = key
+            tag.value = value
+            tags.append(tag)
+        return tags
+
+    def demap(self, cnst, syms, carrier_snr):
+        # LLRs scaled by the carrier SNRs and by the noise of the frame
+        src = blocks.vector_source_c(syms, False, 1, self.make_tags(cnst, len(syms),
+                                                                   carrier_snr))
+        per_carrier = ofdm_adaptive_constellation_soft_cf(
+            self.constellations, "len_key", self.fft_len, self.occupied_carriers, 0)
+        scalar = ofdm_adaptive_constellation_soft_cf(self.constellations, "len_key")
+        dst_carrier = blocks.vector_sink_f()
+        dst_scalar = blocks.vector_sink_f()
+        self.tb.connect(src, per_carrier, dst_carrier)
+        self.tb.connect(src, scalar, dst_scalar)
+        self.tb.run()
+        return (dst_carrier.data(), dst_scalar.data())
+
+    def test_001_carrier_snr_scaling(self):
+        carrier_snr = [0, 4.0, 1.0, 0, 0, 0, 0.25, 9.0]
+        for cnst in self.constellations:
+            points = get_constellation(cnst).points()
+            bps = get_constellation(cnst).bits_per_symbol()
+            syms = [random.choice(points) + complex(random.gauss(0, 0.3),
+                                                    random.gauss(0, 0.3))
+                    for _ in range(4 * 5 + 2)]
+            self.tb = gr.top_block()
+            (llr_carrier, llr_scalar) = self.demap(cnst, syms, carrier_snr)
+            self.assertEqual(len(syms) * bps, len(llr_carrier))
+            expected = [llr * self.noise * carrier_snr[self.carriers[(i // bps) % 4]]
+                        for (i, llr) in enumerate(llr_scalar)]
+            self.assertFloatTuplesAlmostEqual(expected, llr_carrier, 4)
+
+    def test_002_no_carrier_snr_tag(self):
+        # Scaled by the noise of the frame without the tag of the equalizer
+        points = get_constellation(constellation_type_t.QPSK).points()
+        syms = [random.choice(points) + complex(random.gauss(0, 0.3),
+                                                random.gauss(0, 0.3))
+                for _ in range(12)]
+        (llr_carrier, llr_scalar) = self.demap(constellation_type_t.QPSK, syms, None)
+        self.assertEqual(24, len(llr_scalar))
+        self.assertFloatTuplesAlmostEqual(llr_scalar, llr_carrier, 6)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ofdm_adaptive_constellation_soft_cf)
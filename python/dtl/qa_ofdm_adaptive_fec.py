@@ -14,20 +14,29 @@ from gnuradio import (
 import os
 import pmt
 import random
+import time
 # from gnuradio import blocks
 try:
   from gnuradio.dtl import (
     constellation_type_t,
     fec_feedback_key,
+    fec_key,
     feedback_constellation_key,
+    frame_clock,
+    frame_index_key,
     get_bits_per_symbol,
+    get_constellation_tag_key,
+    mcs_channel,
     ofdm_adaptive_fec_frame_bvb,
     ofdm_adaptive_frame_to_stream_vbb,
     ofdm_adaptive_constellation_soft_cf,
     ofdm_adaptive_chunks_to_symbols_bc,
     ofdm_adaptive_fec_decoder,
+    payload_length_key,
     make_ldpc_encoders,
     make_ldpc_decoders,
+    ldpc_decoder_type_t,
+    tx_time_key,
   )
 except ImportError:
     import sys
@@ -36,15 +45,23 @@ except ImportError:
     from gnuradio.dtl import (
         constellation_type_t,
         fec_feedback_key,
+        fec_key,
         feedback_constellation_key,
+        frame_clock,
+        frame_index_key,
         get_bits_per_symbol,
+        get_constellation_tag_key,
+        mcs_channel,
         ofdm_adaptive_fec_frame_bvb,
         ofdm_adaptive_frame_to_stream_vbb,
         ofdm_adaptive_constellation_soft_cf,
         ofdm_adaptive_chunks_to_symbols_bc,
         ofdm_adaptive_fec_decoder,
+        payload_length_key,
         make_ldpc_encoders,
         make_ldpc_decoders,
+        ldpc_decoder_type_t,
+        tx_time_key,
   )
 
 
@@ -58,6 +75,7 @@ class qa_ofdm_adaptive_fec(gr_unittest.TestCase):
         self.constellations = [constellation_type_t.BPSK, constellation_type_t.QPSK, constellation_type_t.PSK8, constellation_type_t.QAM16]
         self.max_bps = 4
         codes = [f"{self.test_codes_dir}/n_0100_k_0023_gap_10.alist",f"{self.test_codes_dir}/n_0100_k_0027_gap_04.alist"]
+        self.codes = codes
         self.ldpc_encs = make_ldpc_encoders(codes)
         self.ldpc_decs = make_ldpc_decoders(codes)
         self.max_empty_frames = 30
@@ -68,12 +86,31 @@ class qa_ofdm_adaptive_fec(gr_unittest.TestCase):
         self.tb = None
 
 
-    def run_flow(self, cnst, fec, frame_len, ofdm_sym_capacity):
+    def make_encoder(self, cnst, fec, frame_capacity, max_empty_frames, clock):
+        feedback = pmt.make_dict()
+        feedback = pmt.dict_add(feedback, fec_feedback_key(), pmt.from_long(fec))
+        feedback = pmt.dict_add(feedback, feedback_constellation_key(), pmt.from_long(int(cnst)))
+        enc = ofdm_adaptive_fec_frame_bvb(
+            self.ldpc_encs,
+            frame_capacity,
+            self.frame_rate,
+            self.max_bps,
+            max_empty_frames,
+            self.len_key
+        )
+        enc.process_feedback(feedback)
+        enc.set_frame_clock(clock)
+        return enc
+
+
+    def run_flow(self, cnst, fec, frame_len, ofdm_sym_capacity, nthreads=0, incremental=False,
+                 burst_frames=0, data=None, max_noutput_items=0):
 
         self.frame_len = frame_len
         self.ofdm_sym_capacity = ofdm_sym_capacity
 
-        data = [random.getrandbits(1) for _ in range(int(self.ldpc_encs[fec].get_k() * 69.69))]
+        if data is None:
+            data = [random.getrandbits(8) for _ in range(int(self.ldpc_encs[fec].get_k() * 69.69))]
         #data = [1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1]
 
         src = blocks.vector_source_b(
@@ -93,6 +130,7 @@ class qa_ofdm_adaptive_fec(gr_unittest.TestCase):
             self.len_key
         )
         enc.process_feedback(feedback)
+        enc.set_burst_frames(burst_frames)
 
         to_stream = ofdm_adaptive_frame_to_stream_vbb(self.frame_len * self.ofdm_sym_capacity, self.len_key)
         mod = ofdm_adaptive_chunks_to_symbols_bc(self.constellations, self.len_key)
@@ -105,7 +143,9 @@ class qa_ofdm_adaptive_fec(gr_unittest.TestCase):
             self.ldpc_decs,
             self.frame_len * self.ofdm_sym_capacity,
             self.max_bps,
-            self.len_key
+            self.len_key,
+            nthreads,
+            incremental=incremental
         )
 
         sink_b = blocks.vector_sink_b()
@@ -127,9 +167,15 @@ class qa_ofdm_adaptive_fec(gr_unittest.TestCase):
             to_stream,
             mod,
             cnst_dec,
-            dec,
-            sink_b_dec
+            dec
         )
+        if max_noutput_items:
+            # A downstream block reading a few bytes per call fills up the decoder output
+            slow = blocks.copy(gr.sizeof_char)
+            slow.set_max_noutput_items(max_noutput_items)
+            self.tb.connect(dec, slow, sink_b_dec)
+        else:
+            self.tb.connect(dec, sink_b_dec)
 
         self.tb.run()
         # check data
@@ -139,6 +185,7 @@ class qa_ofdm_adaptive_fec(gr_unittest.TestCase):
 
         assert len(data) == len(sink_b_dec.data())
         assert data == sink_b_dec.data()
+        return sink_b_dec.data()
 
     def test_001_encode_qam16(self):
         #return
@@ -170,5 +217,157 @@ class qa_ofdm_adaptive_fec(gr_unittest.TestCase):
         self.run_flow(cnst = constellation_type_t.BPSK, fec=1, frame_len=10, ofdm_sym_capacity=48)
         self.run_flow(cnst = constellation_type_t.BPSK, fec=2, frame_len=10, ofdm_sym_capacity=48)
 
+    def test_005_minsum_decoders(self):
+        for dec_type in [ldpc_decoder_type_t.MINSUM, ldpc_decoder_type_t.MINSUM_INT16, ldpc_decoder_type_t.MINSUM_INT8]:
+            self.ldpc_decs = make_ldpc_decoders(self.codes, dec_type)
+            self.run_flow(cnst = constellation_type_t.QPSK, fec=1, frame_len=3, ofdm_sym_capacity=48)
+            self.run_flow(cnst = constellation_type_t.QAM16, fec=2, frame_len=10, ofdm_sym_capacity=48)
+
+    def test_006_decoder_pool(self):
+        self.run_flow(cnst = constellation_type_t.QAM16, fec=1, frame_len=10, ofdm_sym_capacity=48, nthreads=3)
+        self.run_flow(cnst = constellation_type_t.QPSK, fec=2, frame_len=3, ofdm_sym_capacity=48, nthreads=2)
+
+    def test_007_incremental_decoding(self):
+        self.run_flow(cnst = constellation_type_t.QAM16, fec=1, frame_len=3, ofdm_sym_capacity=48, incremental=True)
+        self.run_flow(cnst = constellation_type_t.BPSK, fec=2, frame_len=10, ofdm_sym_capacity=48, incremental=True)
+
+    def test_008_frame_clock_tags(self):
+        # 2 frames per second, the TBs and the empty frames after them
+        capacity = 3 * 48
+        clock = frame_clock(2.0, True)
+        clock.set_time_tags(True, 0.5)
+        data = [random.getrandbits(8) for _ in range(self.ldpc_encs[1].get_k() * 5)]
+        src = blocks.vector_source_b(data)
+        enc = self.make_encoder(constellation_type_t.QPSK, 1, capacity, 3, clock)
+        dst = blocks.vector_sink_b(capacity)
+        self.tb.connect(src, enc, dst)
+        self.tb.run()
+
+        nframes = len(dst.data()) // capacity
+        self.assertGreater(nframes, 3)
+        self.assertEqual(nframes, clock.frame_index())
+        index_tags = [t for t in dst.tags() if pmt.equal(t.key, frame_index_key())]
+        time_tags = [t for t in dst.tags() if pmt.equal(t.key, tx_time_key())]
+        self.assertEqual(list(range(nframes)), [t.offset for t in index_tags])
+        self.assertEqual(list(range(nframes)), [pmt.to_uint64(t.value) for t in index_tags])
+        self.assertEqual(list(range(nframes)), [t.offset for t in time_tags])
+        for (n, t) in enumerate(time_tags):
+            tx_time = 0.5 + 0.5 * n
+            self.assertEqual(int(tx_time), pmt.to_uint64(pmt.tuple_ref(t.value, 0)))
+            self.assertAlmostEqual(tx_time % 1, pmt.to_double(pmt.tuple_ref(t.value, 1)))
+
+    def test_009_virtual_clock_frames(self):
+        # 1 frame per second in virtual time, all the frames without waiting for slots
+        capacity = 3 * 48
+        clock = frame_clock(1.0, True)
+        clock.set_time_tags(True)
+        data = [random.getrandbits(8) for _ in range(self.ldpc_encs[1].get_k() * 20)]
+        src = blocks.vector_source_b(data)
+        enc = self.make_encoder(constellation_type_t.QPSK, 1, capacity, 2, clock)
+        dst = blocks.vector_sink_b(capacity)
+        self.tb.connect(src, enc, dst)
+        start = time.monotonic()
+        self.tb.run()
+        elapsed = time.monotonic() - start
+
+        nframes = len(dst.data()) // capacity
+        self.assertGreater(nframes, 10)
+        self.assertLess(elapsed, nframes / 2)
+        self.assertEqual(nframes, clock.frame_index())
+        index_tags = [t for t in dst.tags() if pmt.equal(t.key, frame_index_key())]
+        self.assertEqual(list(range(nframes)), [t.offset for t in index_tags])
+        self.assertEqual(list(range(nframes)), [pmt.to_uint64(t.value) for t in index_tags])
+
+    def test_010_burst_frames(self):
+        # Encoding ahead of the frame slots does not change the decoded payload
+        for (cnst, fec, frame_len) in [(constellation_type_t.QPSK, 1, 3),
+                                       (constellation_type_t.QAM16, 2, 10)]:
+            data = [random.getrandbits(8) for _ in range(self.ldpc_encs[fec].get_k() * 30)]
+            ref = self.run_flow(cnst, fec, frame_len, 48, data=data)
+            for burst_frames in [1, 4, 16]:
+                self.tb = gr.top_block(catch_exceptions=True)
+                decoded = self.run_flow(cnst, fec, frame_len, 48, burst_frames=burst_frames,
+                                        data=data)
+                self.assertEqual(ref, decoded)
+
+    def test_011_max_empty_frames(self):
+        capacity = 3 * 48
+        for max_empty_frames in [1, 5]:
+            # Without input, stops after the empty frames
+            self.tb = gr.top_block(catch_exceptions=True)
+            src = blocks.vector_source_b([])
+            enc = self.make_encoder(constellation_type_t.QPSK, 1, capacity,
+                                    max_empty_frames, frame_clock(1.0, True))
+            dst = blocks.vector_sink_b(capacity)
+            self.tb.connect(src, enc, dst)
+            self.tb.run()
+            self.assertEqual(max_empty_frames, len(dst.data()) // capacity)
+
+            # After the data, the same number of frames without payload
+            self.tb = gr.top_block(catch_exceptions=True)
+            data = [random.getrandbits(8) for _ in range(self.ldpc_encs[1].get_k() * 5)]
+            src = blocks.vector_source_b(data)
+            enc = self.make_encoder(constellation_type_t.QPSK, 1, capacity,
+                                    max_empty_frames, frame_clock(1.0, True))
+            dst = blocks.vector_sink_b(capacity)
+            self.tb.connect(src, enc, dst)
+            self.tb.run()
+            payloads = [pmt.to_long(t.value) for t in sorted(dst.tags(), key=lambda t: t.offset)
+                        if pmt.equal(t.key, payload_length_key())]
+            self.assertEqual(len(dst.data()) // capacity, len(payloads))
+            self.assertEqual([0] * max_empty_frames, payloads[-max_empty_frames:])
+            self.assertNotEqual(0, payloads[-max_empty_frames - 1])
+
+    def run_mcs_channels(self, header, feedback):
+        # Frames of 5 TBs with the MCS published before the start
+        capacity = 3 * 48
+        header_channel = mcs_channel()
+        feedback_channel = mcs_channel()
+        header_channel.publish(header[0], header[1])
+        feedback_channel.publish(feedback[0], feedback[1])
+        data = [random.getrandbits(8) for _ in range(self.ldpc_encs[2].get_k() * 5)]
+        src = blocks.vector_source_b(data)
+        enc = self.make_encoder(constellation_type_t.QPSK, 1, capacity, 2,
+                                frame_clock(1.0, True))
+        enc.set_header_channel(header_channel)
+        enc.set_feedback_channel(feedback_channel)
+        dst = blocks.vector_sink_b(capacity)
+        self.tb.connect(src, enc, dst)
+        self.tb.run()
+
+        def values(key):
+            return [pmt.to_long(t.value) for t in sorted(dst.tags(), key=lambda t: t.offset)
+                    if pmt.equal(t.key, key)]
+        nframes = len(dst.data()) // capacity
+        self.assertGreater(nframes, 2)
+        # The empty frames at the end keep the MCS of the last TB
+        self.assertEqual(nframes, len(values(fec_key())))
+        return [set(values(key)) for key in [get_constellation_tag_key(), fec_key(),
+                                             feedback_constellation_key(), fec_feedback_key()]]
+
+    def test_012_mcs_channels(self):
+        # The header channel sets the MCS of the TBs, the feedback channel the MCS
+        # requested from the peer
+        tags = self.run_mcs_channels((constellation_type_t.QAM16, 2),
+                                     (constellation_type_t.PSK8, 2))
+        self.assertEqual([{int(constellation_type_t.QAM16)}, {2},
+                          {int(constellation_type_t.PSK8)}, {2}], tags)
+
+        # Invalid decisions are ignored, as in the message handlers
+        self.tb = gr.top_block(catch_exceptions=True)
+        tags = self.run_mcs_channels((constellation_type_t.UNKNOWN, -1),
+                                     (constellation_type_t.UNKNOWN, -1))
+        self.assertEqual([{int(constellation_type_t.BPSK)}, {1},
+                          {int(constellation_type_t.QPSK)}, {1}], tags)
+
+    def test_013_decoder_small_output(self):
+        # Decoded TBs wait in the worker pool for the output the downstream frees
+        self.run_flow(cnst = constellation_type_t.QAM16, fec=1, frame_len=10, ofdm_sym_capacity=48,
+                      nthreads=3, max_noutput_items=7)
+        self.run_flow(cnst = constellation_type_t.QPSK, fec=2, frame_len=3, ofdm_sym_capacity=48,
+                      nthreads=2, max_noutput_items=1)
+        self.run_flow(cnst = constellation_type_t.PSK8, fec=1, frame_len=3, ofdm_sym_capacity=48,
+                      max_noutput_items=5)
+
 if __name__ == '__main__':
     gr_unittest.run(qa_ofdm_adaptive_fec)
@@ -12,6 +12,7 @@ from gnuradio import (
     gr_unittest,
     digital,
 )
+import math
 import pmt
 import sys
 import time
@@ -20,6 +21,8 @@ try:
     from gnuradio.dtl import (
         ofdm_adaptive_config,
         ofdm_adaptive_feedback_decision,
+        ofdm_adaptive_link_adaptation,
+        ofdm_adaptive_frame_snr_eesm,
         constellation_type_t,
     )
 except ImportError:
@@ -30,6 +33,8 @@ except ImportError:
     from gnuradio.dtl import (
         ofdm_adaptive_config,
         ofdm_adaptive_feedback_decision,
+        ofdm_adaptive_link_adaptation,
+        ofdm_adaptive_frame_snr_eesm,
         constellation_type_t,
     )
 
@@ -58,6 +63,116 @@ class qa_ofdm_adaptive_feedback_decision(gr_unittest.TestCase):
             decision.append(feedback_decision.get_feedback(estimated_snr))
         self.assertEqual(list(zip(*decision))[0], tuple(expected_decision))
 
+    def test_link_adaptation_jumps(self):
+        link_adaptation = ofdm_adaptive_link_adaptation(self.mcs)
+
+        # No hysteresis: a fade and the recovery are followed in one decision
+        self.assertEqual(link_adaptation.get_feedback(30)[0], constellation_type_t.QAM16)
+        self.assertEqual(link_adaptation.get_feedback(0)[0], constellation_type_t.BPSK)
+        self.assertEqual(link_adaptation.get_feedback(30)[0], constellation_type_t.QAM16)
+
+    def test_link_adaptation_learns(self):
+        link_adaptation = ofdm_adaptive_link_adaptation(self.mcs, olla_step=0)
+        qam16 = self.mcs[3][1]
+        self.assertEqual(link_adaptation.get_feedback(26)[0], constellation_type_t.QAM16)
+
+        # QAM16 fails at 26 dB: the curve rises there and below, not above
+        bler_above = link_adaptation.get_bler(3, 35)
+        for _ in range(100):
+            link_adaptation.report_tb(qam16, 26, False)
+        self.assertGreater(link_adaptation.get_bler(3, 26), 0.9)
+        self.assertGreater(link_adaptation.get_bler(3, 20), 0.9)
+        self.assertEqual(link_adaptation.get_bler(3, 35), bler_above)
+        self.assertEqual(link_adaptation.get_feedback(26)[0], constellation_type_t.PSK8)
+        self.assertEqual(link_adaptation.get_feedback(35)[0], constellation_type_t.QAM16)
+
+    def test_link_adaptation_explores(self):
+        link_adaptation = ofdm_adaptive_link_adaptation(self.mcs, olla_step=0)
+        qam16 = self.mcs[3][1]
+        for _ in range(100):
+            link_adaptation.report_tb(qam16, 26, False)
+
+        # QAM16 is still probed at 26 dB, once every 50 decisions
+        decisions = [link_adaptation.get_feedback(26)[0] for _ in range(100)]
+        self.assertEqual(decisions.count(constellation_type_t.QAM16), 2)
+        self.assertEqual(decisions.count(constellation_type_t.PSK8), 98)
+
+        # and comes back once the probes get through
+        for _ in range(100):
+            link_adaptation.report_tb(qam16, 26, True)
+        self.assertLess(link_adaptation.get_bler(3, 26), 0.1)
+        self.assertLess(link_adaptation.get_bler(3, 30), 0.1)
+        self.assertGreater(link_adaptation.get_bler(3, 20), 0.9)
+        self.assertEqual(link_adaptation.get_feedback(26)[0], constellation_type_t.QAM16)
+
+    def test_link_adaptation_olla(self):
+        link_adaptation = ofdm_adaptive_link_adaptation(self.mcs, target_bler=0.1, olla_step=0.5)
+        mcs = self.mcs[1][1]
+        link_adaptation.report_tb(mcs, float("nan"), False)
+        self.assertAlmostEqual(link_adaptation.get_olla_offset(), -0.5)
+        for _ in range(9):
+            link_adaptation.report_tb(mcs, float("nan"), True)
+        self.assertAlmostEqual(link_adaptation.get_olla_offset(), 0)
+
+    def test_effective_snr_decision(self):
+        # Half of the carriers at 20 dB, the others at 27.3 dB: 25 dB mean SNR, but
+        # the effective SNRs stay close to the weak carriers, about 20.2 dB, enough
+        # for PSK8 (18 dB) and too low for QAM16 (23 dB)
+        eesm = ofdm_adaptive_frame_snr_eesm()
+        n = 256
+        gain = (n // 2) * [532.0, 100.0]
+        # |eq - est|^2 = 1 / |h|^2: unit noise before equalization, SNR = |h|^2
+        eq_re = [1 + 1 / math.sqrt(g) for g in gain]
+        eesm.update_carriers(gain, eq_re, n * [0.0], n * [1.0], n * [0.0])
+        self.assertAlmostEqual(eesm.snr(), 25, delta=0.05)
+        for cnst in (constellation_type_t.PSK8, constellation_type_t.QAM16):
+            self.assertGreater(eesm.effective_snr(cnst), 19.5)
+            self.assertLess(eesm.effective_snr(cnst), 21)
+        effective_snr = {
+            cnst: eesm.effective_snr(cnst) for cnst in (
+                constellation_type_t.BPSK,
+                constellation_type_t.QPSK,
+                constellation_type_t.PSK8,
+                constellation_type_t.QAM16,
+            )
+        }
+
+        link_adaptation = ofdm_adaptive_link_adaptation(self.mcs)
+        self.assertEqual(link_adaptation.get_feedback(25)[0], constellation_type_t.QAM16)
+        self.assertEqual(link_adaptation.get_feedback(lambda c: effective_snr[c])[0],
+                         constellation_type_t.PSK8)
+
+        mean_decision = ofdm_adaptive_feedback_decision(1, 1, self.mcs, 2)
+        effective_decision = ofdm_adaptive_feedback_decision(1, 1, self.mcs, 2)
+        for _ in range(2):
+            mean_feedback = mean_decision.get_feedback(25)
+            effective_feedback = effective_decision.get_feedback(lambda c: effective_snr[c])
+        self.assertEqual(mean_feedback[0], constellation_type_t.QAM16)
+        self.assertEqual(effective_feedback[0], constellation_type_t.PSK8)
+
+    def test_eesm_flat_channel(self):
+        eesm = ofdm_adaptive_frame_snr_eesm()
+        n = 256
+        # 20 dB on every carrier: the effective SNR is the SNR for all the betas
+        eesm.update_carriers(n * [100.0], n * [1.1], n * [0.0], n * [1.0], n * [0.0])
+        self.assertAlmostEqual(eesm.snr(), 20, delta=0.01)
+        for cnst in (constellation_type_t.BPSK, constellation_type_t.QAM16):
+            self.assertAlmostEqual(eesm.effective_snr(cnst), 20, delta=0.2)
+
+    def test_eesm_selective_channel(self):
+        eesm = ofdm_adaptive_frame_snr_eesm()
+        n = 256
+        # Half of the carriers 20 dB below the others
+        gain = (n // 2) * [100.0, 1.0]
+        eesm.update_carriers(gain, n * [1.1], n * [0.0], n * [1.0], n * [0.0])
+        qpsk = eesm.effective_snr(constellation_type_t.QPSK)
+        qam16 = eesm.effective_snr(constellation_type_t.QAM16)
+        self.assertLess(qam16, eesm.snr())
+        self.assertLess(qpsk, qam16)
+
+        eesm.reset()
+        self.assertEqual(eesm.snr(), 0)
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_ofdm_adaptive_feedback_decision)
@@ -0,0 +1,157 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2023 DTL.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+import time
+
+try:
+  from gnuradio.dtl import (
+    ofdm_adaptive_frame_bb,
+    constellation_type_t,
+    frame_clock,
+    feedback_constellation_key,
+    frame_index_key,
+    get_constellation_tag_key,
+    mcs_channel,
+    payload_length_key,
+    tx_time_key,
+)
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio.dtl import (
+        ofdm_adaptive_frame_bb,
+        constellation_type_t,
+        frame_clock,
+        feedback_constellation_key,
+        frame_index_key,
+        get_constellation_tag_key,
+        mcs_channel,
+        payload_length_key,
+        tx_time_key,
+    )
+
+class qa_ofdm_adaptive_frame_bb(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+        self.frame_len = 2
+        self.carriers = 48
+        self.capacity = self.frame_len * self.carriers
+
+    def tearDown(self):
+        self.tb = None
+
+    def make_frame(self, frame_rate, max_empty_frames, clock,
+                   constellations=[constellation_type_t.QPSK]):
+        frame = ofdm_adaptive_frame_bb("len_tag", constellations, self.frame_len,
+                                       frame_rate, self.carriers, "", max_empty_frames)
+        frame.set_constellation(constellation_type_t.QPSK)
+        frame.set_frame_clock(clock)
+        return frame
+
+    def test_001_multi_frame(self):
+        # 3 PDUs filling a QPSK frame each, then the empty frames
+        pdu_len = self.capacity * 2 // 8 - 4
+        payload = [(7 * i + 1) % 256 for i in range(3 * pdu_len)]
+        tags = []
+        for n in range(3):
+            tag = gr.tag_t()
+            tag.offset = n * pdu_len
+            tag.key = pmt.string_to_symbol("len_tag")
+            tag.value = pmt.from_long(pdu_len)
+            tags.append(tag)
+
+        # 4 frames per second would take 1.25 s in real time
+        clock = frame_clock(4.0, True)
+        clock.set_time_tags(True, 1.25)
+        src = blocks.vector_source_b(payload, False, 1, tags)
+        frame = self.make_frame(4.0, 2, clock)
+        dst = blocks.vector_sink_b(self.capacity)
+        self.tb.connect(src, frame, dst)
+        self.tb.run()
+
+        self.assertEqual(5 * self.capacity, len(dst.data()))
+        self.assertEqual(5, clock.frame_index())
+        payload_tags = [t for t in dst.tags() if pmt.equal(t.key, payload_length_key())]
+        # With the CRC
+        self.assertEqual([pdu_len + 4] * 3 + [0] * 2,
+                         [pmt.to_long(t.value) for t in payload_tags])
+        for n in range(3):
+            # QPSK symbols back to the LSB first packed bytes
+            syms = dst.data()[n * self.capacity:(n + 1) * self.capacity]
+            data = [sum(syms[4 * b + k] << (2 * k) for k in range(4)) for b in range(pdu_len)]
+            self.assertEqual(payload[n * pdu_len:(n + 1) * pdu_len], data)
+
+        index_tags = [t for t in dst.tags() if pmt.equal(t.key, frame_index_key())]
+        time_tags = [t for t in dst.tags() if pmt.equal(t.key, tx_time_key())]
+        self.assertEqual(list(range(5)), [t.offset for t in index_tags])
+        self.assertEqual(list(range(5)), [pmt.to_uint64(t.value) for t in index_tags])
+        self.assertEqual(list(range(5)), [t.offset for t in time_tags])
+        for (n, t) in enumerate(time_tags):
+            tx_time = 1.25 + 0.25 * n
+            self.assertEqual(int(tx_time), pmt.to_uint64(pmt.tuple_ref(t.value, 0)))
+            self.assertAlmostEqual(tx_time % 1, pmt.to_double(pmt.tuple_ref(t.value, 1)))
+
+    def test_002_real_time_clock(self):
+        # Frame n is due n / 50 s after the start
+        clock = frame_clock(50.0, False)
+        src = blocks.vector_source_b([], False)
+        frame = self.make_frame(50.0, 6, clock)
+        dst = blocks.vector_sink_b(self.capacity)
+        self.tb.connect(src, frame, dst)
+        start = time.monotonic()
+        self.tb.run()
+        elapsed = time.monotonic() - start
+
+        self.assertEqual(6 * self.capacity, len(dst.data()))
+        self.assertGreaterEqual(elapsed, 5 / 50.0)
+
+    def run_mcs_channels(self, header_cnst, feedback_cnst):
+        # Empty frames with the MCS published before the start
+        constellations = [constellation_type_t.BPSK, constellation_type_t.QPSK,
+                          constellation_type_t.QAM16]
+        header_channel = mcs_channel()
+        feedback_channel = mcs_channel()
+        header_channel.publish(header_cnst, -1)
+        feedback_channel.publish(feedback_cnst, -1)
+        src = blocks.vector_source_b([], False)
+        frame = self.make_frame(4.0, 3, frame_clock(4.0, True), constellations)
+        frame.set_header_channel(header_channel)
+        frame.set_feedback_channel(feedback_channel)
+        dst = blocks.vector_sink_b(self.capacity)
+        self.tb.connect(src, frame, dst)
+        self.tb.run()
+
+        self.assertEqual(3 * self.capacity, len(dst.data()))
+        cnst = [pmt.to_long(t.value) for t in dst.tags()
+                if pmt.equal(t.key, get_constellation_tag_key())]
+        feedback = [pmt.to_long(t.value) for t in dst.tags()
+                    if pmt.equal(t.key, feedback_constellation_key())]
+        return (cnst, feedback)
+
+    def test_003_mcs_channels(self):
+        # The header channel sets the frame constellation, the feedback channel the
+        # constellation requested from the peer
+        (cnst, feedback) = self.run_mcs_channels(constellation_type_t.QAM16,
+                                                 constellation_type_t.BPSK)
+        self.assertEqual([int(constellation_type_t.QAM16)] * 3, cnst)
+        self.assertEqual([int(constellation_type_t.BPSK)] * 3, feedback)
+
+        # Invalid constellations are ignored, as in the message handlers
+        self.tb = gr.top_block()
+        (cnst, feedback) = self.run_mcs_channels(constellation_type_t.UNKNOWN,
+                                                 constellation_type_t.UNKNOWN)
+        self.assertEqual([int(constellation_type_t.QPSK)] * 3, cnst)
+        self.assertEqual([int(constellation_type_t.UNKNOWN)] * 3, feedback)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ofdm_adaptive_frame_bb)
@@ -0,0 +1,137 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2023 DTL.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+
+try:
+  from gnuradio.dtl import (
+    ofdm_adaptive_frame_bc,
+    constellation_type_t,
+    create_constellation,
+    frame_clock,
+    frame_index_key,
+    get_constellation_tag_key,
+    payload_length_key,
+    tx_time_key,
+)
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio.dtl import (
+        ofdm_adaptive_frame_bc,
+        constellation_type_t,
+        create_constellation,
+        frame_clock,
+        frame_index_key,
+        get_constellation_tag_key,
+        payload_length_key,
+        tx_time_key,
+    )
+
+class qa_ofdm_adaptive_frame_bc(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def demap(self, cnst, bps, symbols):
+        # Symbol values back to the LSB first packed bytes
+        constellation = create_constellation(cnst)
+        bits = []
+        for s in symbols:
+            value = constellation.decision_maker_v([s])
+            bits += [(value >> b) & 1 for b in range(bps)]
+        return [sum(bits[8 * i + b] << b for b in range(8)) for i in range(len(bits) // 8)]
+
+    def test_bc_001_payload_frame(self):
+        frame_len = 2
+        carriers = 48
+        capacity = frame_len * carriers
+        payload = [(5 * i + 3) % 256 for i in range(10)]
+        for (cnst, bps) in ((constellation_type_t.BPSK, 1), (constellation_type_t.QPSK, 2),
+                            (constellation_type_t.PSK8, 3), (constellation_type_t.QAM16, 4)):
+            len_tag = gr.tag_t()
+            len_tag.offset = 0
+            len_tag.key = pmt.string_to_symbol("len_tag")
+            len_tag.value = pmt.from_long(len(payload))
+
+            tb = gr.top_block()
+            src = blocks.vector_source_b(payload, False, 1, [len_tag])
+            frame = ofdm_adaptive_frame_bc("len_tag", [cnst], frame_len, 1e4, carriers)
+            frame.set_constellation(cnst)
+            head = blocks.head(gr.sizeof_gr_complex, 8 * capacity)
+            dst = blocks.vector_sink_c()
+            tb.connect(src, frame, head, dst)
+            tb.run()
+
+            frame_syms = (capacity * bps // 8 * 8 + bps - 1) // bps
+            tags = [t for t in dst.tags() if pmt.equal(t.key, payload_length_key())]
+            data_tags = [t for t in tags if pmt.to_long(t.value) != 0]
+            self.assertEqual(1, len(data_tags))
+            self.assertEqual(len(payload) + 4, pmt.to_long(data_tags[0].value))
+            offset = data_tags[0].offset
+
+            frame_tags = [t for t in dst.tags() if t.offset == offset]
+            len_tags = [t for t in frame_tags if pmt.equal(t.key, pmt.intern("len_tag"))]
+            self.assertEqual(frame_syms, pmt.to_long(len_tags[0].value))
+            cnst_tags = [t for t in frame_tags if pmt.equal(t.key, get_constellation_tag_key())]
+            self.assertEqual(int(cnst), pmt.to_long(cnst_tags[0].value))
+
+            symbols = dst.data()[offset:offset + frame_syms]
+            self.assertEqual(payload, self.demap(cnst, bps, symbols)[:len(payload)])
+
+    def test_bc_002_padding_table(self):
+        # Empty frames padded from the table are the same on every run
+        outputs = []
+        for run in range(2):
+            tb = gr.top_block()
+            src = blocks.vector_source_b([], False)
+            frame = ofdm_adaptive_frame_bc("len_tag", [constellation_type_t.QAM16], 2, 1e4, 48,
+                                           "", 3)
+            frame.set_constellation(constellation_type_t.QAM16)
+            frame.set_padding_table(True)
+            dst = blocks.vector_sink_c()
+            tb.connect(src, frame, dst)
+            tb.run()
+            outputs.append(dst.data())
+        self.assertEqual(3 * 2 * 48, len(outputs[0]))
+        self.assertEqual(outputs[0], outputs[1])
+        # Consecutive frames take different parts of the table
+        self.assertNotEqual(outputs[0][:96], outputs[0][96:192])
+
+    def test_bc_003_virtual_clock(self):
+        # One frame per second would take 10 s in real time
+        clock = frame_clock(1.0, True)
+        clock.set_time_tags(True, 2.5)
+        tb = gr.top_block()
+        src = blocks.vector_source_b([], False)
+        frame = ofdm_adaptive_frame_bc("len_tag", [constellation_type_t.QPSK], 2, 1.0, 48,
+                                       "", 10)
+        frame.set_constellation(constellation_type_t.QPSK)
+        frame.set_frame_clock(clock)
+        dst = blocks.vector_sink_c()
+        tb.connect(src, frame, dst)
+        tb.run()
+
+        self.assertEqual(10 * 96, len(dst.data()))
+        self.assertEqual(10, clock.frame_index())
+        index_tags = [t for t in dst.tags() if pmt.equal(t.key, frame_index_key())]
+        time_tags = [t for t in dst.tags() if pmt.equal(t.key, tx_time_key())]
+        self.assertEqual([96 * n for n in range(10)], [t.offset for t in index_tags])
+        self.assertEqual(list(range(10)), [pmt.to_uint64(t.value) for t in index_tags])
+        for (n, t) in enumerate(time_tags):
+            self.assertEqual(2 + n, pmt.to_uint64(pmt.tuple_ref(t.value, 0)))
+            self.assertAlmostEqual(0.5, pmt.to_double(pmt.tuple_ref(t.value, 1)))
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ofdm_adaptive_frame_bc)
@@ -19,6 +19,7 @@ import pmt
 # from gnuradio import blocks
 try:
     from gnuradio.dtl import (
+        carrier_snr_tag_key,
         constellation_type_t,
         get_constellation_tag_key,
         estimated_snr_tag_key,
@@ -38,6 +39,7 @@ except ImportError:
     dirname, filename = os.path.split(os.path.abspath(__file__))
     sys.path.append(os.path.join(dirname, "bindings"))
     from gnuradio.dtl import (
+        carrier_snr_tag_key,
         constellation_type_t,
         get_constellation_tag_key,
         estimated_snr_tag_key,
@@ -164,6 +166,80 @@ class qa_ofdm_adaptive_frame_equalizer_vcvc(gr_unittest.TestCase):
             feedback_dict = pmt.to_python(feedback_msg)
             self.assertEqual(feedback_dict, {pmt.to_python(feedback_constellation_key()): 1, pmt.to_python(fec_feedback_key()): 0})
 
+    def test_carrier_snr(self):
+        # Frequency selective channel, constant over the frame
+        cnst = digital.constellation_qpsk()
+        fft_len = 8
+        #            4   5  6  7   0  1  2   3
+        tx_data = [-1, -1, 1, 2, -1, 3, 0, -1,
+                   -1, -1, 0, 2, -1, 2, 0, -1,
+                   -1, -1, 3, 0, -1, 1, 0, -1,  # Pilot symbols
+                   -1, -1, 1, 1, -1, 0, 2, -1]
+        tx_signal = [cnst.map_to_points_v(x)[0] if x != -1 else 0 for x in tx_data]
+        occupied_carriers = ((1, 2, 6, 7),)
+        pilot_carriers = ((), (), (1, 2, 6, 7), ())
+        pilot_symbols = (
+            [], [], [cnst.map_to_points_v(x)[0] for x in (1, 0, 3, 0)], []
+        )
+        equalizer = ofdm_adaptive_payload_equalizer(
+            fft_len,
+            [constellation_type_t.QPSK],
+            ofdm_adaptive_frame_snr_simple(float(0.1)),
+            occupied_carriers,
+            pilot_carriers,
+            pilot_symbols,
+            0,
+            0.01)
+        gains = [0, 0, 2, 1, 0, 0.5, 1.5, 0]
+        channel = gains * (len(tx_data) // fft_len)
+        chan_tag = gr.tag_t()
+        chan_tag.offset = 0
+        chan_tag.key = pmt.string_to_symbol("ofdm_sync_chan_taps")
+        chan_tag.value = pmt.init_c32vector(fft_len, channel[:fft_len])
+        const_tag = gr.tag_t()
+        const_tag.offset = 0
+        const_tag.key = get_constellation_tag_key()
+        const_tag.value = pmt.from_long(constellation_type_t.QPSK)
+        payload_tag = gr.tag_t()
+        payload_tag.offset = 0
+        payload_tag.key = payload_length_key()
+        payload_tag.value = pmt.from_long(1) # >0
+        rx_signal = numpy.multiply(tx_signal, channel) + [x if y != 0 else 0 for (
+            x, y) in zip(numpy.random.normal(0, 0.003, len(tx_signal)), tx_signal)]
+
+        src = blocks.vector_source_c(
+            rx_signal, False, fft_len, (chan_tag, const_tag, payload_tag))
+        eq = ofdm_adaptive_frame_equalizer_vcvc(
+            equalizer.base(), ofdm_adaptive_feedback_decision(
+                1, 3, [(snr_th, (cnst, 0)) for (snr_th, (cnst, _)) in ofdm_adaptive_config.ofdm_adaptive_config.mcs]), 0, "tsb_key", "frame_no_key", True, True)
+        sink = blocks.tsb_vector_sink_c(fft_len, tsb_key="tsb_key")
+        soft_sink = blocks.tsb_vector_sink_c(fft_len, tsb_key="tsb_key")
+        stream_to_tagged = blocks.stream_to_tagged_stream(
+            gr.sizeof_gr_complex, fft_len, len(tx_data) // fft_len, "tsb_key")
+        self.tb.connect(src, stream_to_tagged, eq, sink)
+        self.tb.connect((eq, 1), soft_sink)
+        self.tb.run()
+
+        # Only on the soft output, for the demapper
+        self.assertNotIn(carrier_snr_tag_key(), [t.key for t in sink.tags()])
+        tags = {pmt.symbol_to_string(t.key): t.value for t in soft_sink.tags()}
+        noise = pmt.to_double(tags[pmt.symbol_to_string(noise_tag_key())])
+        snr = pmt.f32vector_elements(tags[pmt.symbol_to_string(carrier_snr_tag_key())])
+        self.assertEqual(len(snr), fft_len)
+        self.assertGreater(noise, 0)
+
+        # Unused carriers carry no information
+        for k in range(fft_len):
+            if gains[k] == 0:
+                self.assertEqual(snr[k], 0)
+        # Scaled by the channel gains, relative to the best carrier
+        for k in (3, 5, 6):
+            self.assertAlmostEqual(snr[k] / snr[2], gains[k]**2 / gains[2]**2,
+                                   delta=0.05 * gains[k]**2 / gains[2]**2)
+        # The noise of the frame is the average over the pilot carriers
+        self.assertAlmostEqual(numpy.mean([1 / snr[k] for k in (2, 3, 5, 6)]) / noise,
+                               1, delta=1e-3)
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_ofdm_adaptive_frame_equalizer_vcvc)
@@ -0,0 +1,71 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2023 DTL.
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, gr_unittest
+import numpy as np
+
+try:
+    from gnuradio.dtl import (
+        ofdm_adaptive_frame_snr_simple,
+        ofdm_adaptive_frame_snr_m2m4,
+        ofdm_adaptive_frame_snr_svr,
+    )
+except ImportError:
+    import os
+    import sys
+    dirname, filename = os.path.split(os.path.abspath(__file__))
+    sys.path.append(os.path.join(dirname, "bindings"))
+    from gnuradio.dtl import (
+        ofdm_adaptive_frame_snr_simple,
+        ofdm_adaptive_frame_snr_m2m4,
+        ofdm_adaptive_frame_snr_svr,
+    )
+
+
+class qa_ofdm_adaptive_frame_snr(gr_unittest.TestCase):
+
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.snr_db = 15
+        sigma = np.sqrt(10**(-self.snr_db / 10) / 2)
+        qpsk = np.exp(1j * np.pi / 4 * (2 * rng.integers(0, 4, 4000) + 1))
+        noise = sigma * (rng.standard_normal(4000) + 1j * rng.standard_normal(4000))
+        self.samples = (qpsk + noise).astype(np.complex64)
+
+    def test_simple_matches_exponential_average(self):
+        alpha = 0.1
+        y1 = y2 = 0
+        for x in self.samples[:100]:
+            y1 = alpha * abs(x) + (1 - alpha) * y1
+            y2 = alpha * abs(x)**2 + (1 - alpha) * y2
+        expected = 10 * np.log10(y1**2 / (y2 - y1**2))
+
+        # Batches of any length give the per sample average
+        snr_est = ofdm_adaptive_frame_snr_simple(alpha)
+        for (begin, end) in ((0, 3), (3, 40), (40, 41), (41, 100)):
+            snr_est.update(end - begin, self.samples[begin:end])
+        self.assertAlmostEqual(snr_est.snr(), expected, places=3)
+
+    def test_reset_in_place(self):
+        snr_est = ofdm_adaptive_frame_snr_simple(0.1)
+        snr_est.update(50, self.samples[:50])
+        snr_est.reset()
+        snr_est.update(50, self.samples[50:100])
+        fresh_est = ofdm_adaptive_frame_snr_simple(0.1)
+        fresh_est.update(50, self.samples[50:100])
+        self.assertEqual(snr_est.snr(), fresh_est.snr())
+
+    def test_moment_estimators(self):
+        for snr_est in (ofdm_adaptive_frame_snr_m2m4(0.001), ofdm_adaptive_frame_snr_svr(0.001)):
+            for i in range(0, len(self.samples), 40):
+                snr_est.update(40, self.samples[i:i + 40])
+            self.assertAlmostEqual(snr_est.snr(), self.snr_db, delta=1)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ofdm_adaptive_frame_snr)
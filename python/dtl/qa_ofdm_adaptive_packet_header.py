@@ -32,6 +32,8 @@ try:
         fec_tb_payload_key,
         feedback_constellation_key,
         fec_feedback_key,
+        constellation_type_t,
+        mcs_channel,
     )
 except ImportError:
     import os
@@ -48,6 +50,8 @@ except ImportError:
         fec_tb_payload_key,
         feedback_constellation_key,
         fec_feedback_key,
+        constellation_type_t,
+        mcs_channel,
     )
 
 
@@ -259,6 +263,59 @@ class qa_ofdm_adaptive_packet_header(gr_unittest.TestCase):
             )
 
 
+    def run_header_channel(self, has_fec, feedback):
+        # Headers of QAM16 frames carrying the given (constellation, fec) feedback
+        packets = [(1, 2, 3, 4)] * len(feedback)
+        data, tags = packet_utils.packets_to_vectors(packets, "len_key")
+        values = [(get_constellation_tag_key(), 4), (payload_length_key(), 4)]
+        if has_fec:
+            values += [(fec_tb_key(), 1), (fec_offset_key(), 0), (fec_key(), 1),
+                       (fec_tb_payload_key(), 4)]
+        for (n, fb) in enumerate(feedback):
+            fb_values = [(feedback_constellation_key(), fb[0])]
+            if has_fec:
+                fb_values.append((fec_feedback_key(), fb[1]))
+            for (key, value) in values + fb_values:
+                tag = tag_t()
+                tag.offset = 4 * n
+                tag.key = key
+                tag.value = pmt.from_long(value)
+                tags.append(tag)
+
+        carriers = [self._occupied_carriers_real] * (2 if has_fec else 1)
+        formatter = ofdm_adaptive_packet_header(
+            carriers, len(carriers), 1, "len_key", "frame_len_key", "head_num", 1, False, has_fec)
+        header_channel = mcs_channel()
+        formatter.set_header_channel(header_channel)
+        src = blocks.vector_source_b(data, tags=tags)
+        header_gen = digital.packet_headergenerator_bb(formatter.formatter(), "len_key")
+        stop_tags_gate = blocks.tag_gate(1, False)
+        header_parser = digital.packet_headerparser_b(formatter.formatter())
+        sink_parse = blocks.message_debug()
+        self.tb.connect(src, header_gen, stop_tags_gate, header_parser)
+        self.tb.msg_connect(header_parser, "header_data", sink_parse, "store")
+        self.tb.run()
+        self.assertEqual(len(feedback), sink_parse.num_messages())
+        return header_channel
+
+    def test_header_channel(self):
+        # Every parsed header is published, the readers keep the last one
+        header_channel = self.run_header_channel(False, [(2,), (3,), (1,)])
+        mcs, seq = header_channel.read(0)
+        self.assertEqual(3, seq)
+        self.assertEqual(3, header_channel.version())
+        self.assertEqual(constellation_type_t.BPSK, mcs.constellation)
+        self.assertEqual(-1, mcs.fec_idx)
+        self.assertIsNone(header_channel.read(seq)[0])
+
+        self.tb = top_block()
+        header_channel = self.run_header_channel(True, [(2, 1), (3, 2), (4, 0)])
+        mcs, seq = header_channel.read(0)
+        self.assertEqual(3, seq)
+        self.assertEqual(constellation_type_t.QAM16, mcs.constellation)
+        self.assertEqual(0, mcs.fec_idx)
+        self.assertIsNone(header_channel.read(seq)[0])
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_ofdm_adaptive_packet_header)
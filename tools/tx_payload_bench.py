@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+#
+# Throughput of the TX payload path without FEC: frame_bb, frame_to_stream and
+# chunks_to_symbols against the fused ofdm_adaptive_frame_bc.
+#
+# tools/tx_payload_bench.py [constellation] [n_frames]
+
+import sys
+import time
+
+import numpy as np
+from gnuradio import gr, blocks
+from gnuradio import dtl
+
+LEN_KEY = "packet_len"
+FRAME_LEN = 20
+CARRIERS = 200
+PDU_LEN = 1500
+
+
+def run(fused, cnst, n_frames):
+    capacity = FRAME_LEN * CARRIERS
+    frame_rate = 1e9  # No pacing
+    data = np.random.randint(0, 256, PDU_LEN * 64, dtype=np.uint8).tolist()
+
+    tb = gr.top_block()
+    src = blocks.vector_source_b(data, True)
+    to_pdu = blocks.stream_to_tagged_stream(gr.sizeof_char, 1, PDU_LEN, LEN_KEY)
+    head = blocks.head(gr.sizeof_gr_complex, n_frames * capacity)
+    sink = blocks.null_sink(gr.sizeof_gr_complex)
+    if fused:
+        frame = dtl.ofdm_adaptive_frame_bc(LEN_KEY, [cnst], FRAME_LEN, frame_rate, CARRIERS)
+        frame.set_constellation(cnst)
+        tb.connect(src, to_pdu, frame, head, sink)
+    else:
+        frame = dtl.ofdm_adaptive_frame_bb(LEN_KEY, [cnst], FRAME_LEN, frame_rate, CARRIERS)
+        frame.set_constellation(cnst)
+        to_stream = dtl.ofdm_adaptive_frame_to_stream_vbb(capacity, LEN_KEY)
+        mod = dtl.ofdm_adaptive_chunks_to_symbols_bc([cnst], LEN_KEY)
+        tb.connect(src, to_pdu, frame, to_stream, mod, head, sink)
+
+    start = time.perf_counter()
+    tb.run()
+    return time.perf_counter() - start
+
+
+def main():
+    cnst = getattr(dtl.constellation_type_t, sys.argv[1] if len(sys.argv) > 1 else "QAM16")
+    n_frames = int(sys.argv[2]) if len(sys.argv) > 2 else 20000
+    nsyms = n_frames * FRAME_LEN * CARRIERS
+    for (name, fused) in (("frame_bb chain", False), ("frame_bc", True)):
+        t = run(fused, cnst, n_frames)
+        print(f"{name:16s} {t:8.3f} s {nsyms / t / 1e6:8.2f} Msym/s")
+
+
+if __name__ == "__main__":
+    main()